@@ -1,19 +1,39 @@
 ﻿#include "Animator.h"
 #include "Time.h"
+#include "Logger.h"
 #include <fstream>  // ファイル操作用
-#include <iostream> // エラー表示用
+#include <map>
 
-Animator::Animator()
-    : currentClip(nullptr), timer(0), currentFrameIndex(0)
-{
+#include <nlohmann/json.hpp>
+using json = nlohmann::json;
+
+std::shared_ptr<const AnimationClipSet> AnimationClipSet::Load(const std::string& filePath) {
+    // 使われている間だけ保持する（弱参照なので、どの Animator も使わなくなれば解放される）
+    static std::map<std::string, std::weak_ptr<const AnimationClipSet>> cache;
+
+    auto it = cache.find(filePath);
+    if (it != cache.end()) {
+        if (auto shared = it->second.lock()) return shared;
+    }
+
+    auto clipSet = std::make_shared<AnimationClipSet>();
+    clipSet->LoadFromJson(filePath);
+    std::shared_ptr<const AnimationClipSet> result = clipSet;
+    cache[filePath] = result;
+    return result;
 }
 
+std::shared_ptr<const AnimationClipSet> AnimationClipSet::Create(std::vector<AnimationClip> clips) {
+    auto clipSet = std::make_shared<AnimationClipSet>();
+    clipSet->clips = std::move(clips);
+    return clipSet;
+}
 
-bool Animator::LoadFromJson(std::string filePath) {
+bool AnimationClipSet::LoadFromJson(const std::string& filePath) {
     // ファイルを開く
     std::ifstream file(filePath);
     if (!file.is_open()) {
-        std::cout << "[Error] Failed to open animation file: " << filePath << std::endl;
+        LOG_ERROR(LogCategory::Asset, "Failed to open animation file: " << filePath);
         return false;
     }
 
@@ -25,92 +45,97 @@ bool Animator::LoadFromJson(std::string filePath) {
         // "animations" 配列の中身を順番に取り出す
         if (data.contains("animations")) {
             for (auto& anim : data["animations"]) {
+                AnimationClip clip;
                 // 必須項目の取得
-                std::string name = anim["name"];
-                int row = anim["row"];
-                int count = anim["frameCount"];
-                float speed = anim["speed"];
+                clip.name = StringId(anim["name"].get<std::string>());
+                clip.row = anim["row"];
+                clip.frameCount = anim["frameCount"];
+                clip.speed = anim["speed"];
 
                 // オプション項目（省略時はtrue）
-                bool loop = true;
+                clip.loop = true;
                 if (anim.contains("loop")) {
-                    loop = anim["loop"];
+                    clip.loop = anim["loop"];
                 }
 
-                // 登録関数を呼び出してメモリに保存
-                AddAnimation(name, row, count, speed, loop);
+                // 同じ名前は後の定義で上書きする（番号は最初の定義の位置のまま）
+                AnimationHandle existing = Find(clip.name);
+                if (existing != InvalidAnimation) clips[existing] = clip;
+                else clips.push_back(clip);
             }
         }
-        std::cout << "[System] Loaded animations from " << filePath << std::endl;
+        LOG_INFO(LogCategory::Asset, "Loaded animations from " << filePath);
         return true;
     }
-    catch (json::parse_error& e) {
-        std::cout << "[Error] JSON Parse Error in " << filePath << ": " << e.what() << std::endl;
+    catch (json::exception& e) {
+        LOG_ERROR(LogCategory::Asset, "JSON Parse Error in " << filePath << ": " << e.what());
         return false;
     }
 }
 
-// 今までの手動登録関数（LoadFromJsonから呼ばれる）
-void Animator::AddAnimation(std::string name, int row, int frameCount, float speed, bool loop) {
-    AnimationClip clip;
-    clip.name = name;
-    clip.row = row;
-    clip.frameCount = frameCount;
-    clip.speed = speed;
-    clip.loop = loop;
+AnimationHandle AnimationClipSet::Find(StringId name) const {
+    for (size_t i = 0; i < clips.size(); ++i) {
+        if (clips[i].name == name) return (AnimationHandle)i;
+    }
+    return InvalidAnimation;
+}
 
-    animations[name] = clip;
+void Animator::SetClips(std::shared_ptr<const AnimationClipSet> clipSet) {
+    clips = std::move(clipSet);
+    current = InvalidAnimation;
 
     // 最初のアニメーションをデフォルトで再生する
-    if (currentClip == nullptr) {
-        Play(name);
+    if (clips && clips->GetClipCount() > 0) {
+        Play(0);
     }
 }
 
-void Animator::Play(std::string name) {
+void Animator::Play(AnimationHandle handle) {
     // すでに同じアニメーションが再生中ならリセットしない
-    if (currentClip && currentClip->name == name) {
+    if (handle == current) {
         return;
     }
 
     // 新しいアニメーションが見つかったら切り替える
-    if (animations.count(name) > 0) {
-        currentClip = &animations[name];
+    if (clips && clips->Get(handle)) {
+        current = handle;
         currentFrameIndex = 0;
         timer = 0;
     }
 }
 
 void Animator::Update() {
-    if (!currentClip) return;
+    const AnimationClip* clip = clips ? clips->Get(current) : nullptr;
+    if (!clip) return;
 
     timer += Time::deltaTime;
 
     // 設定された速度を超えたら次のコマへ
-    if (timer >= currentClip->speed) {
+    if (timer >= clip->speed) {
         timer = 0;
         currentFrameIndex++;
 
         // 最後のコマまで行ったら
-        if (currentFrameIndex >= currentClip->frameCount) {
-            if (currentClip->loop) {
+        if (currentFrameIndex >= clip->frameCount) {
+            if (clip->loop) {
                 currentFrameIndex = 0; // ループする
             }
             else {
-                currentFrameIndex = currentClip->frameCount - 1; // 最後の絵で止める
+                currentFrameIndex = (std::int16_t)(clip->frameCount - 1); // 最後の絵で止める
             }
         }
     }
 }
 
-SDL_Rect Animator::GetSrcRect(int w, int h) {
+SDL_Rect Animator::GetSrcRect(int w, int h) const {
     SDL_Rect src;
     src.w = w;
     src.h = h;
 
-    if (currentClip) {
+    const AnimationClip* clip = clips ? clips->Get(current) : nullptr;
+    if (clip) {
         src.x = currentFrameIndex * w;
-        src.y = currentClip->row * h;
+        src.y = clip->row * h;
     }
     else {
         // アニメーションがない時は左上を表示
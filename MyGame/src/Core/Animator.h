@@ -1,40 +1,78 @@
 ﻿#pragma once
 #include <SDL.h>
 #include <string>
-#include <map>
 #include <vector>
-
-#include <nlohmann/json.hpp>
-using json = nlohmann::json;
+#include <memory>
+#include <cstdint>
+#include "StringId.h"
 
 // 1つのアニメーションの定義
 struct AnimationClip {
-    std::string name;
+    StringId name;
     int row;          // スプライトシートの何行目か
     int frameCount;   // 何コマあるか
     float speed;      // 切り替え速度（秒）
     bool loop;        // ループするかどうか
 };
 
+// クリップセット内のクリップの番号（読み込み後に Find で一度だけ求めておく。-1 は無効）
+using AnimationHandle = std::int16_t;
+constexpr AnimationHandle InvalidAnimation = -1;
+
+/**
+ * @brief 1つの JSON ファイルから読み込んだクリップの集まり（読み込み後は変更しない）
+ * 同じファイルは一度だけ読み込み、使うすべての Animator で共有します（最後の参照が消えると解放）。
+ * クリップは名前ではなく番号（AnimationHandle）で指すため、再生の切り替えに文字列は使いません。
+ */
+class AnimationClipSet {
+public:
+    // filePath のクリップセットを返す（読み込み済みならそれを共有する。読めなければ空のセット）
+    static std::shared_ptr<const AnimationClipSet> Load(const std::string& filePath);
+
+    // コードで定義したクリップからセットを作る（共有の表には登録しない）
+    static std::shared_ptr<const AnimationClipSet> Create(std::vector<AnimationClip> clips);
+
+    // 名前からクリップの番号を求める（読み込み時に一度だけ使う。なければ InvalidAnimation）
+    AnimationHandle Find(StringId name) const;
+
+    const AnimationClip* Get(AnimationHandle handle) const {
+        return (handle >= 0 && handle < (int)clips.size()) ? &clips[handle] : nullptr;
+    }
+    int GetClipCount() const { return (int)clips.size(); }
+
+private:
+    bool LoadFromJson(const std::string& filePath);
+
+    std::vector<AnimationClip> clips;
+};
+
+/**
+ * @brief クリップセットのどのコマを表示するかだけを持つ再生状態
+ * クリップの定義は共有の AnimationClipSet が持つため、1体あたりはポインタと数バイトです。
+ */
 class Animator {
 public:
-    Animator();
-    bool LoadFromJson(std::string filePath);
-    void AddAnimation(std::string name, int row, int frameCount, float speed, bool loop = true);
-    // 再生するアニメーションを切り替える
-    void Play(std::string name);
+    Animator() = default;
+
+    // クリップセットを割り当て、最初のクリップから再生する
+    void SetClips(std::shared_ptr<const AnimationClipSet> clipSet);
+    const AnimationClipSet* GetClips() const { return clips.get(); }
+
+    // 割り当てたセットでのクリップの番号（読み込み時に一度だけ求めておく）
+    AnimationHandle Find(StringId name) const { return clips ? clips->Find(name) : InvalidAnimation; }
+
+    // 再生するアニメーションを切り替える（同じクリップの再生中なら何もしない）
+    void Play(AnimationHandle handle);
 
     // 毎フレーム更新
     void Update();
 
     // 現在のコマの画像範囲を取得
-    SDL_Rect GetSrcRect(int w, int h);
+    SDL_Rect GetSrcRect(int w, int h) const;
 
 private:
-    std::map<std::string, AnimationClip> animations;
-    std::string currentAnimName;
-    AnimationClip* currentClip;
-
-    float timer;
-    int currentFrameIndex;
+    std::shared_ptr<const AnimationClipSet> clips;
+    AnimationHandle current = InvalidAnimation;
+    std::int16_t currentFrameIndex = 0;
+    float timer = 0.0f;
 };
\ No newline at end of file
@@ -0,0 +1,582 @@
+﻿#include "Benchmark.h"
+#include "ConfigManager.h"
+#include "GameParams.h"
+#include "Physics.h"
+#include "EcsBridge.h"
+#include "Components.h"
+#include "ObjectHotData.h"
+#include "SweepAndPrune.h"
+#include "DrawList.h"
+#include "ParticleSystem.h"
+#include "Camera.h"
+#include "StringId.h"
+#include "Animator.h"
+#include "Time.h"
+#include "../Objects/Enemy.h"
+#include "../Objects/Bullet.h"
+#include <SDL.h>
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <cstdlib>
+#include <chrono>
+#include <cmath>
+
+bool Benchmark::RunFromCommandLine(int argc, char* argv[]) {
+    int benchIndex = -1;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--bench") {
+            benchIndex = i;
+            break;
+        }
+    }
+    if (benchIndex < 0) return false;
+
+    std::string target = (benchIndex + 1 < argc) ? argv[benchIndex + 1] : "all";
+    int iterations = (benchIndex + 2 < argc) ? std::atoi(argv[benchIndex + 2]) : 100;
+    if (iterations <= 0) iterations = 100;
+
+    bool ran = false;
+    if (target == "all" || target == "config") {
+        RunConfigLoad(iterations);
+        ran = true;
+    }
+    if (target == "all" || target == "spawn") {
+        RunSpawnBurst(iterations);
+        ran = true;
+    }
+    if (target == "all" || target == "ecs") {
+        RunEcsMovement(iterations);
+        ran = true;
+    }
+    if (target == "all" || target == "integrate") {
+        RunIntegrate(iterations);
+        ran = true;
+    }
+    if (target == "all" || target == "broadphase") {
+        RunBroadphase(iterations);
+        ran = true;
+    }
+    if (target == "all" || target == "drawlist") {
+        RunDrawList(iterations);
+        ran = true;
+    }
+    if (target == "all" || target == "particles") {
+        RunParticles(iterations);
+        ran = true;
+    }
+    if (target == "all" || target == "names") {
+        RunNames(iterations);
+        ran = true;
+    }
+    if (target == "all" || target == "animator") {
+        RunAnimator(iterations);
+        ran = true;
+    }
+
+    if (!ran) {
+        std::cerr << "Unknown benchmark: " << target << " (available: all, config, spawn, ecs, integrate, broadphase, drawlist, particles, names, animator)" << std::endl;
+    }
+    return true;
+}
+
+void Benchmark::RunConfigLoad(int iterations) {
+    ConfigManager::BenchmarkLoad(iterations);
+}
+
+void Benchmark::RunSpawnBurst(int iterations) {
+    const int BURST_SIZE = 200;
+
+    // ウィンドウを作らずにテクスチャを読み込めるよう、ソフトウェアレンダラーを使う
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, 64, 64, 32, SDL_PIXELFORMAT_RGBA8888);
+    SDL_Renderer* renderer = surface ? SDL_CreateSoftwareRenderer(surface) : nullptr;
+    if (!renderer) {
+        std::cerr << "Benchmark: could not create software renderer: " << SDL_GetError() << std::endl;
+        if (surface) SDL_FreeSurface(surface);
+        return;
+    }
+
+    std::vector<SDL_FPoint> dummyPath;
+    std::vector<std::unique_ptr<Enemy>> spawned;
+    std::vector<std::unique_ptr<Enemy>> pool;
+    spawned.reserve(BURST_SIZE);
+    pool.reserve(BURST_SIZE);
+    double freq = (double)SDL_GetPerformanceFrequency();
+
+    // prepare（計測しない）の後に spawnBurst（1回のまとまった出現）を計測し、最悪値と平均値を求める
+    auto measure = [&](auto&& prepare, auto&& spawnBurst, double& worstMs, double& averageMs) {
+        worstMs = 0.0;
+        double totalMs = 0.0;
+        for (int i = 0; i < iterations; ++i) {
+            spawned.clear();
+            prepare();
+            Uint64 start = SDL_GetPerformanceCounter();
+            spawnBurst();
+            double ms = (SDL_GetPerformanceCounter() - start) * 1000.0 / freq;
+            worstMs = std::max(worstMs, ms);
+            totalMs += ms;
+        }
+        averageMs = totalMs / iterations;
+    };
+
+    // 以前の方式：出現のたびに生成し、設定とテクスチャを解決する
+    double directWorst, directAverage;
+    measure([]() {}, [&]() {
+        for (int n = 0; n < BURST_SIZE; ++n) {
+            auto enemy = std::make_unique<Enemy>(1300.0f, 200.0f, 64, 64, nullptr, dummyPath);
+            enemy->RefreshConfig(renderer);
+            spawned.push_back(std::move(enemy));
+        }
+    }, directWorst, directAverage);
+
+    // 現在の方式：準備期間中に作っておいた敵を取り出して位置を設定するだけ
+    auto archetype = EnemyArchetype::Create(GameParams::GetInstance().enemy, renderer);
+    double pooledWorst, pooledAverage;
+    measure([&]() {
+        while ((int)pool.size() < BURST_SIZE) {
+            auto enemy = std::make_unique<Enemy>(0.0f, 0.0f, 64, 64, nullptr, dummyPath);
+            enemy->ApplyArchetype(archetype);
+            pool.push_back(std::move(enemy));
+        }
+    }, [&]() {
+        for (int n = 0; n < BURST_SIZE; ++n) {
+            std::unique_ptr<Enemy> enemy = std::move(pool.back());
+            pool.pop_back();
+            enemy->Activate(1300.0f, 200.0f);
+            spawned.push_back(std::move(enemy));
+        }
+    }, pooledWorst, pooledAverage);
+
+    std::cout << "Spawn burst of " << BURST_SIZE << " enemies (" << iterations << " iterations)" << std::endl;
+    std::cout << "  construct on spawn: worst " << directWorst << " ms, avg " << directAverage << " ms" << std::endl;
+    std::cout << "  prewarmed pool    : worst " << pooledWorst << " ms, avg " << pooledAverage << " ms" << std::endl;
+
+    spawned.clear();
+    pool.clear();
+    SDL_DestroyRenderer(renderer);
+    SDL_FreeSurface(surface);
+}
+
+void Benchmark::RunEcsMovement(int iterations) {
+    const int OBJECT_COUNT = 20000;
+    const float dt = 1.0f / 60.0f;
+
+    // 弾と、重力を受けて落ちる物体を半分ずつ用意する
+    std::vector<std::unique_ptr<GameObject>> objects;
+    objects.reserve(OBJECT_COUNT);
+    for (int i = 0; i < OBJECT_COUNT; ++i) {
+        auto bullet = std::make_unique<Bullet>((float)(i % 1000), (float)(i / 1000), 10, 10,
+            5.0f + (i % 7), -3.0f + (i % 5), 10, nullptr, BulletSide::Player);
+        bullet->useGravity = (i % 2 == 0);
+        objects.push_back(std::move(bullet));
+    }
+
+    Registry registry;
+    for (auto& obj : objects) {
+        EcsBridge::Link(registry, *obj);
+    }
+
+    using Clock = std::chrono::high_resolution_clock;
+    auto msPerIteration = [&](auto&& body) {
+        auto start = Clock::now();
+        for (int i = 0; i < iterations; ++i) body();
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count() / iterations;
+    };
+
+    // 以前の方式：オブジェクトごとに判定して ApplyPhysics を呼ぶ（Scene::Update と同じ）
+    double objectMs = msPerIteration([&]() {
+        for (auto& obj : objects) {
+            if (obj->useGravity || std::abs(obj->velX) > 0 || std::abs(obj->velY) > 0) {
+                Physics::ApplyPhysics(obj.get(), dt);
+            }
+        }
+    });
+
+    // ECS：構成要素の配列を MovementSystem がまとめて積分する
+    double systemMs = msPerIteration([&]() {
+        MovementSystem::Update(registry, dt);
+    });
+
+    // 移行中の形：GameObject との書き出し・書き戻しを含めた場合
+    double bridgedMs = msPerIteration([&]() {
+        EcsBridge::Push(registry, objects);
+        MovementSystem::Update(registry, dt);
+        EcsBridge::Pull(registry, objects);
+    });
+
+    std::cout << "[ECS Movement] " << OBJECT_COUNT << " objects, iterations: " << iterations << std::endl;
+    std::cout << "  GameObject + ApplyPhysics : " << objectMs << " ms/frame" << std::endl;
+    std::cout << "  MovementSystem            : " << systemMs << " ms/frame" << std::endl;
+    std::cout << "  Push + System + Pull      : " << bridgedMs << " ms/frame" << std::endl;
+}
+
+void Benchmark::RunIntegrate(int iterations) {
+    // 端数の処理も通るよう、8の倍数にしない
+    const size_t OBJECT_COUNT = 20003;
+    const float dt = 1.0f / 60.0f;
+
+    // 重力あり・なし、止まっているもの、削除済み、ECS 担当、終端速度を超えているものを混ぜる
+    ObjectHotData source;
+    source.x.resize(OBJECT_COUNT);
+    source.y.resize(OBJECT_COUNT);
+    source.width.assign(OBJECT_COUNT, 10.0f);
+    source.height.assign(OBJECT_COUNT, 10.0f);
+    source.velX.resize(OBJECT_COUNT);
+    source.velY.resize(OBJECT_COUNT);
+    source.accX.resize(OBJECT_COUNT);
+    source.accY.resize(OBJECT_COUNT);
+    source.prevX.resize(OBJECT_COUNT);
+    source.prevY.resize(OBJECT_COUNT);
+    source.flags.resize(OBJECT_COUNT);
+    for (size_t i = 0; i < OBJECT_COUNT; ++i) {
+        source.x[i] = (float)(i % 1000);
+        source.y[i] = (float)(i / 1000);
+        source.velX[i] = (i % 5 == 0) ? 0.0f : -300.0f + (float)(i % 601);
+        source.velY[i] = (i % 5 == 0) ? 0.0f : -2500.0f + (float)(i % 5001);
+        source.accX[i] = (i % 3 == 0) ? 50.0f : 0.0f;
+        source.accY[i] = (i % 4 == 0) ? -80.0f : 0.0f;
+        std::uint8_t flags = 0;
+        if (i % 2 == 0) flags |= ObjectHotData::GRAVITY;
+        if (i % 97 == 0) flags |= ObjectHotData::DEAD;
+        if (i % 89 == 0) flags |= ObjectHotData::ECS;
+        source.flags[i] = flags;
+    }
+
+    using Clock = std::chrono::high_resolution_clock;
+    struct Result {
+        const char* label;
+        Physics::IntegratePath path;
+        ObjectHotData data;
+        double ms = 0.0;
+    };
+    std::vector<Result> results;
+    results.push_back({ "Scalar", Physics::IntegratePath::Scalar, source });
+    results.push_back({ "SSE2  ", Physics::IntegratePath::SSE2, source });
+    results.push_back({ "AVX2  ", Physics::IntegratePath::AVX2, source });
+
+    // 加速度は毎フレーム 0 に戻るため、同じ初期状態から同じフレーム数だけ進めて比べる
+    for (Result& result : results) {
+        auto start = Clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            Physics::IntegrateHot(result.data, dt, result.path);
+        }
+        result.ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / iterations;
+    }
+
+    // Scalar との最大誤差（相対、値が小さい場合は絶対）
+    auto maxError = [](const ObjectHotData& a, const ObjectHotData& b) {
+        const std::vector<float> ObjectHotData::* fields[] = {
+            &ObjectHotData::x, &ObjectHotData::y, &ObjectHotData::velX,
+            &ObjectHotData::velY, &ObjectHotData::accX, &ObjectHotData::accY,
+        };
+        float worst = 0.0f;
+        for (auto field : fields) {
+            const std::vector<float>& va = a.*field;
+            const std::vector<float>& vb = b.*field;
+            for (size_t i = 0; i < va.size(); ++i) {
+                float scale = std::max(1.0f, std::abs(va[i]));
+                worst = std::max(worst, std::abs(va[i] - vb[i]) / scale);
+            }
+        }
+        return worst;
+    };
+
+    const float TOLERANCE = 1e-5f;
+    Physics::IntegratePath best = Physics::GetBestIntegratePath();
+    std::cout << "[Integrate] " << OBJECT_COUNT << " objects, iterations: " << iterations << std::endl;
+    for (const Result& result : results) {
+        std::cout << "  " << result.label << " : " << result.ms << " ms/frame";
+        if ((int)result.path > (int)best) {
+            std::cout << " (not available, ran " << (best == Physics::IntegratePath::SSE2 ? "SSE2" : "Scalar") << ")";
+        }
+        if (result.path != Physics::IntegratePath::Scalar) {
+            float error = maxError(results[0].data, result.data);
+            std::cout << ", max error " << error << (error <= TOLERANCE ? " OK" : " MISMATCH");
+        }
+        std::cout << std::endl;
+    }
+}
+
+void Benchmark::RunBroadphase(int iterations) {
+    const int OBJECT_COUNTS[] = { 500, 2000, 5000 };
+    const float LEVEL_WIDTH = 5000.0f;   // PlayScene のカメラの移動範囲と同じ横長のステージ
+    const float LEVEL_HEIGHT = 600.0f;
+    const float dt = 1.0f / 60.0f;
+
+    using Clock = std::chrono::high_resolution_clock;
+    std::cout << "[Broadphase] level " << LEVEL_WIDTH << " x " << LEVEL_HEIGHT << ", frames: " << iterations << std::endl;
+
+    for (int objectCount : OBJECT_COUNTS) {
+        // ステージ全体に散らばって左右に動くオブジェクト
+        std::vector<std::unique_ptr<GameObject>> objects;
+        objects.reserve(objectCount);
+        for (int i = 0; i < objectCount; ++i) {
+            float x = std::fmod(i * 2654.435f, LEVEL_WIDTH);
+            float y = std::fmod(i * 97.13f, LEVEL_HEIGHT);
+            float speed = (i % 2 == 0 ? 1.0f : -1.0f) * (60.0f + (i % 11) * 20.0f);
+            objects.push_back(std::make_unique<Bullet>(x, y, 16 + (i % 3) * 16, 16 + (i % 2) * 16,
+                speed, 0.0f, 10, nullptr, BulletSide::Player));
+        }
+
+        ObjectHotData hot;
+        SweepAndPrune broadphase;
+        double allPairsMs = 0.0;
+        double sweepMs = 0.0;
+        long long allPairsHits = 0;
+        long long sweepHits = 0;
+
+        for (int frame = 0; frame < iterations; ++frame) {
+            for (auto& obj : objects) {
+                obj->x += obj->velX * dt;
+                if (obj->x < 0.0f || obj->x > LEVEL_WIDTH) obj->velX = -obj->velX;
+            }
+            hot.Gather(objects);
+            const size_t count = objects.size();
+
+            auto start = Clock::now();
+            for (size_t i = 0; i < count; ++i) {
+                for (size_t j = i + 1; j < count; ++j) {
+                    if (hot.Overlaps(i, j)) ++allPairsHits;
+                }
+            }
+            auto middle = Clock::now();
+            broadphase.Update(objects, hot);
+            for (size_t i = 0; i < count; ++i) {
+                for (std::uint32_t j : broadphase.Candidates(i)) {
+                    if (j > i && hot.Overlaps(i, j)) ++sweepHits;
+                }
+            }
+            auto end = Clock::now();
+
+            allPairsMs += std::chrono::duration<double, std::milli>(middle - start).count();
+            sweepMs += std::chrono::duration<double, std::milli>(end - middle).count();
+        }
+
+        std::cout << "  " << objectCount << " objects" << std::endl;
+        std::cout << "    All pairs       : " << allPairsMs / iterations << " ms/frame" << std::endl;
+        std::cout << "    Sweep and prune : " << sweepMs / iterations << " ms/frame"
+            << (sweepHits == allPairsHits ? " (same overlaps)" : " (OVERLAP MISMATCH)") << std::endl;
+    }
+}
+
+void Benchmark::RunDrawList(int iterations) {
+    const int SPRITE_COUNT = 3000;
+    const int VIEW_W = 1200;
+    const int VIEW_H = 800;
+
+    // 描画スレッドは作らず、ソフトウェアレンダラーに対して同じスレッドで比べる
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, VIEW_W, VIEW_H, 32, SDL_PIXELFORMAT_RGBA8888);
+    SDL_Renderer* renderer = surface ? SDL_CreateSoftwareRenderer(surface) : nullptr;
+    SDL_Texture* sprite = renderer ? SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STATIC, 32, 32) : nullptr;
+    if (!sprite) {
+        std::cerr << "Benchmark: could not create software renderer: " << SDL_GetError() << std::endl;
+        if (renderer) SDL_DestroyRenderer(renderer);
+        if (surface) SDL_FreeSurface(surface);
+        return;
+    }
+
+    // 敵の描画（画像 + HPバー2本）と同じ形の命令を並べる
+    std::vector<SDL_Rect> rects(SPRITE_COUNT);
+    for (int i = 0; i < SPRITE_COUNT; ++i) {
+        rects[i] = { (i * 37) % (VIEW_W - 32), (i * 53) % (VIEW_H - 32), 32, 32 };
+    }
+
+    using Clock = std::chrono::high_resolution_clock;
+    double directMs = 0.0, recordMs = 0.0, executeMs = 0.0;
+    DrawList drawList;
+    for (int iter = 0; iter < iterations; ++iter) {
+        auto start = Clock::now();
+        for (const SDL_Rect& rect : rects) {
+            SDL_Rect bar = { rect.x, rect.y - 10, rect.w, 4 };
+            SDL_RenderCopyEx(renderer, sprite, NULL, &rect, 0.0, NULL, SDL_FLIP_NONE);
+            SDL_SetRenderDrawColor(renderer, 30, 30, 30, 255);
+            SDL_RenderFillRect(renderer, &bar);
+            bar.w /= 2;
+            SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
+            SDL_RenderFillRect(renderer, &bar);
+        }
+        auto direct = Clock::now();
+
+        drawList.Begin(VIEW_W, VIEW_H);
+        for (const SDL_Rect& rect : rects) {
+            SDL_Rect bar = { rect.x, rect.y - 10, rect.w, 4 };
+            drawList.CopyEx(sprite, NULL, &rect, 0.0, SDL_FLIP_NONE);
+            drawList.SetDrawColor(30, 30, 30, 255);
+            drawList.FillRect(bar);
+            bar.w /= 2;
+            drawList.SetDrawColor(255, 0, 0, 255);
+            drawList.FillRect(bar);
+        }
+        auto recorded = Clock::now();
+        drawList.Execute(renderer);
+        auto executed = Clock::now();
+
+        directMs += std::chrono::duration<double, std::milli>(direct - start).count();
+        recordMs += std::chrono::duration<double, std::milli>(recorded - direct).count();
+        executeMs += std::chrono::duration<double, std::milli>(executed - recorded).count();
+    }
+
+    std::cout << "[DrawList] " << SPRITE_COUNT << " sprites with HP bars (" << drawList.GetCommandCount()
+        << " commands), software renderer, iterations: " << iterations << std::endl;
+    std::cout << "  Direct SDL calls         : " << directMs / iterations << " ms/frame" << std::endl;
+    std::cout << "  Record (main thread)     : " << recordMs / iterations << " ms/frame" << std::endl;
+    std::cout << "  Execute (render thread)  : " << executeMs / iterations << " ms/frame" << std::endl;
+
+    SDL_DestroyTexture(sprite);
+    SDL_DestroyRenderer(renderer);
+    SDL_FreeSurface(surface);
+}
+
+void Benchmark::RunNames(int iterations) {
+    const int OBJECT_COUNT = 5000;
+    const char* NAMES[] = { "Enemy", "Block", "Player", "EnemyBullet", "Editor Ground", "Turret (Basic)", "Base Gate" };
+    const int NAME_COUNT = (int)(sizeof(NAMES) / sizeof(NAMES[0]));
+
+    // ObjectHotData::MakeFlags と Physics の接地判定が毎フレーム行う判定と同じもの
+    std::vector<std::string> stringNames(OBJECT_COUNT);
+    std::vector<StringId> idNames(OBJECT_COUNT);
+    for (int i = 0; i < OBJECT_COUNT; ++i) {
+        stringNames[i] = NAMES[(i * 7) % NAME_COUNT];
+        idNames[i] = StringId(stringNames[i]);
+    }
+
+    using Clock = std::chrono::high_resolution_clock;
+    long long stringHits = 0, idHits = 0;
+    auto start = Clock::now();
+    for (int iter = 0; iter < iterations; ++iter) {
+        for (const std::string& name : stringNames) {
+            if (name == "Player" || name == "TestPlayer" || name == "Enemy" || name == "Test Enemy") ++stringHits;
+            if (name == "Block" || name == "Editor Ground") ++stringHits;
+        }
+    }
+    auto middle = Clock::now();
+    for (int iter = 0; iter < iterations; ++iter) {
+        for (StringId name : idNames) {
+            if (name == ObjectNames::Player || name == ObjectNames::TestPlayer ||
+                name == ObjectNames::Enemy || name == ObjectNames::TestEnemy) ++idHits;
+            if (name == ObjectNames::Block || name == ObjectNames::EditorGround) ++idHits;
+        }
+    }
+    auto end = Clock::now();
+
+    double stringMs = std::chrono::duration<double, std::milli>(middle - start).count() / iterations;
+    double idMs = std::chrono::duration<double, std::milli>(end - middle).count() / iterations;
+    std::cout << "[Names] " << OBJECT_COUNT << " objects, frames: " << iterations << std::endl;
+    std::cout << "  std::string compare : " << stringMs << " ms/frame" << std::endl;
+    std::cout << "  StringId compare    : " << idMs << " ms/frame"
+        << (stringHits == idHits ? " (same result)" : " (RESULT MISMATCH)") << std::endl;
+    std::cout << "  Interned strings    : " << StringId::GetRegisteredCount() << std::endl;
+}
+
+void Benchmark::RunAnimator(int iterations) {
+    const int ANIMATOR_COUNT = 5000;
+
+    // player.json と同じ形のクリップ（全員で1つのセットを共有する）
+    std::shared_ptr<const AnimationClipSet> clipSet = AnimationClipSet::Create({
+        { StringId("Idle"), 0, 4, 0.2f, true },
+        { StringId("Run"), 1, 6, 0.1f, true },
+        { StringId("Jump"), 2, 3, 0.1f, false },
+    });
+    std::vector<Animator> animators(ANIMATOR_COUNT);
+    for (Animator& animator : animators) animator.SetClips(clipSet);
+    AnimationHandle idle = clipSet->Find(StringId("Idle"));
+    AnimationHandle run = clipSet->Find(StringId("Run"));
+
+    using Clock = std::chrono::high_resolution_clock;
+    int checksum = 0;
+    auto start = Clock::now();
+    {
+        Time::ScopedDeltaTime fixedStep(1.0f / 60.0f);
+        for (int iter = 0; iter < iterations; ++iter) {
+            for (int i = 0; i < ANIMATOR_COUNT; ++i) {
+                // Player::Update と同じく毎フレーム Play を呼び、時々クリップが切り替わる
+                animators[i].Play(((i + iter / 30) % 3 == 0) ? run : idle);
+                animators[i].Update();
+                checksum += animators[i].GetSrcRect(32, 32).x;
+            }
+        }
+    }
+    auto end = Clock::now();
+
+    double ms = std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+    std::cout << "[Animator] " << ANIMATOR_COUNT << " animators sharing " << clipSet->GetClipCount() << " clips, frames: " << iterations << std::endl;
+    std::cout << "  Play + Update : " << ms << " ms/frame (checksum " << checksum << ")" << std::endl;
+    std::cout << "  Per instance  : " << sizeof(Animator) << " bytes, clip set refs: " << clipSet.use_count() << std::endl;
+}
+
+void Benchmark::RunParticles(int iterations) {
+    const int TARGET_PARTICLES = 50000;
+    const int VIEW_W = 1200;
+    const int VIEW_H = 800;
+    const double FRAME_BUDGET_MS = 1000.0 / 60.0;
+
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, VIEW_W, VIEW_H, 32, SDL_PIXELFORMAT_RGBA8888);
+    SDL_Renderer* renderer = surface ? SDL_CreateSoftwareRenderer(surface) : nullptr;
+    if (!renderer) {
+        std::cerr << "Benchmark: could not create software renderer: " << SDL_GetError() << std::endl;
+        if (surface) SDL_FreeSurface(surface);
+        return;
+    }
+
+    // 計測の間は粒子が消えたり画面外へ落ちたりしないようにして、常に5万粒子を画面内に保つ
+    ParticleSystem& particles = ParticleSystem::GetInstance();
+    const ParticleEffect EFFECTS[] = { ParticleEffect::Hit, ParticleEffect::Death, ParticleEffect::MuzzleFlash, ParticleEffect::BaseImpact };
+    ParticleEmitterDesc savedDescs[(int)ParticleEffect::Count];
+    for (ParticleEffect effect : EFFECTS) {
+        ParticleEmitterDesc& desc = particles.GetDesc(effect);
+        savedDescs[(int)effect] = desc;
+        desc.lifeMin = desc.lifeMax = 1.0e6f;
+        desc.gravity = 0.0f;
+        desc.speedMin = 0.0f;
+        desc.speedMax = 20.0f;
+    }
+    particles.Clear();
+    for (int i = 0; particles.GetActiveCount() < TARGET_PARTICLES && i < TARGET_PARTICLES; ++i) {
+        float x = 50.0f + (float)((i * 37) % (VIEW_W - 100));
+        float y = 50.0f + (float)((i * 53) % (VIEW_H - 100));
+        particles.Emit(EFFECTS[i % 4], x, y, 0.0f, 16);
+    }
+    int active = particles.GetActiveCount();
+
+    Camera camera(VIEW_W, VIEW_H);
+    camera.x = 0.0f;
+    camera.y = 0.0f;
+    DrawList drawList;
+    using Clock = std::chrono::high_resolution_clock;
+    double updateMs = 0.0, recordMs = 0.0, executeMs = 0.0, worstMainMs = 0.0;
+    for (int iter = 0; iter < iterations; ++iter) {
+        auto start = Clock::now();
+        particles.Update(1.0f / 60.0f);
+        auto updated = Clock::now();
+        drawList.Begin(VIEW_W, VIEW_H);
+        particles.Render(drawList, &camera);
+        auto recorded = Clock::now();
+        drawList.Execute(renderer);
+        auto executed = Clock::now();
+
+        double update = std::chrono::duration<double, std::milli>(updated - start).count();
+        double record = std::chrono::duration<double, std::milli>(recorded - updated).count();
+        updateMs += update;
+        recordMs += record;
+        executeMs += std::chrono::duration<double, std::milli>(executed - recorded).count();
+        worstMainMs = std::max(worstMainMs, update + record);
+    }
+
+    particles.Clear();
+    for (ParticleEffect effect : EFFECTS) {
+        particles.GetDesc(effect) = savedDescs[(int)effect];
+    }
+
+    double mainMs = (updateMs + recordMs) / iterations;
+    std::cout << "[Particles] " << active << " particles on screen, software renderer, frames: " << iterations << std::endl;
+    std::cout << "  Update (SIMD)            : " << updateMs / iterations << " ms/frame" << std::endl;
+    std::cout << "  Record geometry          : " << recordMs / iterations << " ms/frame" << std::endl;
+    std::cout << "  Main thread total        : " << mainMs << " ms/frame (worst " << worstMainMs << " ms)"
+        << (worstMainMs <= FRAME_BUDGET_MS ? " - fits 60 FPS" : " - OVER 60 FPS BUDGET") << std::endl;
+    std::cout << "  Execute (render thread)  : " << executeMs / iterations << " ms/frame"
+        << (executeMs / iterations <= FRAME_BUDGET_MS ? " - fits 60 FPS" : " - over 60 FPS budget on the software renderer") << std::endl;
+
+    SDL_DestroyRenderer(renderer);
+    SDL_FreeSurface(surface);
+}
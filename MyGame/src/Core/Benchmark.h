@@ -0,0 +1,37 @@
+﻿#pragma once
+#include <string>
+
+/**
+ * @brief コマンドラインから実行する計測用のエントリポイント
+ * `MyGame --bench [対象] [反復回数]` で起動すると、ゲームを開始せずに計測結果を表示して終了します。
+ * 対象を省略した場合はすべての計測を実行します。
+ */
+class Benchmark {
+public:
+    /**
+     * @brief 引数に --bench が含まれていれば計測を実行する
+     * @return 計測を実行した場合は true（呼び出し側はそのまま終了する）
+     */
+    static bool RunFromCommandLine(int argc, char* argv[]);
+
+private:
+    Benchmark() = delete;
+
+    static void RunConfigLoad(int iterations);
+    // ウェーブ開始時のまとまった出現（その場で生成 / 準備済みのプールから取り出し）の比較
+    static void RunSpawnBurst(int iterations);
+    // 移動の積分（GameObject ごとの ApplyPhysics / ECS の MovementSystem）の比較
+    static void RunEcsMovement(int iterations);
+    // 配列にまとめた移動の積分（Scalar / SSE2 / AVX2）の比較と、結果が Scalar と一致するかの確認
+    static void RunIntegrate(int iterations);
+    // 当たり判定の候補の求め方（総当たり / SweepAndPrune）の比較
+    static void RunBroadphase(int iterations);
+    // 1フレーム分の描画（レンダラーへ直接 / DrawList へ記録 / 記録の実行）の比較。記録だけがメインスレッドに残る分
+    static void RunDrawList(int iterations);
+    // 5万粒子の更新と描画（記録 / ソフトウェアレンダラーでの実行）が1フレーム（16.6ms）に収まるか
+    static void RunParticles(int iterations);
+    // 名前による種類の判定（文字列の比較 / StringId の番号の比較）の比較
+    static void RunNames(int iterations);
+    // クリップセットを共有した大量の Animator の切り替えと更新
+    static void RunAnimator(int iterations);
+};
@@ -0,0 +1,44 @@
+﻿#pragma once
+#include <SDL.h>
+
+// ECS の構成要素（データだけを持ち、処理はシステム側に書く）
+
+struct Transform {
+    float x = 0.0f;
+    float y = 0.0f;
+    double angle = 0.0;
+};
+
+struct Velocity {
+    float x = 0.0f;
+    float y = 0.0f;
+    float accX = 0.0f;    // そのフレームだけ加える加速度（積分後に 0 に戻す）
+    float accY = 0.0f;
+    bool useGravity = false;
+};
+
+struct Collider {
+    int width = 0;
+    int height = 0;
+    bool isTrigger = false;
+    bool isStatic = false;
+};
+
+struct Sprite {
+    SDL_Texture* texture = nullptr;
+};
+
+struct Health {
+    int hp = 0;
+    int maxHp = 0;
+};
+
+enum class FactionType {
+    Neutral,
+    Player,   // プレイヤー・タレット・プレイヤーの弾・拠点
+    Enemy,    // 敵・敵の弾
+};
+
+struct Faction {
+    FactionType type = FactionType::Neutral;
+};
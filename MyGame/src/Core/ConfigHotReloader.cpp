@@ -0,0 +1,159 @@
+﻿#include "ConfigHotReloader.h"
+#include "ConfigManager.h"
+#include "GameParams.h"
+#include "GameSession.h"
+#include "../Scenes/Scene.h"
+#include "../TextureManager.h"
+#include "Logger.h"
+#include <SDL_image.h>
+#include <fstream>
+#include <algorithm>
+#include <cctype>
+
+namespace {
+    const char* CONFIG_DIRECTORY = "assets/data";
+    const char* IMAGE_DIRECTORY = "assets/images";
+}
+
+ConfigHotReloader::~ConfigHotReloader() {
+    Stop();
+}
+
+bool ConfigHotReloader::Start() {
+    // 起動時に読み込んだファイルの内容を基準にする
+    std::ifstream file(ConfigManager::GetConfigPath());
+    if (file.is_open()) {
+        try {
+            file >> baseline;
+        }
+        catch (const std::exception&) {
+            baseline = nlohmann::json::object();
+        }
+    }
+
+    return watcher.Start({ CONFIG_DIRECTORY, IMAGE_DIRECTORY },
+        [this](const std::string& path) { OnFileChanged(path); });
+}
+
+void ConfigHotReloader::Stop() {
+    watcher.Stop();
+
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    for (auto& pair : pendingImages) {
+        if (pair.second) SDL_FreeSurface(pair.second);
+    }
+    pendingImages.clear();
+    hasPendingConfig = false;
+}
+
+void ConfigHotReloader::SetBaseline(const nlohmann::json& j) {
+    baseline = j;
+}
+
+bool ConfigHotReloader::IsImageFile(const std::string& path) {
+    std::string ext = path.substr(path.find_last_of('.') + 1);
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+    return ext == "png" || ext == "jpg" || ext == "jpeg" || ext == "bmp";
+}
+
+void ConfigHotReloader::OnFileChanged(const std::string& path) {
+    if (path == ConfigManager::GetConfigPath()) {
+        // 書き込み途中のファイルを読んだ場合は解析に失敗するので、次の変更通知を待つ
+        std::ifstream file(path);
+        if (!file.is_open()) return;
+        try {
+            nlohmann::json parsed;
+            file >> parsed;
+
+            std::lock_guard<std::mutex> lock(pendingMutex);
+            pendingConfig = std::move(parsed);
+            hasPendingConfig = true;
+        }
+        catch (const std::exception& e) {
+            LOG_WARN(LogCategory::Config, "[Hot Reload] Skipped config (parse error): " << e.what());
+        }
+        return;
+    }
+
+    if (IsImageFile(path)) {
+        // デコードまではこのスレッドで済ませ、テクスチャの作成はメインスレッドに任せる
+        SDL_Surface* surface = IMG_Load(path.c_str());
+        if (!surface) return;
+
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        SDL_Surface*& slot = pendingImages[path];
+        if (slot) SDL_FreeSurface(slot);
+        slot = surface;
+    }
+}
+
+unsigned int ConfigHotReloader::SectionFromKey(const std::string& key) {
+    if (key == "Player" || key == "PlayerPresets" || key == "ActivePlayerPreset") return ConfigSection::Player;
+    if (key == "Gun" || key == "GunPresets" || key == "ActiveGunPreset") return ConfigSection::Gun;
+    if (key == "Enemy" || key == "EnemyPresets" || key == "ActiveEnemyPreset") return ConfigSection::Enemy;
+    if (key == "Camera" || key == "CameraPresets" || key == "ActiveCameraPreset") return ConfigSection::Camera;
+    if (key == "Physics") return ConfigSection::Physics;
+    if (key == "Base") return ConfigSection::Base;
+    if (key == "Levels") return ConfigSection::Levels;
+    return ConfigSection::None;
+}
+
+void ConfigHotReloader::ApplyPending(SDL_Renderer* renderer, Scene* scene) {
+    bool configReady = false;
+    nlohmann::json newConfig;
+    std::map<std::string, SDL_Surface*> images;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        if (hasPendingConfig) {
+            newConfig = std::move(pendingConfig);
+            hasPendingConfig = false;
+            configReady = true;
+        }
+        images.swap(pendingImages);
+    }
+
+    unsigned int changedSections = ConfigSection::None;
+
+    // --- 設定: 前回の内容と比べて変わったトップレベルのキーだけを反映する ---
+    if (configReady && newConfig.is_object()) {
+        nlohmann::json changed = nlohmann::json::object();
+        for (auto it = newConfig.begin(); it != newConfig.end(); ++it) {
+            auto old = baseline.find(it.key());
+            if (old == baseline.end() || *old != it.value()) {
+                changed[it.key()] = it.value();
+                changedSections |= SectionFromKey(it.key());
+            }
+        }
+
+        if (!changed.empty()) {
+            try {
+                from_json(changed, GameParams::GetInstance());
+                std::string sectionNames;
+                for (auto it = changed.begin(); it != changed.end(); ++it) sectionNames += " " + it.key();
+                LOG_INFO(LogCategory::Config, "[Hot Reload] Applied config sections:" << sectionNames);
+            }
+            catch (const std::exception& e) {
+                LOG_ERROR(LogCategory::Config, "[Hot Reload] Failed to apply config: " << e.what());
+                changedSections = ConfigSection::None;
+            }
+        }
+        baseline = std::move(newConfig);
+
+        if (changedSections & ConfigSection::Base) {
+            GameSession::GetInstance().maxBaseHP = GameParams::GetInstance().base.maxHealth;
+        }
+    }
+
+    // --- 画像: 読み込み済みのテクスチャだけを差し替える ---
+    for (auto& pair : images) {
+        TextureReloadResult result = TextureManager::ReloadTexture(pair.first, pair.second, renderer);
+        if (result == TextureReloadResult::Recreated) {
+            // 作り直したテクスチャは各オブジェクトが取り直す必要がある
+            changedSections = ConfigSection::All;
+        }
+    }
+
+    if (scene && changedSections != ConfigSection::None) {
+        scene->ApplyConfigChange(changedSections, renderer);
+    }
+}
@@ -0,0 +1,58 @@
+﻿#pragma once
+#include <SDL.h>
+#include <string>
+#include <map>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include "FileWatcher.h"
+
+class Scene;
+
+/**
+ * @brief 実行中に外部で編集された config.json や画像を検出して反映する
+ * ファイルの読み込み・JSON の解析・画像のデコードは監視スレッドで行い、
+ * 結果はメインループのフレームの区切り（ApplyPending）でまとめて差し替えます。
+ * 設定は前回の内容とセクション単位で比較し、変わったセクションに依存するオブジェクトだけを更新します。
+ */
+class ConfigHotReloader {
+public:
+    ConfigHotReloader() = default;
+    ~ConfigHotReloader();
+
+    /**
+     * @brief 設定ディレクトリと画像ディレクトリの監視を開始する
+     * 開始時点のファイル内容を比較の基準にします。
+     */
+    bool Start();
+    void Stop();
+
+    /**
+     * @brief 溜まっている変更をゲームに反映する（メインスレッドのフレーム先頭で呼ぶ）
+     */
+    void ApplyPending(SDL_Renderer* renderer, Scene* scene);
+
+    /**
+     * @brief 比較の基準となる設定を差し替える（ゲーム自身が保存した内容を再適用しないため）
+     */
+    void SetBaseline(const nlohmann::json& j);
+
+private:
+    // 監視スレッドから呼ばれる
+    void OnFileChanged(const std::string& path);
+
+    static bool IsImageFile(const std::string& path);
+
+    // JSON のトップレベルのキーに対応する設定セクション
+    static unsigned int SectionFromKey(const std::string& key);
+
+    FileWatcher watcher;
+
+    // 監視スレッドとメインスレッドの受け渡し用（mutex で保護）
+    std::mutex pendingMutex;
+    bool hasPendingConfig = false;
+    nlohmann::json pendingConfig;
+    std::map<std::string, SDL_Surface*> pendingImages;
+
+    // 最後に反映した設定ファイルの内容（メインスレッドのみが触る）
+    nlohmann::json baseline;
+};
@@ -1,56 +1,416 @@
 ﻿#include "ConfigManager.h"
+#include "Logger.h"
 #include <fstream>
 #include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstring>
+#include <cstdint>
+#include <filesystem>
+#include <cstdio>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#include <fcntl.h>
+#endif
+
+namespace fs = std::filesystem;
 
 const std::string ConfigManager::CONFIG_FILEPATH = "assets/data/config.json";
+const std::string ConfigManager::CONFIG_BINARY_FILEPATH = "assets/data/config.mdc";
 
-// 設定をファイルに保存する
-bool ConfigManager::Save(const GameParams& params) {
-    const std::string& filepath = CONFIG_FILEPATH;
+namespace {
+    // ヘッダ: マジック(4) + バージョン(4) + 元の JSON のサイズ(4) + 元の JSON のハッシュ(4) + データサイズ(4)
+    // 数値はリトルエンディアンで格納する
+    const size_t BINARY_HEADER_SIZE = 20;
 
-    std::ofstream file(filepath);
-    if (!file.is_open()) {
-        std::cerr << "Error: Could not open file for writing: " << filepath << " (Directory must exist)" << std::endl;
-        return false;
+    void WriteU32(std::vector<std::uint8_t>& out, std::uint32_t value) {
+        for (int i = 0; i < 4; ++i) out.push_back((std::uint8_t)((value >> (i * 8)) & 0xFF));
+    }
+
+    std::uint32_t ReadU32(const std::uint8_t* data) {
+        return (std::uint32_t)data[0] | ((std::uint32_t)data[1] << 8) |
+            ((std::uint32_t)data[2] << 16) | ((std::uint32_t)data[3] << 24);
+    }
+
+    // バイナリがどの JSON から作られたかを見分けるためのハッシュ（FNV-1a）
+    // 更新日時と違い、同じ秒に書かれた場合やコピーで日時が戻った場合も取り違えない
+    std::uint32_t HashSource(const std::string& source) {
+        std::uint32_t hash = 2166136261u;
+        for (unsigned char c : source) {
+            hash = (hash ^ c) * 16777619u;
+        }
+        return hash;
+    }
+
+    // --- 非同期保存の状態（保存スレッドとメインスレッドで共有） ---
+    std::mutex saveMutex;
+    std::condition_variable saveCondition;
+    std::thread saveThread;
+    bool saveThreadStop = false;
+    bool hasPendingSnapshot = false;
+    json pendingSnapshot;
+    ConfigManager::SaveStatus saveStatus;
+
+    bool ReadWholeFile(const std::string& filepath, std::vector<std::uint8_t>& out) {
+        std::ifstream file(filepath, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) return false;
+        std::streamsize size = file.tellg();
+        if (size < 0) return false;
+        out.resize((size_t)size);
+        file.seekg(0, std::ios::beg);
+        return size == 0 || (bool)file.read(reinterpret_cast<char*>(out.data()), size);
     }
 
+    bool ReadWholeFile(const std::string& filepath, std::string& out) {
+        std::vector<std::uint8_t> data;
+        if (!ReadWholeFile(filepath, data)) return false;
+        out.assign(data.begin(), data.end());
+        return true;
+    }
+}
+
+// 設定をファイルに保存する
+bool ConfigManager::Save(const GameParams& params) {
     try {
         json j;
         to_json(j, params);
-        file << j.dump(4);
-        std::cout << "Config saved successfully to: " << filepath << std::endl;
+
+        std::string error;
+        if (!WriteSnapshot(j, error)) {
+            LOG_ERROR(LogCategory::Config, "Error saving config: " << error);
+            return false;
+        }
         return true;
     }
     catch (const std::exception& e) {
-        std::cerr << "Error saving config: " << e.what() << std::endl;
+        LOG_ERROR(LogCategory::Config, "Error saving config: " << e.what());
+        return false;
+    }
+}
+
+json ConfigManager::SaveAsync(const GameParams& params) {
+    // スナップショットだけをメインスレッドで取り、文字列化と書き込みは保存スレッドに任せる
+    json snapshot;
+    to_json(snapshot, params);
+
+    {
+        std::lock_guard<std::mutex> lock(saveMutex);
+        pendingSnapshot = snapshot;
+        hasPendingSnapshot = true;
+        saveStatus.state = SaveState::Saving;
+        saveStatus.message = "Saving...";
+
+        if (!saveThread.joinable()) {
+            saveThreadStop = false;
+            saveThread = std::thread(&ConfigManager::SaveWorker);
+        }
+    }
+    saveCondition.notify_one();
+    return snapshot;
+}
+
+ConfigManager::SaveStatus ConfigManager::GetSaveStatus() {
+    std::lock_guard<std::mutex> lock(saveMutex);
+    return saveStatus;
+}
+
+void ConfigManager::Shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(saveMutex);
+        saveThreadStop = true;
+    }
+    saveCondition.notify_one();
+    if (saveThread.joinable()) {
+        saveThread.join();
+    }
+}
+
+void ConfigManager::SaveWorker() {
+    std::unique_lock<std::mutex> lock(saveMutex);
+    while (true) {
+        saveCondition.wait(lock, [] { return hasPendingSnapshot || saveThreadStop; });
+
+        // 停止要求があっても、保存待ちのスナップショットは書き終えてから抜ける
+        if (!hasPendingSnapshot) break;
+
+        json snapshot = std::move(pendingSnapshot);
+        hasPendingSnapshot = false;
+        lock.unlock();
+
+        std::string error;
+        bool ok = false;
+        try {
+            ok = WriteSnapshot(snapshot, error);
+        }
+        catch (const std::exception& e) {
+            error = e.what();
+        }
+
+        lock.lock();
+        // 書き込み中に新しい保存要求が来ていれば、状態は「保存中」のままにしておく
+        if (!hasPendingSnapshot) {
+            saveStatus.state = ok ? SaveState::Saved : SaveState::Failed;
+            saveStatus.message = ok ? "Saved" : error;
+            saveStatus.finishedAt = std::time(nullptr);
+        }
+        if (!ok) {
+            LOG_ERROR(LogCategory::Config, "Error saving config: " << error);
+        }
+    }
+}
+
+bool ConfigManager::WriteSnapshot(const json& j, std::string& outError) {
+    const std::string& filepath = CONFIG_FILEPATH;
+
+    std::string source = j.dump(4);
+    if (!WriteFileAtomic(filepath, source, outError, true)) {
+        return false;
+    }
+    LOG_INFO(LogCategory::Config, "Config saved successfully to: " << filepath);
+
+    // 起動を速くするためのバイナリ版も同時に書き出す（失敗しても JSON は保存済み）
+    SaveBinary(j, source);
+    return true;
+}
+
+bool ConfigManager::WriteFileAtomic(const std::string& path, const std::string& data, std::string& outError, bool keepBackups) {
+    const std::string tempPath = path + ".tmp";
+
+    FILE* fp = std::fopen(tempPath.c_str(), "wb");
+    if (!fp) {
+        outError = "Could not open file for writing: " + tempPath + " (Directory must exist)";
+        return false;
+    }
+
+    bool written = std::fwrite(data.data(), 1, data.size(), fp) == data.size();
+    written = written && std::fflush(fp) == 0;
+
+    // OS のキャッシュではなくディスクまで書き込まれたことを確認してから置き換える
+#ifdef _WIN32
+    written = written && _commit(_fileno(fp)) == 0;
+#else
+    written = written && fsync(fileno(fp)) == 0;
+#endif
+    written = (std::fclose(fp) == 0) && written;
+
+    if (!written) {
+        std::remove(tempPath.c_str());
+        outError = "Failed to write: " + tempPath;
+        return false;
+    }
+
+    // 書き込みに失敗した時にバックアップの世代を減らさないよう、置き換える直前にずらす
+    if (keepBackups) {
+        RotateBackups(path);
+    }
+
+    // 同じディレクトリ内のリネームで置き換える（元のファイルは常に完全な状態のまま残る）
+#ifdef _WIN32
+    if (!MoveFileExA(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+        std::remove(tempPath.c_str());
+        outError = "Failed to replace: " + path;
+        return false;
+    }
+#else
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::remove(tempPath.c_str());
+        outError = "Failed to replace: " + path;
         return false;
     }
+
+    // リネーム自体もディスクに残るようにディレクトリを同期する
+    std::string dir = fs::path(path).parent_path().string();
+    int dirFd = open(dir.empty() ? "." : dir.c_str(), O_RDONLY);
+    if (dirFd >= 0) {
+        fsync(dirFd);
+        close(dirFd);
+    }
+#endif
+    return true;
+}
+
+void ConfigManager::RotateBackups(const std::string& path) {
+    std::error_code ec;
+    if (!fs::exists(path, ec)) return;
+
+    // 古い世代から順にずらす（bak2 → bak3, bak1 → bak2）
+    for (int i = BACKUP_COUNT - 1; i >= 1; --i) {
+        std::string from = path + ".bak" + std::to_string(i);
+        std::string to = path + ".bak" + std::to_string(i + 1);
+        if (fs::exists(from, ec)) {
+            fs::rename(from, to, ec);
+        }
+    }
+
+    // 現在のファイルはコピーで残す（置き換えが終わるまで正本は消さない）
+    fs::copy_file(path, path + ".bak1", fs::copy_options::overwrite_existing, ec);
 }
 
 // 設定をファイルからロードする
 bool ConfigManager::Load(GameParams& params) {
-    const std::string& filepath = CONFIG_FILEPATH;
+    std::string source;
+    bool hasSource = ReadWholeFile(CONFIG_FILEPATH, source);
+
+    // 今の JSON から作られたバイナリがあればそちらを使う（JSON が無い場合はバイナリだけでも使う）
+    if (LoadBinary(params, hasSource ? &source : nullptr)) {
+        return true;
+    }
 
-    std::ifstream file(filepath);
-    if (!file.is_open()) {
-        std::cerr << "Warning: Config file not found, using default parameters: " << filepath << std::endl;
+    if (!hasSource) {
+        LOG_WARN(LogCategory::Config, "Config file not found, using default parameters: " << CONFIG_FILEPATH);
+        return false;
+    }
+    if (!LoadJson(params, source)) {
         return false;
     }
 
+    // JSON が直接編集された場合などは、次回の起動のためにバイナリを作り直しておく
     try {
         json j;
-        file >> j;
+        to_json(j, params);
+        SaveBinary(j, source);
+    }
+    catch (const std::exception& e) {
+        LOG_WARN(LogCategory::Config, "Could not compile binary config: " << e.what());
+    }
+    return true;
+}
+
+bool ConfigManager::LoadJson(GameParams& params, const std::string& source) {
+    const std::string& filepath = CONFIG_FILEPATH;
+
+    try {
+        json j = json::parse(source);
         from_json(j, params);
-        std::cout << "Config loaded successfully from: " << filepath << std::endl;
+        LOG_INFO(LogCategory::Config, "Config loaded successfully from: " << filepath);
         return true;
     }
     catch (const json::exception& e) {
-        std::cerr << "Error: JSON parsing failed while loading config: " << e.what() << std::endl;
+        LOG_ERROR(LogCategory::Config, "JSON parsing failed while loading config: " << e.what());
+        return false;
+    }
+    catch (const std::exception& e) {
+        LOG_ERROR(LogCategory::Config, "Error loading config: " << e.what());
+        return false;
+    }
+}
+
+bool ConfigManager::LoadBinary(GameParams& params, const std::string* source) {
+    const std::string& filepath = CONFIG_BINARY_FILEPATH;
+
+    std::vector<std::uint8_t> data;
+    if (!ReadWholeFile(filepath, data)) return false;
+
+    // ヘッダの検証（形式やバージョンが違う場合は JSON にフォールバックする）
+    if (data.size() < BINARY_HEADER_SIZE || std::memcmp(data.data(), BINARY_MAGIC, 4) != 0) {
+        LOG_WARN(LogCategory::Config, "Binary config has an invalid header, falling back to JSON: " << filepath);
+        return false;
+    }
+    std::uint32_t version = ReadU32(data.data() + 4);
+    if (version != BINARY_VERSION) {
+        LOG_WARN(LogCategory::Config, "Binary config version " << version << " is not supported (expected "
+            << BINARY_VERSION << "), falling back to JSON.");
+        return false;
+    }
+    std::uint32_t sourceSize = ReadU32(data.data() + 8);
+    std::uint32_t sourceHash = ReadU32(data.data() + 12);
+    std::uint32_t payloadSize = ReadU32(data.data() + 16);
+    if (payloadSize != data.size() - BINARY_HEADER_SIZE) {
+        LOG_WARN(LogCategory::Config, "Binary config is truncated, falling back to JSON: " << filepath);
         return false;
     }
+
+    // JSON が編集されていれば（内容が記録と違えば）古いバイナリとして使わない
+    if (source && (sourceSize != (std::uint32_t)source->size() || sourceHash != HashSource(*source))) {
+        LOG_INFO(LogCategory::Config, "Binary config is older than " << CONFIG_FILEPATH << ", loading JSON.");
+        return false;
+    }
+
+    // 解析に失敗した場合は GameParams に触れずに JSON へフォールバックする
+    // （from_json は全項目を一時変数に読み込んでから反映するので、途中で失敗しても params は変わらない）
+    try {
+        json j = json::from_msgpack(data.begin() + BINARY_HEADER_SIZE, data.end());
+        from_json(j, params);
+        LOG_INFO(LogCategory::Config, "Config loaded successfully from: " << filepath);
+        return true;
+    }
     catch (const std::exception& e) {
-        std::cerr << "Error loading config: " << e.what() << std::endl;
+        LOG_WARN(LogCategory::Config, "Binary config could not be read, falling back to JSON: " << e.what());
         return false;
     }
-}
\ No newline at end of file
+}
+
+bool ConfigManager::SaveBinary(const json& j, const std::string& source) {
+    const std::string& filepath = CONFIG_BINARY_FILEPATH;
+
+    std::vector<std::uint8_t> payload = json::to_msgpack(j);
+
+    std::vector<std::uint8_t> data;
+    data.reserve(BINARY_HEADER_SIZE + payload.size());
+    data.insert(data.end(), BINARY_MAGIC, BINARY_MAGIC + 4);
+    WriteU32(data, BINARY_VERSION);
+    WriteU32(data, (std::uint32_t)source.size());
+    WriteU32(data, HashSource(source));
+    WriteU32(data, (std::uint32_t)payload.size());
+    data.insert(data.end(), payload.begin(), payload.end());
+
+    std::string error;
+    if (!WriteFileAtomic(filepath, std::string(data.begin(), data.end()), error)) {
+        LOG_WARN(LogCategory::Config, "Could not write binary config: " << error);
+        return false;
+    }
+    return true;
+}
+
+void ConfigManager::BenchmarkLoad(int iterations) {
+    if (iterations <= 0) iterations = 1;
+
+    // ファイルの読み込み時間を除いた、解析と GameParams への変換だけを比較する
+    std::vector<std::uint8_t> jsonData;
+    if (!ReadWholeFile(CONFIG_FILEPATH, jsonData)) {
+        std::cerr << "Benchmark: " << CONFIG_FILEPATH << " not found." << std::endl;
+        return;
+    }
+
+    std::vector<std::uint8_t> binaryData;
+    try {
+        json source = json::parse(jsonData.begin(), jsonData.end());
+        binaryData = json::to_msgpack(source);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Benchmark: could not parse config: " << e.what() << std::endl;
+        return;
+    }
+
+    using Clock = std::chrono::steady_clock;
+    GameParams& params = GameParams::GetInstance();
+
+    auto start = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        from_json(json::parse(jsonData.begin(), jsonData.end()), params);
+    }
+    double jsonMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / iterations;
+
+    start = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        from_json(json::from_msgpack(binaryData.begin(), binaryData.end()), params);
+    }
+    double binaryMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / iterations;
+
+    std::cout << "[Config Load] iterations: " << iterations << std::endl;
+    std::cout << "  JSON    : " << jsonData.size() << " bytes, " << jsonMs << " ms/load" << std::endl;
+    std::cout << "  Binary  : " << (binaryData.size() + BINARY_HEADER_SIZE) << " bytes, " << binaryMs << " ms/load" << std::endl;
+    if (binaryMs > 0.0) {
+        std::cout << "  Speedup : x" << (jsonMs / binaryMs) << std::endl;
+    }
+}
@@ -1,16 +1,92 @@
 ﻿#pragma once
 #include <string>
+#include <ctime>
 #include "GameParams.h"
 #include <nlohmann/json.hpp> 
 
+/**
+ * @brief 設定ファイル（config.json）の保存と読み込み
+ * 保存時には JSON と同じ内容を MessagePack でコンパイルしたバイナリ（config.mdc）も書き出し、
+ * 起動時はバイナリのヘッダに記録した元の JSON のサイズとハッシュが今の JSON と一致すればそちらを優先して読み込みます。
+ * JSON は手で編集するための正本として残り、バイナリが壊れている・古い場合は JSON にフォールバックします。
+ *
+ * 書き込みは一時ファイルに書いて fsync した後にリネームで置き換えるため、途中でクラッシュしても
+ * 元のファイルが壊れることはありません。直前の数世代は .bak として残します。
+ */
 class ConfigManager {
 public:
+    // 非同期保存の状態（Launcher パネルの表示用）
+    enum class SaveState {
+        Idle,
+        Saving,
+        Saved,
+        Failed
+    };
+
+    struct SaveStatus {
+        SaveState state = SaveState::Idle;
+        std::string message;
+        std::time_t finishedAt = 0;
+    };
+
+    // 同期保存（呼び出したスレッドで書き込みまで行う）
     static bool Save(const GameParams& params);
 
+    /**
+     * @brief 現在の設定のスナップショットを取り、書き込みはバックグラウンドで行う
+     * 保存中に再度呼ばれた場合は最新のスナップショットだけを書き込みます。
+     * @return 保存するスナップショット（ホットリロードの比較基準として使える）
+     */
+    static json SaveAsync(const GameParams& params);
+
+    static SaveStatus GetSaveStatus();
+
+    /**
+     * @brief 保存待ちのスナップショットを書き終えてから保存スレッドを止める（終了時に呼ぶ）
+     */
+    static void Shutdown();
+
     static bool Load(GameParams& params);
 
+    /**
+     * @brief JSON とバイナリの読み込み時間を計測して表示する（--bench 用）
+     */
+    static void BenchmarkLoad(int iterations);
+
+    static const std::string& GetConfigPath() { return CONFIG_FILEPATH; }
+
 private:
     ConfigManager() = delete;
 
+    // バイナリ形式のヘッダ（先頭4バイトのマジックと、互換性のないレイアウト変更時に上げるバージョン）
+    static constexpr char BINARY_MAGIC[4] = { 'M', 'D', 'C', 'F' };
+    static constexpr unsigned int BINARY_VERSION = 2;
+
+    static bool LoadJson(GameParams& params, const std::string& source);
+
+    /**
+     * @brief バイナリを読み込む
+     * @param source 今の JSON の内容（nullptr なら JSON が無いものとして、元の内容を確かめずに使う）
+     * @return 読み込めなかった・source から作られたものではない場合は false（params は変更しない）
+     */
+    static bool LoadBinary(GameParams& params, const std::string* source);
+
+    // source はバイナリの元になった JSON の内容（ヘッダにサイズとハッシュを記録する）
+    static bool SaveBinary(const json& j, const std::string& source);
+
+    // JSON とバイナリの両方を書き出す（同期・非同期保存で共通）
+    static bool WriteSnapshot(const json& j, std::string& outError);
+
+    // 一時ファイル → fsync → リネームの順で安全に書き込む（keepBackups ならリネームの直前にバックアップをずらす）
+    static bool WriteFileAtomic(const std::string& path, const std::string& data, std::string& outError, bool keepBackups = false);
+
+    // config.json.bak1 〜 bakN を1世代ずつずらし、現在のファイルを bak1 にコピーする
+    static void RotateBackups(const std::string& path);
+
+    static void SaveWorker();
+
+    static constexpr int BACKUP_COUNT = 3;
+
     static const std::string CONFIG_FILEPATH;
+    static const std::string CONFIG_BINARY_FILEPATH;
 };
\ No newline at end of file
@@ -0,0 +1,17 @@
+﻿#include "ContactCache.h"
+
+Contact& ContactCache::Touch(unsigned int aId, unsigned int bId, bool& created) {
+    std::uint64_t key = ((std::uint64_t)aId << 32) | bId;
+    auto result = contacts.try_emplace(key);
+    created = result.second;
+    Contact& contact = result.first->second;
+    contact.lastFrame = frame;
+    return contact;
+}
+
+void ContactCache::EndFrame() {
+    for (auto it = contacts.begin(); it != contacts.end();) {
+        if (it->second.lastFrame != frame) it = contacts.erase(it);
+        else ++it;
+    }
+}
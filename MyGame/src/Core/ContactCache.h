@@ -0,0 +1,49 @@
+﻿#pragma once
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+// 接触の向き（押し戻す側 a から見た相手の位置）
+enum class ContactNormal : std::uint8_t {
+    None,      // まだ決まっていない
+    Ground,    // 相手の上に乗っている（a を上へ押し戻す）
+    Ceiling,   // 相手に下からぶつかっている（a を下へ押し戻す）
+    Left,      // 相手の左側にいる（a を左へ押し戻す）
+    Right,     // 相手の右側にいる（a を右へ押し戻す）
+};
+
+// 重なり続けている2つのオブジェクトの接触の情報
+struct Contact {
+    bool solid = false;                        // 押し戻しを行う組か（最初に触れた時に一度だけ判定する）
+    ContactNormal normal = ContactNormal::None;
+    unsigned int lastFrame = 0;                // 最後に重なっていたフレーム
+};
+
+/**
+ * @brief オブジェクトの組（id の組）ごとの接触をフレームをまたいで保持する
+ * 前のフレームの押し戻しの向きを引き継ぐことで、床の上で止まっているものは毎フレーム同じ向きに押し戻され、
+ * 並んだブロックの継ぎ目で横に押し戻されて引っかかることがなくなります。
+ * 重ならなくなった組は EndFrame で捨てます。
+ */
+class ContactCache {
+public:
+    // 当たり判定を始める前に呼ぶ
+    void BeginFrame() { ++frame; }
+
+    /**
+     * @brief a から見た b との接触を取得する（このフレームに重なっていた印も付ける）
+     * @param created 初めて重なった組なら true（呼び出し側で solid を決める）
+     */
+    Contact& Touch(unsigned int aId, unsigned int bId, bool& created);
+
+    // このフレームに重ならなかった組を捨てる
+    void EndFrame();
+
+    void Clear() { contacts.clear(); }
+
+    size_t Size() const { return contacts.size(); }
+
+private:
+    std::unordered_map<std::uint64_t, Contact> contacts;
+    unsigned int frame = 0;
+};
@@ -0,0 +1,272 @@
+﻿#include "DrawList.h"
+#include "RenderThread.h"
+#include "../UI/TextRenderer.h"
+#include "imgui.h"
+#include "imgui_impl_sdlrenderer2.h"
+
+DrawList::~DrawList() {
+    for (ImDrawList* list : imguiLists) {
+        IM_DELETE(list);
+    }
+    if (imguiDrawData) IM_DELETE(imguiDrawData);
+}
+
+void DrawList::Begin(int outputWidth, int outputHeight) {
+    commands.clear();
+    vertices.clear();
+    indices.clear();
+    points.clear();
+    textCount = 0;
+    this->outputWidth = outputWidth;
+    this->outputHeight = outputHeight;
+    blendMode = SDL_BLENDMODE_NONE;
+    target = nullptr;
+}
+
+DrawList::Command& DrawList::Push(CommandType type) {
+    commands.emplace_back();
+    Command& command = commands.back();
+    command.type = type;
+    return command;
+}
+
+void DrawList::SetDrawColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
+    Push(CommandType::SetDrawColor).color = { r, g, b, a };
+}
+
+void DrawList::SetDrawBlendMode(SDL_BlendMode mode) {
+    blendMode = mode;
+    Push(CommandType::SetDrawBlendMode).blendMode = mode;
+}
+
+void DrawList::Clear() {
+    Push(CommandType::Clear);
+}
+
+void DrawList::FillRect(const SDL_Rect& rect) {
+    Push(CommandType::FillRect).dest = rect;
+}
+
+void DrawList::DrawRect(const SDL_Rect& rect) {
+    Push(CommandType::DrawRect).dest = rect;
+}
+
+void DrawList::DrawLine(int x1, int y1, int x2, int y2) {
+    Push(CommandType::DrawLine).dest = { x1, y1, x2, y2 };
+}
+
+void DrawList::DrawLinesF(const SDL_FPoint* linePoints, int count) {
+    if (!linePoints || count <= 0) return;
+    Command& command = Push(CommandType::DrawLinesF);
+    command.first = (int)points.size();
+    command.count = count;
+    points.insert(points.end(), linePoints, linePoints + count);
+}
+
+void DrawList::Copy(SDL_Texture* texture, const SDL_Rect* srcRect, const SDL_Rect* destRect) {
+    if (!texture) return;
+    Command& command = Push(CommandType::Copy);
+    command.texture = texture;
+    if (srcRect) { command.src = *srcRect; command.hasSrc = true; }
+    if (destRect) { command.dest = *destRect; command.hasDest = true; }
+}
+
+void DrawList::CopyEx(SDL_Texture* texture, const SDL_Rect* srcRect, const SDL_Rect* destRect, double angle, SDL_RendererFlip flip) {
+    if (!texture) return;
+    Command& command = Push(CommandType::CopyEx);
+    command.texture = texture;
+    if (srcRect) { command.src = *srcRect; command.hasSrc = true; }
+    if (destRect) { command.dest = *destRect; command.hasDest = true; }
+    command.angle = angle;
+    command.flip = flip;
+}
+
+void DrawList::SetTextureColorMod(SDL_Texture* texture, Uint8 r, Uint8 g, Uint8 b) {
+    if (!texture) return;
+    Command& command = Push(CommandType::SetTextureColorMod);
+    command.texture = texture;
+    command.color = { r, g, b, 255 };
+}
+
+void DrawList::SetTextureAlphaMod(SDL_Texture* texture, Uint8 alpha) {
+    if (!texture) return;
+    Command& command = Push(CommandType::SetTextureAlphaMod);
+    command.texture = texture;
+    command.color = { 255, 255, 255, alpha };
+}
+
+void DrawList::Geometry(const SDL_Vertex* geometryVertices, int vertexCount, const int* geometryIndices, int indexCount) {
+    if (!geometryVertices || vertexCount <= 0) return;
+    Command& command = Push(CommandType::Geometry);
+    command.first = (int)vertices.size();
+    command.count = vertexCount;
+    vertices.insert(vertices.end(), geometryVertices, geometryVertices + vertexCount);
+    if (geometryIndices && indexCount > 0) {
+        command.indexFirst = (int)indices.size();
+        command.indexCount = indexCount;
+        indices.insert(indices.end(), geometryIndices, geometryIndices + indexCount);
+    }
+}
+
+void DrawList::SetTarget(SDL_Texture* newTarget) {
+    target = newTarget;
+    Push(CommandType::SetTarget).texture = newTarget;
+}
+
+int DrawList::PushText(const std::string& text) {
+    // 文字列の領域はフレームをまたいで使い回す
+    if (textCount < texts.size()) texts[textCount] = text;
+    else texts.push_back(text);
+    return (int)textCount++;
+}
+
+void DrawList::Text(const std::string& text, int x, int y, SDL_Color color) {
+    if (text.empty()) return;
+    int first = PushText(text);
+    Command& command = Push(CommandType::Text);
+    command.first = first;
+    command.dest = { x, y, 0, 0 };
+    command.color = color;
+}
+
+void DrawList::UpdateText(TextTexture& cache, const std::string& text, SDL_Color color) {
+    int first = PushText(text);
+    Command& command = Push(CommandType::UpdateText);
+    command.textTexture = &cache;
+    command.first = first;
+    command.color = color;
+}
+
+void DrawList::DrawCachedText(TextTexture& cache, int x, int y) {
+    Command& command = Push(CommandType::DrawCachedText);
+    command.textTexture = &cache;
+    command.dest = { x, y, 0, 0 };
+}
+
+void DrawList::SubmitImGui(const ImDrawData* drawData) {
+    if (!drawData || !drawData->Valid) return;
+
+    // フォントなどのテクスチャの作成・更新は描画スレッドで済ませる（その間このスレッドは待つので ImTextureData は書き換わらない）
+    if (ImVector<ImTextureData*>* textures = drawData->Textures) {
+        bool pending = false;
+        for (ImTextureData* tex : *textures) {
+            if (tex->Status != ImTextureStatus_OK) {
+                pending = true;
+                break;
+            }
+        }
+        if (pending) {
+            RenderThread::Invoke([textures]() {
+                for (ImTextureData* tex : *textures) {
+                    if (tex->Status != ImTextureStatus_OK) ImGui_ImplSDLRenderer2_UpdateTexture(tex);
+                }
+            });
+        }
+    }
+
+    // 次の NewFrame で ImGui 側の ImDrawList は作り直されるため、中身を複製して持つ
+    int listCount = drawData->CmdLists.Size;
+    while ((int)imguiLists.size() < listCount) {
+        imguiLists.push_back(IM_NEW(ImDrawList)(nullptr));
+    }
+    if (!imguiDrawData) imguiDrawData = IM_NEW(ImDrawData)();
+
+    // テクスチャの更新は上で済ませたので Textures は nullptr のままにする
+    imguiDrawData->Clear();
+    imguiDrawData->Valid = true;
+    imguiDrawData->DisplayPos = drawData->DisplayPos;
+    imguiDrawData->DisplaySize = drawData->DisplaySize;
+    imguiDrawData->FramebufferScale = drawData->FramebufferScale;
+    imguiDrawData->TotalIdxCount = drawData->TotalIdxCount;
+    imguiDrawData->TotalVtxCount = drawData->TotalVtxCount;
+    imguiDrawData->CmdListsCount = listCount;
+
+    for (int i = 0; i < listCount; ++i) {
+        const ImDrawList* src = drawData->CmdLists[i];
+        ImDrawList* dst = imguiLists[i];
+        dst->CmdBuffer = src->CmdBuffer;
+        dst->IdxBuffer = src->IdxBuffer;
+        dst->VtxBuffer = src->VtxBuffer;
+        dst->Flags = src->Flags;
+
+        // 描画スレッドが ImTextureData を読まないよう、テクスチャの参照をこの時点の ID に置き換える
+        for (ImDrawCmd& cmd : dst->CmdBuffer) {
+            if (!cmd.UserCallback) cmd.TexRef = ImTextureRef(cmd.GetTexID());
+        }
+        imguiDrawData->CmdLists.push_back(dst);
+    }
+
+    Push(CommandType::ImGui);
+}
+
+void DrawList::Execute(SDL_Renderer* renderer) const {
+    if (!renderer) return;
+
+    // 記録は既定の状態から始まるため、前のフレームで変わった状態を戻しておく
+    SDL_SetRenderTarget(renderer, nullptr);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+
+    for (const Command& command : commands) {
+        const SDL_Rect* src = command.hasSrc ? &command.src : nullptr;
+        const SDL_Rect* dest = command.hasDest ? &command.dest : nullptr;
+
+        switch (command.type) {
+        case CommandType::SetDrawColor:
+            SDL_SetRenderDrawColor(renderer, command.color.r, command.color.g, command.color.b, command.color.a);
+            break;
+        case CommandType::SetDrawBlendMode:
+            SDL_SetRenderDrawBlendMode(renderer, command.blendMode);
+            break;
+        case CommandType::Clear:
+            SDL_RenderClear(renderer);
+            break;
+        case CommandType::FillRect:
+            SDL_RenderFillRect(renderer, &command.dest);
+            break;
+        case CommandType::DrawRect:
+            SDL_RenderDrawRect(renderer, &command.dest);
+            break;
+        case CommandType::DrawLine:
+            SDL_RenderDrawLine(renderer, command.dest.x, command.dest.y, command.dest.w, command.dest.h);
+            break;
+        case CommandType::DrawLinesF:
+            SDL_RenderDrawLinesF(renderer, &points[command.first], command.count);
+            break;
+        case CommandType::Copy:
+            SDL_RenderCopy(renderer, command.texture, src, dest);
+            break;
+        case CommandType::CopyEx:
+            SDL_RenderCopyEx(renderer, command.texture, src, dest, command.angle, nullptr, command.flip);
+            break;
+        case CommandType::SetTextureColorMod:
+            SDL_SetTextureColorMod(command.texture, command.color.r, command.color.g, command.color.b);
+            break;
+        case CommandType::SetTextureAlphaMod:
+            SDL_SetTextureAlphaMod(command.texture, command.color.a);
+            break;
+        case CommandType::Geometry:
+            SDL_RenderGeometry(renderer, nullptr, &vertices[command.first], command.count,
+                command.indexCount > 0 ? &indices[command.indexFirst] : nullptr, command.indexCount);
+            break;
+        case CommandType::SetTarget:
+            SDL_SetRenderTarget(renderer, command.texture);
+            break;
+        case CommandType::Text:
+            TextRenderer::Draw(renderer, texts[command.first], command.dest.x, command.dest.y, command.color);
+            break;
+        case CommandType::UpdateText:
+            TextRenderer::Rasterize(renderer, texts[command.first], command.color, *command.textTexture);
+            break;
+        case CommandType::DrawCachedText: {
+            const TextTexture& cache = *command.textTexture;
+            if (!cache.texture) break;
+            SDL_Rect rect = { command.dest.x, command.dest.y, cache.width, cache.height };
+            SDL_RenderCopy(renderer, cache.texture, nullptr, &rect);
+            break;
+        }
+        case CommandType::ImGui:
+            ImGui_ImplSDLRenderer2_RenderDrawData(imguiDrawData, renderer);
+            break;
+        }
+    }
+}
@@ -0,0 +1,125 @@
+﻿#pragma once
+#include <SDL.h>
+#include <string>
+#include <vector>
+
+struct ImDrawData;
+struct ImDrawList;
+struct TextTexture;
+
+/**
+ * @brief 1フレーム分の描画命令を記録したリスト
+ * シミュレーション側（メインスレッド）はレンダラーに直接描かず、SDL の描画関数と同じ形の命令をここに積みます。
+ * 記録が終わったリストは RenderThread に渡され、描画スレッドが Execute で SDL_Renderer に流します。
+ * 頂点・文字列・ImGui の描画データは記録時に複製するため、渡した後に元のデータを書き換えても構いません。
+ * テクスチャはポインタだけを記録するので、破棄は RenderThread::DestroyTexture で描画後まで遅らせてください。
+ */
+class DrawList {
+public:
+    DrawList() = default;
+    ~DrawList();
+    DrawList(const DrawList&) = delete;
+    DrawList& operator=(const DrawList&) = delete;
+
+    // 記録をやり直す（確保済みの領域は使い回す）。出力先の大きさは記録中の問い合わせに使う
+    void Begin(int outputWidth, int outputHeight);
+
+    int GetOutputWidth() const { return outputWidth; }
+    int GetOutputHeight() const { return outputHeight; }
+
+    // --- SDL_Render* と同じ意味の命令 ---
+    void SetDrawColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+    void SetDrawBlendMode(SDL_BlendMode mode);
+    void Clear();
+    void FillRect(const SDL_Rect& rect);
+    void DrawRect(const SDL_Rect& rect);
+    void DrawLine(int x1, int y1, int x2, int y2);
+    void DrawLinesF(const SDL_FPoint* points, int count);
+    void Copy(SDL_Texture* texture, const SDL_Rect* srcRect, const SDL_Rect* destRect);
+    void CopyEx(SDL_Texture* texture, const SDL_Rect* srcRect, const SDL_Rect* destRect, double angle, SDL_RendererFlip flip);
+    void SetTextureColorMod(SDL_Texture* texture, Uint8 r, Uint8 g, Uint8 b);
+    void SetTextureAlphaMod(SDL_Texture* texture, Uint8 alpha);
+    void Geometry(const SDL_Vertex* vertices, int vertexCount, const int* indices, int indexCount);
+    // nullptr で画面に戻す
+    void SetTarget(SDL_Texture* target);
+
+    // 文字列を描く（描画スレッドで TextRenderer::Draw を呼ぶ）
+    void Text(const std::string& text, int x, int y, SDL_Color color);
+
+    // 描画スレッドで text を cache にラスタライズし直す（cache は描画スレッドが破棄するまで生かしておく）
+    void UpdateText(TextTexture& cache, const std::string& text, SDL_Color color);
+    // cache に描いておいた文字列をそのまま貼る
+    void DrawCachedText(TextTexture& cache, int x, int y);
+
+    // ImGui::Render() の結果を複製して積む（テクスチャの更新は描画スレッドで先に済ませる）
+    void SubmitImGui(const ImDrawData* drawData);
+
+    // 記録中の状態（SDL_GetRender* の代わり）
+    SDL_BlendMode GetDrawBlendMode() const { return blendMode; }
+    SDL_Texture* GetTarget() const { return target; }
+
+    size_t GetCommandCount() const { return commands.size(); }
+
+    // 記録した命令を順に実行する（描画スレッドから呼ぶ）
+    void Execute(SDL_Renderer* renderer) const;
+
+private:
+    enum class CommandType : Uint8 {
+        SetDrawColor,
+        SetDrawBlendMode,
+        Clear,
+        FillRect,
+        DrawRect,
+        DrawLine,
+        DrawLinesF,
+        Copy,
+        CopyEx,
+        SetTextureColorMod,
+        SetTextureAlphaMod,
+        Geometry,
+        SetTarget,
+        Text,
+        UpdateText,
+        DrawCachedText,
+        ImGui,
+    };
+
+    struct Command {
+        CommandType type;
+        bool hasSrc = false;
+        bool hasDest = false;
+        SDL_RendererFlip flip = SDL_FLIP_NONE;
+        SDL_BlendMode blendMode = SDL_BLENDMODE_NONE;
+        SDL_Color color = { 0, 0, 0, 0 };
+        SDL_Texture* texture = nullptr;
+        TextTexture* textTexture = nullptr;
+        SDL_Rect src = { 0, 0, 0, 0 };
+        SDL_Rect dest = { 0, 0, 0, 0 };   // DrawLine では x, y, w, h に始点と終点を入れる
+        double angle = 0.0;
+        int first = 0;        // 頂点・点・文字列の先頭
+        int count = 0;
+        int indexFirst = 0;
+        int indexCount = 0;
+    };
+
+    Command& Push(CommandType type);
+    // 文字列を texts に複製して位置を返す
+    int PushText(const std::string& text);
+
+    std::vector<Command> commands;
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+    std::vector<SDL_FPoint> points;
+    std::vector<std::string> texts;
+    size_t textCount = 0;
+
+    // ImGui の描画データの複製（ImDrawList は使い回す）。ImGui のメモリ確保はコンテキストの
+    // 統計を書き換えるため、確保はすべて記録側で行い、描画スレッドは読むだけにする
+    std::vector<ImDrawList*> imguiLists;
+    ImDrawData* imguiDrawData = nullptr;
+
+    int outputWidth = 0;
+    int outputHeight = 0;
+    SDL_BlendMode blendMode = SDL_BLENDMODE_NONE;
+    SDL_Texture* target = nullptr;
+};
@@ -0,0 +1,55 @@
+﻿#include "ECS.h"
+
+Entity Registry::Create() {
+    std::uint32_t index;
+    if (!freeIndices.empty()) {
+        index = freeIndices.back();
+        freeIndices.pop_back();
+    }
+    else {
+        index = (std::uint32_t)versions.size();
+        assert(index <= EntityBits::INDEX_MASK);
+        versions.push_back(0);
+        alive.push_back(false);
+    }
+    alive[index] = true;
+    ++aliveCount;
+    return EntityBits::Make(index, versions[index]);
+}
+
+void Registry::Destroy(Entity entity) {
+    if (!IsAlive(entity)) return;
+
+    for (auto& pool : pools) {
+        if (pool) pool->Remove(entity);
+    }
+
+    std::uint32_t index = EntityBits::Index(entity);
+    alive[index] = false;
+    // 世代を進めて、この番号を持つ古い Entity を無効にする
+    versions[index] = (versions[index] + 1) & EntityBits::VERSION_MASK;
+    freeIndices.push_back(index);
+    --aliveCount;
+}
+
+bool Registry::IsAlive(Entity entity) const {
+    if (entity == NullEntity) return false;
+    std::uint32_t index = EntityBits::Index(entity);
+    return index < versions.size() && alive[index] && versions[index] == EntityBits::Version(entity);
+}
+
+void Registry::Clear() {
+    for (auto& pool : pools) {
+        if (pool) pool->Clear();
+    }
+    // 世代は残したまま全位置を空きにする（古い Entity が誤って有効にならないように）
+    freeIndices.clear();
+    for (std::uint32_t index = (std::uint32_t)versions.size(); index-- > 0;) {
+        if (alive[index]) {
+            alive[index] = false;
+            versions[index] = (versions[index] + 1) & EntityBits::VERSION_MASK;
+        }
+        freeIndices.push_back(index);
+    }
+    aliveCount = 0;
+}
@@ -0,0 +1,198 @@
+﻿#pragma once
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cassert>
+#include <utility>
+
+/**
+ * @brief エンティティ（番号だけの存在）。下位20ビットが配列の位置、上位12ビットが再利用の世代
+ * 削除された番号が再利用されても、古い Entity は世代が合わないため無効として扱われます。
+ */
+using Entity = std::uint32_t;
+constexpr Entity NullEntity = 0xFFFFFFFFu;
+
+namespace EntityBits {
+    constexpr std::uint32_t INDEX_BITS = 20;
+    constexpr std::uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+    constexpr std::uint32_t VERSION_MASK = 0xFFFu;
+
+    inline std::uint32_t Index(Entity e) { return e & INDEX_MASK; }
+    inline std::uint32_t Version(Entity e) { return e >> INDEX_BITS; }
+    inline Entity Make(std::uint32_t index, std::uint32_t version) {
+        return (Entity)(((version & VERSION_MASK) << INDEX_BITS) | (index & INDEX_MASK));
+    }
+}
+
+/**
+ * @brief 型ごとの構成要素の格納庫（スパースセット）
+ * 構成要素は dense 配列に隙間なく並ぶため、システムは配列を先頭から順に読むだけで済みます。
+ * sparse はエンティティの位置から dense の位置を引く表で、追加・削除・検索はすべて O(1) です
+ * （削除は末尾の要素を空いた位置へ移して詰めるため、dense 内の順序は保たれません）。
+ */
+class ComponentPoolBase {
+public:
+    virtual ~ComponentPoolBase() = default;
+    virtual void Remove(Entity entity) = 0;
+    virtual void Clear() = 0;
+};
+
+template <typename T>
+class ComponentPool : public ComponentPoolBase {
+public:
+    static constexpr std::uint32_t NOT_FOUND = 0xFFFFFFFFu;
+
+    bool Has(Entity entity) const {
+        std::uint32_t index = EntityBits::Index(entity);
+        return index < sparse.size() && sparse[index] != NOT_FOUND && entities[sparse[index]] == entity;
+    }
+
+    // 追加（すでにあれば上書き）
+    T& Set(Entity entity, const T& value) {
+        std::uint32_t index = EntityBits::Index(entity);
+        if (index >= sparse.size()) sparse.resize(index + 1, NOT_FOUND);
+
+        if (sparse[index] != NOT_FOUND && entities[sparse[index]] == entity) {
+            T& existing = components[sparse[index]];
+            existing = value;
+            return existing;
+        }
+        sparse[index] = (std::uint32_t)components.size();
+        entities.push_back(entity);
+        components.push_back(value);
+        return components.back();
+    }
+
+    T* TryGet(Entity entity) {
+        return Has(entity) ? &components[sparse[EntityBits::Index(entity)]] : nullptr;
+    }
+    const T* TryGet(Entity entity) const {
+        return Has(entity) ? &components[sparse[EntityBits::Index(entity)]] : nullptr;
+    }
+
+    void Remove(Entity entity) override {
+        if (!Has(entity)) return;
+        std::uint32_t index = EntityBits::Index(entity);
+        std::uint32_t slot = sparse[index];
+        std::uint32_t last = (std::uint32_t)components.size() - 1;
+        if (slot != last) {
+            components[slot] = std::move(components[last]);
+            entities[slot] = entities[last];
+            sparse[EntityBits::Index(entities[slot])] = slot;
+        }
+        components.pop_back();
+        entities.pop_back();
+        sparse[index] = NOT_FOUND;
+    }
+
+    void Clear() override {
+        sparse.clear();
+        entities.clear();
+        components.clear();
+    }
+
+    size_t Size() const { return components.size(); }
+
+    // システムから直接走査するための配列（Entity と構成要素は同じ添字で対応する）
+    std::vector<Entity>& Entities() { return entities; }
+    std::vector<T>& Components() { return components; }
+
+private:
+    std::vector<std::uint32_t> sparse;
+    std::vector<Entity> entities;
+    std::vector<T> components;
+};
+
+/**
+ * @brief エンティティと構成要素の管理
+ * 構成要素の型ごとに ComponentPool を1つ持ち、Each<A, B>() で「A と B を両方持つエンティティ」を
+ * A の配列の順に走査します（数が少ない型を先頭に書くと速くなります）。
+ */
+class Registry {
+public:
+    Entity Create();
+    void Destroy(Entity entity);
+    bool IsAlive(Entity entity) const;
+
+    // すべてのエンティティと構成要素を消す（格納庫の型の登録は残る）
+    void Clear();
+
+    size_t GetAliveCount() const { return aliveCount; }
+
+    template <typename T>
+    T& Set(Entity entity, const T& value) {
+        assert(IsAlive(entity));
+        return Pool<T>().Set(entity, value);
+    }
+
+    template <typename T>
+    void Remove(Entity entity) { Pool<T>().Remove(entity); }
+
+    template <typename T>
+    bool Has(Entity entity) const {
+        const ComponentPool<T>* pool = FindPool<T>();
+        return pool && pool->Has(entity);
+    }
+
+    template <typename T>
+    T* TryGet(Entity entity) { return Pool<T>().TryGet(entity); }
+
+    template <typename T>
+    const T* TryGet(Entity entity) const {
+        const ComponentPool<T>* pool = FindPool<T>();
+        return pool ? pool->TryGet(entity) : nullptr;
+    }
+
+    template <typename T>
+    ComponentPool<T>& Pool() {
+        std::size_t typeId = TypeId<T>();
+        if (typeId >= pools.size()) pools.resize(typeId + 1);
+        if (!pools[typeId]) pools[typeId] = std::make_unique<ComponentPool<T>>();
+        return static_cast<ComponentPool<T>&>(*pools[typeId]);
+    }
+
+    /**
+     * @brief First と Rest... をすべて持つエンティティごとに f(entity, First&, Rest&...) を呼ぶ
+     * 走査中に構成要素を追加・削除しないでください。
+     */
+    template <typename First, typename... Rest, typename F>
+    void Each(F&& f) {
+        EachIn(f, Pool<First>(), Pool<Rest>()...);
+    }
+
+private:
+    template <typename First, typename... Rest, typename F>
+    static void EachIn(F& f, ComponentPool<First>& first, ComponentPool<Rest>&... rest) {
+        std::vector<Entity>& entities = first.Entities();
+        std::vector<First>& components = first.Components();
+        for (size_t i = 0; i < components.size(); ++i) {
+            Entity entity = entities[i];
+            if (!(rest.Has(entity) && ...)) continue;
+            f(entity, components[i], *rest.TryGet(entity)...);
+        }
+    }
+
+    template <typename T>
+    const ComponentPool<T>* FindPool() const {
+        std::size_t typeId = TypeId<T>();
+        if (typeId >= pools.size() || !pools[typeId]) return nullptr;
+        return static_cast<const ComponentPool<T>*>(pools[typeId].get());
+    }
+
+    static std::size_t NextTypeId() {
+        static std::size_t counter = 0;
+        return counter++;
+    }
+
+    template <typename T>
+    static std::size_t TypeId() {
+        static const std::size_t id = NextTypeId();
+        return id;
+    }
+
+    std::vector<std::unique_ptr<ComponentPoolBase>> pools;
+    std::vector<std::uint32_t> versions;    // 位置ごとの現在の世代
+    std::vector<std::uint32_t> freeIndices; // 再利用できる位置
+    std::vector<bool> alive;
+    size_t aliveCount = 0;
+};
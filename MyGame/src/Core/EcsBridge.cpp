@@ -0,0 +1,54 @@
+﻿#include "EcsBridge.h"
+#include "Components.h"
+#include "GameParams.h"
+#include "../Objects/GameObject.h"
+
+void EcsBridge::Link(Registry& registry, GameObject& obj) {
+    if (registry.IsAlive(obj.entity)) return;
+    obj.entity = registry.Create();
+    obj.WriteComponents(registry);
+}
+
+void EcsBridge::Unlink(Registry& registry, GameObject& obj) {
+    registry.Destroy(obj.entity);
+    obj.entity = NullEntity;
+}
+
+void EcsBridge::Push(Registry& registry, const std::vector<std::unique_ptr<GameObject>>& objects) {
+    for (const auto& obj : objects) {
+        if (obj->isDead || obj->entity == NullEntity) continue;
+        obj->WriteComponents(registry);
+    }
+}
+
+void EcsBridge::Pull(const Registry& registry, const std::vector<std::unique_ptr<GameObject>>& objects) {
+    for (const auto& obj : objects) {
+        if (obj->isDead || obj->entity == NullEntity) continue;
+        obj->ReadComponents(registry);
+    }
+}
+
+void MovementSystem::Update(Registry& registry, float deltaTime) {
+    // 設定はループの外で一度だけ読む
+    const GameParams& params = GameParams::GetInstance();
+    const float gravityStep = params.physics.gravity * PhysicsSettings::GravityScale * deltaTime;
+    const float terminalVelocity = params.physics.terminalVelocity;
+
+    registry.Each<Velocity, Transform>([=](Entity, Velocity& velocity, Transform& transform) {
+        // 止まっていて重力も受けないものは積分しない（Scene::Update の判定と同じ）
+        if (!velocity.useGravity && velocity.x == 0.0f && velocity.y == 0.0f) return;
+
+        if (velocity.useGravity) {
+            velocity.y += gravityStep;
+            if (velocity.y > terminalVelocity) velocity.y = terminalVelocity;
+            else if (velocity.y < -terminalVelocity) velocity.y = -terminalVelocity;
+        }
+
+        velocity.x += velocity.accX * deltaTime;
+        velocity.y += velocity.accY * deltaTime;
+        transform.x += velocity.x * deltaTime;
+        transform.y += velocity.y * deltaTime;
+        velocity.accX = 0.0f;
+        velocity.accY = 0.0f;
+    });
+}
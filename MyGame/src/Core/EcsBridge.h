@@ -0,0 +1,43 @@
+﻿#pragma once
+#include <vector>
+#include <memory>
+#include "ECS.h"
+
+class GameObject;
+
+/**
+ * @brief 既存の GameObject と ECS の Registry をつなぐ
+ * 種類ごとに UsesEcsMovement() を true にすると、その種類のオブジェクトはシーンに加わった時に
+ * エンティティと対応付けられ、移動の積分を MovementSystem が行うようになります。
+ * ゲームの処理（Update や衝突のコールバック）は GameObject のまま動くため、種類ごとに段階的に移行できます。
+ * 1フレームの流れは Push（GameObject → 構成要素）→ システム → Pull（構成要素 → GameObject）です。
+ */
+class EcsBridge {
+public:
+    // オブジェクトのエンティティを作って構成要素を書き出す（対応付け済みなら何もしない）
+    static void Link(Registry& registry, GameObject& obj);
+
+    // エンティティを消して対応を外す
+    static void Unlink(Registry& registry, GameObject& obj);
+
+    // 対応付け済みの生きているオブジェクトの状態を構成要素へ書き出す
+    static void Push(Registry& registry, const std::vector<std::unique_ptr<GameObject>>& objects);
+
+    // システムの結果を対応付け済みのオブジェクトへ書き戻す
+    static void Pull(const Registry& registry, const std::vector<std::unique_ptr<GameObject>>& objects);
+
+private:
+    EcsBridge() = delete;
+};
+
+/**
+ * @brief Transform と Velocity を持つエンティティの重力・加速度・速度を積分する
+ * Physics::ApplyPhysics と同じ計算を、構成要素の配列を順に読みながらまとめて行います。
+ */
+class MovementSystem {
+public:
+    static void Update(Registry& registry, float deltaTime);
+
+private:
+    MovementSystem() = delete;
+};
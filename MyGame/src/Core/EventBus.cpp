@@ -0,0 +1,31 @@
+﻿#include "EventBus.h"
+
+void EventBus::Unsubscribe(SubscriptionId id) {
+    if (id == 0) return;
+    for (ChannelBase* channel : channels) {
+        if (channel->Remove(id, dispatching)) {
+            if (dispatching) handlersChanged = true;
+            return;
+        }
+    }
+}
+
+void EventBus::Dispatch() {
+    dispatching = true;
+    // 購読者が新しい型を登録しても配列の再確保で走査が壊れないよう、添字で回す
+    for (size_t i = 0; i < channels.size(); ++i) {
+        channels[i]->Dispatch();
+    }
+    dispatching = false;
+
+    if (handlersChanged) {
+        for (ChannelBase* channel : channels) channel->FinishDispatch();
+        handlersChanged = false;
+    }
+}
+
+void EventBus::ClearPending() {
+    for (ChannelBase* channel : channels) {
+        channel->ClearPending();
+    }
+}
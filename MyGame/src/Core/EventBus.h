@@ -0,0 +1,167 @@
+﻿#pragma once
+#include <vector>
+#include <functional>
+#include <atomic>
+#include <utility>
+#include <algorithm>
+#include "LockFreeQueue.h"
+
+/**
+ * @brief ゲーム内のイベント（被弾・撃破・拠点への攻撃・ウェーブの進行など）を型ごとに配信する
+ * Publish() はイベントをその型のキューに積むだけで、購読者の呼び出しは Scene::Update の決まった位置で
+ * Dispatch() がまとめて行います（購読者ごとに、そのフレームのイベントを順に渡します）。
+ * 購読者がいない型のイベントはキューにも積まれないため、発行側の負担はほぼありません。
+ * Subscribe / Unsubscribe / Publish / Dispatch はゲームループのスレッドから呼んでください。
+ * 別スレッドからは PublishAsync() でロックフリーのキューに積めます（次の Dispatch で配信されます）。
+ */
+class EventBus {
+public:
+    using SubscriptionId = unsigned int;
+
+    // 型ごとに別スレッドから積めるイベント数の上限（1フレームあたり。超えた分は捨てる）
+    static constexpr size_t ASYNC_QUEUE_CAPACITY = 256;
+
+    static EventBus& GetInstance() {
+        static EventBus instance;
+        return instance;
+    }
+
+    /**
+     * @brief E 型のイベントを購読する
+     * @return 購読の解除に使う ID
+     */
+    template <typename E>
+    SubscriptionId Subscribe(std::function<void(const E&)> handler) {
+        Channel<E>& channel = GetChannel<E>();
+        if (!channel.registered) {
+            channels.push_back(&channel);
+            channel.registered = true;
+        }
+        SubscriptionId id = ++lastSubscriptionId;
+        // 配信中は呼び出し中の購読者の配列を動かさないよう、配信後に加える
+        (dispatching ? channel.addedHandlers : channel.handlers).push_back({ id, std::move(handler) });
+        if (dispatching) handlersChanged = true;
+        channel.subscriberCount.fetch_add(1, std::memory_order_relaxed);
+        return id;
+    }
+
+    // 配信中に呼ばれた場合は、その配信が終わってから取り除く（以降は呼ばれない）
+    void Unsubscribe(SubscriptionId id);
+
+    template <typename E>
+    void Publish(const E& event) {
+        Channel<E>& channel = GetChannel<E>();
+        if (channel.subscriberCount.load(std::memory_order_relaxed) == 0) return;
+        channel.pending.push_back(event);
+    }
+
+    /**
+     * @brief ゲームループ以外のスレッドからイベントを積む
+     * @return キューが満杯で捨てた場合は false
+     */
+    template <typename E>
+    bool PublishAsync(const E& event) {
+        Channel<E>& channel = GetChannel<E>();
+        if (channel.subscriberCount.load(std::memory_order_relaxed) == 0) return true;
+        return channel.asyncQueue.TryPush(event);
+    }
+
+    /**
+     * @brief 溜まったイベントを購読者へまとめて配信する
+     * 配信中に発行されたイベントは次の Dispatch で配信されます。
+     */
+    void Dispatch();
+
+    // 配信前のイベントを捨てる（シーン切り替え時など。購読は残る）
+    void ClearPending();
+
+private:
+    EventBus() = default;
+    EventBus(const EventBus&) = delete;
+    EventBus& operator=(const EventBus&) = delete;
+
+    struct ChannelBase {
+        virtual ~ChannelBase() = default;
+        virtual void Dispatch() = 0;
+        virtual void ClearPending() = 0;
+        virtual bool Remove(SubscriptionId id, bool deferred) = 0;
+        // 配信中に追加・解除された購読を反映する
+        virtual void FinishDispatch() = 0;
+        bool registered = false;
+    };
+
+    template <typename E>
+    struct Channel : ChannelBase {
+        struct Handler {
+            SubscriptionId id;
+            std::function<void(const E&)> callback;
+        };
+
+        std::vector<Handler> handlers;
+        std::vector<Handler> addedHandlers;
+        std::atomic<int> subscriberCount{ 0 };
+        std::vector<E> pending;   // ゲームループのスレッドで発行されたもの
+        std::vector<E> batch;     // 配信中のもの（配列は使い回す）
+        MPSCQueue<E, ASYNC_QUEUE_CAPACITY> asyncQueue;
+
+        void Dispatch() override {
+            E asyncEvent;
+            while (asyncQueue.TryPop(asyncEvent)) pending.push_back(asyncEvent);
+            if (pending.empty()) return;
+
+            batch.swap(pending);
+            for (Handler& handler : handlers) {
+                for (const E& event : batch) {
+                    if (handler.id == 0) break;  // 配信中に購読が解除された
+                    handler.callback(event);
+                }
+            }
+            batch.clear();
+        }
+
+        void ClearPending() override {
+            E asyncEvent;
+            while (asyncQueue.TryPop(asyncEvent)) {}
+            pending.clear();
+        }
+
+        bool Remove(SubscriptionId id, bool deferred) override {
+            for (size_t i = 0; i < addedHandlers.size(); ++i) {
+                if (addedHandlers[i].id != id) continue;
+                addedHandlers.erase(addedHandlers.begin() + i);
+                subscriberCount.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+            for (size_t i = 0; i < handlers.size(); ++i) {
+                if (handlers[i].id != id) continue;
+                if (deferred) {
+                    handlers[i].id = 0;
+                }
+                else {
+                    handlers.erase(handlers.begin() + i);
+                }
+                subscriberCount.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+            return false;
+        }
+
+        void FinishDispatch() override {
+            handlers.erase(std::remove_if(handlers.begin(), handlers.end(),
+                [](const Handler& handler) { return handler.id == 0; }), handlers.end());
+            for (Handler& handler : addedHandlers) handlers.push_back(std::move(handler));
+            addedHandlers.clear();
+        }
+    };
+
+    template <typename E>
+    static Channel<E>& GetChannel() {
+        static Channel<E> channel;
+        return channel;
+    }
+
+    std::vector<ChannelBase*> channels;
+    SubscriptionId lastSubscriptionId = 0;
+    bool dispatching = false;
+    bool handlersChanged = false;  // 配信中に購読の追加・解除があった
+};
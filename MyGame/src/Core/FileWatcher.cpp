@@ -0,0 +1,159 @@
+﻿#include "FileWatcher.h"
+#include "Logger.h"
+#include <chrono>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+    // 停止要求を確認する間隔（ミリ秒）
+    const int WAKEUP_INTERVAL_MS = 200;
+    // ポーリング方式で更新時刻を比較する間隔（ミリ秒）
+    const int POLL_INTERVAL_MS = 500;
+}
+
+FileWatcher::~FileWatcher() {
+    Stop();
+}
+
+bool FileWatcher::Start(const std::vector<std::string>& dirs, ChangeCallback cb) {
+    Stop();
+
+    directories = dirs;
+    callback = std::move(cb);
+
+#ifdef __linux__
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd >= 0) {
+        // inotify はサブディレクトリを自動で監視しないため、ひとつずつ登録する
+        const uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE;
+        for (const auto& dir : directories) {
+            std::error_code ec;
+            if (!fs::is_directory(dir, ec)) continue;
+
+            int wd = inotify_add_watch(inotifyFd, dir.c_str(), mask);
+            if (wd >= 0) watchDirs[wd] = dir;
+
+            for (auto it = fs::recursive_directory_iterator(dir, ec); !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+                if (!it->is_directory(ec)) continue;
+                std::string sub = it->path().generic_string();
+                int subWd = inotify_add_watch(inotifyFd, sub.c_str(), mask);
+                if (subWd >= 0) watchDirs[subWd] = sub;
+            }
+        }
+    }
+    else {
+        LOG_WARN(LogCategory::General, "inotify is unavailable, falling back to polling.");
+    }
+#endif
+
+    running = true;
+    worker = std::thread(&FileWatcher::Run, this);
+    return true;
+}
+
+void FileWatcher::Stop() {
+    if (!running && !worker.joinable()) return;
+
+    running = false;
+    if (worker.joinable()) {
+        worker.join();
+    }
+
+#ifdef __linux__
+    if (inotifyFd >= 0) {
+        close(inotifyFd);
+        inotifyFd = -1;
+    }
+    watchDirs.clear();
+#endif
+}
+
+void FileWatcher::Run() {
+#ifdef __linux__
+    if (inotifyFd >= 0) {
+        RunInotify();
+        return;
+    }
+#endif
+    RunPolling();
+}
+
+#ifdef __linux__
+void FileWatcher::RunInotify() {
+    alignas(inotify_event) char buffer[4096];
+
+    while (running) {
+        pollfd pfd = { inotifyFd, POLLIN, 0 };
+        int ready = poll(&pfd, 1, WAKEUP_INTERVAL_MS);
+        if (ready <= 0) continue;
+
+        ssize_t length = read(inotifyFd, buffer, sizeof(buffer));
+        if (length <= 0) continue;
+
+        for (char* ptr = buffer; ptr < buffer + length; ) {
+            const inotify_event* event = reinterpret_cast<const inotify_event*>(ptr);
+            ptr += sizeof(inotify_event) + event->len;
+
+            auto dirIt = watchDirs.find(event->wd);
+            if (dirIt == watchDirs.end() || event->len == 0) continue;
+
+            std::string path = dirIt->second + "/" + event->name;
+
+            // 新しく作られたサブディレクトリも監視対象に加える
+            if (event->mask & IN_ISDIR) {
+                if (event->mask & IN_CREATE) {
+                    int wd = inotify_add_watch(inotifyFd, path.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+                    if (wd >= 0) watchDirs[wd] = path;
+                }
+                continue;
+            }
+
+            // 作成直後はまだ書き込み中なので、書き込み完了（IN_CLOSE_WRITE）を待つ
+            if (event->mask & IN_CREATE) continue;
+
+            if (callback) callback(path);
+        }
+    }
+}
+#endif
+
+void FileWatcher::ScanFiles(std::map<std::string, fs::file_time_type>& outTimes) const {
+    outTimes.clear();
+    for (const auto& dir : directories) {
+        std::error_code ec;
+        for (auto it = fs::recursive_directory_iterator(dir, ec); !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+            if (!it->is_regular_file(ec)) continue;
+            auto time = it->last_write_time(ec);
+            if (!ec) outTimes[it->path().generic_string()] = time;
+        }
+    }
+}
+
+void FileWatcher::RunPolling() {
+    std::map<std::string, fs::file_time_type> previous;
+    ScanFiles(previous);
+
+    auto nextScan = std::chrono::steady_clock::now() + std::chrono::milliseconds(POLL_INTERVAL_MS);
+    while (running) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(WAKEUP_INTERVAL_MS));
+        if (std::chrono::steady_clock::now() < nextScan) continue;
+        nextScan = std::chrono::steady_clock::now() + std::chrono::milliseconds(POLL_INTERVAL_MS);
+
+        std::map<std::string, fs::file_time_type> current;
+        ScanFiles(current);
+
+        for (const auto& pair : current) {
+            auto it = previous.find(pair.first);
+            if (it == previous.end() || it->second != pair.second) {
+                if (callback) callback(pair.first);
+            }
+        }
+        previous.swap(current);
+    }
+}
@@ -0,0 +1,53 @@
+﻿#pragma once
+#include <string>
+#include <vector>
+#include <map>
+#include <functional>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <filesystem>
+
+/**
+ * @brief ディレクトリ内のファイル変更をバックグラウンドスレッドで監視する
+ * Linux では inotify を使い、それ以外の環境ではファイルの更新時刻を定期的に比較します。
+ * 変更を検出するとコールバックが監視スレッド上で呼ばれるため、重い処理（解析・画像のデコードなど）も
+ * メインループを止めずに行えます。ゲームの状態に触れる処理はメインスレッドへ受け渡してください。
+ */
+class FileWatcher {
+public:
+    // 引数は変更されたファイルのパス（監視開始時に渡したディレクトリからの相対パスを連結したもの）
+    using ChangeCallback = std::function<void(const std::string& path)>;
+
+    FileWatcher() = default;
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    /**
+     * @brief 指定ディレクトリ（サブディレクトリを含む）の監視を開始する
+     */
+    bool Start(const std::vector<std::string>& directories, ChangeCallback callback);
+
+    void Stop();
+
+    bool IsRunning() const { return running; }
+
+private:
+    void Run();
+
+#ifdef __linux__
+    void RunInotify();
+    int inotifyFd = -1;
+    std::map<int, std::string> watchDirs; // watch descriptor -> ディレクトリ
+#endif
+    void RunPolling();
+    void ScanFiles(std::map<std::string, std::filesystem::file_time_type>& outTimes) const;
+
+    std::vector<std::string> directories;
+    ChangeCallback callback;
+
+    std::thread worker;
+    std::atomic<bool> running{ false };
+};
@@ -6,13 +6,16 @@
 #include "../Scenes/Scene.h"
 #include "../Scenes/PlayScene.h"
 #include "InputHandler.h"
+#include "ConfigHotReloader.h"
+#include "ConfigManager.h"
 #include "../Scenes/TitleScene.h"
 #include "../TextureManager.h"
+#include "RenderThread.h"
 #include "../UI/TextRenderer.h"
 #include "imgui.h" 
 #include "../Editor/EditorGUI.h"
 
-Game::Game() : isRunning(false), window(nullptr), renderer(nullptr), nextScene(nullptr) {}
+Game::Game() : isRunning(false), window(nullptr), nextScene(nullptr) {}
 Game::~Game() { Clean(); }
 
 bool Game::Init(const char* title, int xpos, int ypos, int width, int height, bool fullscreen) {
@@ -20,12 +23,10 @@ bool Game::Init(const char* title, int xpos, int ypos, int width, int height, bo
 
     if (SDL_Init(SDL_INIT_EVERYTHING) == 0) {
         window.reset(SDL_CreateWindow(title, xpos, ypos, width, height, flags));
-        renderer.reset(SDL_CreateRenderer(window.get(), -1, SDL_RENDERER_PRESENTVSYNC | SDL_RENDERER_ACCELERATED));
 
-        if (window && renderer) {
-            SDL_SetRenderDrawColor(renderer.get(), 255, 255, 255, 255);
-
-            EditorGUI::Init(window.get(), renderer.get());
+        // レンダラーは描画スレッドで作る（ウィンドウとイベントはこのスレッドに残る）
+        if (window && RenderThread::Start(window.get(), SDL_RENDERER_PRESENTVSYNC | SDL_RENDERER_ACCELERATED)) {
+            EditorGUI::Init(window.get(), RenderThread::GetRenderer());
             TextRenderer::Init("assets/fonts/PixelMplus10.ttf", 24);
             isRunning = true;
         }
@@ -36,6 +37,10 @@ bool Game::Init(const char* title, int xpos, int ypos, int width, int height, bo
 
     inputHandler = std::make_unique<InputHandler>();
 
+    // 設定ファイルと画像の監視を開始する（EditorGUI::Init で設定を読み込んだ後）
+    configReloader = std::make_unique<ConfigHotReloader>();
+    configReloader->Start();
+
     // 初期シーンをセット
     currentScene.reset(new TitleScene());
     currentScene->OnEnter(this);
@@ -59,6 +64,14 @@ void Game::HandleEvents() {
     while (SDL_PollEvent(&event)) {
         if (event.type == SDL_QUIT) Quit();
 
+        // レンダーターゲットの内容が失われた場合は静的レイヤーを作り直す
+        if (currentScene && event.type == SDL_RENDER_TARGETS_RESET) {
+            currentScene->GetStaticLayer().InvalidateAll();
+        }
+        if (currentScene && event.type == SDL_RENDER_DEVICE_RESET) {
+            currentScene->GetStaticLayer().InvalidateAll(true);
+        }
+
         if (currentScene) {
             currentScene->HandleEvents(this, &event);
         }
@@ -66,6 +79,11 @@ void Game::HandleEvents() {
 }
 
 void Game::Update() {
+    // 別スレッドで読み込んだ設定・画像の変更をフレームの区切りで反映する
+    if (configReloader) {
+        configReloader->ApplyPending(GetRenderer(), currentScene.get());
+    }
+
     // シーンの切り替え予約があるかチェック
     if (nextScene) {
         if (currentScene) {
@@ -82,24 +100,39 @@ void Game::Update() {
     }
 
     if (currentScene) {
-        currentScene->Update(this);
+        currentScene->Advance(this);
     }
 }
 
+SDL_Renderer* Game::GetRenderer() const {
+    return RenderThread::GetRenderer();
+}
+
 void Game::Render() {
-    SDL_SetRenderDrawColor(renderer.get(), 30, 30, 30, 255);
-    SDL_RenderClear(renderer.get());
+    // 描画スレッドがもう一方のリストを表示している間に、このフレームの命令を記録する
+    DrawList& drawList = drawLists[recordIndex];
+    int outputW = 0, outputH = 0;
+    RenderThread::GetOutputSize(&outputW, &outputH);
+    drawList.Begin(outputW, outputH);
+
+    drawList.SetDrawColor(30, 30, 30, 255);
+    drawList.Clear();
 
     if (currentScene) {
         currentScene->Render(this);
     }
 
-    SDL_RenderPresent(renderer.get());
+    // 前のフレームの表示が終わるのを待ってから渡す（VSYNC の待ちは描画スレッド側で行われる）
+    RenderThread::Submit(&drawList);
+    recordIndex ^= 1;
 }
 
 void Game::Clean() {
     if (isCleanedUp) return;
 
+    // 描画スレッドが読んでいるフレームを描き終えてから片付ける
+    RenderThread::WaitIdle();
+
     if (currentScene) {
         currentScene->OnExit(this);
         currentScene.reset();
@@ -110,16 +143,27 @@ void Game::Clean() {
         nextScene = nullptr;
     }
 
+    if (configReloader) {
+        configReloader->Stop();
+        configReloader.reset();
+    }
+
+    // 保存中の設定があれば書き終えるまで待つ
+    ConfigManager::Shutdown();
+
     EditorGUI::Clean();
-    TextRenderer::Clean();
     TextureManager::Clean();
 
+    // 破棄待ちのテクスチャを片付けてからレンダラーを破棄する（フォントは描画スレッドが使うので止めた後に閉じる）
+    RenderThread::Stop();
+    TextRenderer::Clean();
+
     SDL_Quit();
     isCleanedUp = true;
 }
 
 void Game::DrawText(const char* text, int x, int y, SDL_Color color) {
-    TextRenderer::Draw(renderer.get(), text, x, y, color);
+    GetDrawList().Text(text, x, y, color);
 }
 
 std::vector<std::unique_ptr<GameObject>>& Game::GetCurrentSceneObjects() {
@@ -136,4 +180,11 @@ SDL_Texture* Game::GetBulletTexture() {
         return playScene->GetBulletTexturePtr();
     }
     return nullptr;
+}
+
+FlowField* Game::GetFlowField() {
+    if (currentScene) {
+        return &currentScene->GetFlowField();
+    }
+    return nullptr;
 }
\ No newline at end of file
@@ -2,11 +2,14 @@
 #include <SDL.h>
 #include <vector>
 #include <memory> 
+#include "DrawList.h"
 
 class Scene;
 class InputHandler;
 class GameObject;
 class Bullet;
+class FlowField;
+class ConfigHotReloader;
 struct SDL_Texture;
 
 struct WindowDestroyer {
@@ -15,14 +18,7 @@ struct WindowDestroyer {
     }
 };
 
-struct RendererDestroyer {
-    void operator()(SDL_Renderer* r) const {
-        if (r) SDL_DestroyRenderer(r);
-    }
-};
-
 using WindowPtr = std::unique_ptr<SDL_Window, WindowDestroyer>;
-using RendererPtr = std::unique_ptr<SDL_Renderer, RendererDestroyer>;
 
 class Game {
 public:
@@ -40,7 +36,10 @@ public:
     // シーン遷移を予約する
     void ChangeScene(Scene* newScene);
 
-    SDL_Renderer* GetRenderer() const { return renderer.get(); }
+    // レンダラーは描画スレッドが持つ（テクスチャの読み込みに渡すためのもの）
+    SDL_Renderer* GetRenderer() const;
+    // このフレームの描画命令を記録するリスト（Render の間だけ有効）
+    DrawList& GetDrawList() { return drawLists[recordIndex]; }
     InputHandler* GetInput() const { return inputHandler.get(); }
 
     std::vector<std::unique_ptr<GameObject>>& GetPendingObjects() { return pendingObjects; }
@@ -49,6 +48,8 @@ public:
 
     std::vector<std::unique_ptr<GameObject>>& GetCurrentSceneObjects();
     SDL_Texture* GetBulletTexture();
+    FlowField* GetFlowField();
+    ConfigHotReloader* GetConfigReloader() const { return configReloader.get(); }
     void DrawText(const char* text, int x, int y, SDL_Color color);
 
 private:
@@ -56,7 +57,10 @@ private:
     bool isCleanedUp = false;
 
     WindowPtr window;
-    RendererPtr renderer;
+
+    // 描画スレッドが前のフレームを表示している間に次のフレームを記録するため、2つを交互に使う
+    DrawList drawLists[2];
+    int recordIndex = 0;
 
     std::unique_ptr<InputHandler> inputHandler;
     std::unique_ptr<Scene> currentScene;
@@ -65,4 +69,7 @@ private:
     Scene* nextScene = nullptr;
 
     std::vector<std::unique_ptr<GameObject>> pendingObjects;
+
+    // 外部で編集された設定・画像の反映
+    std::unique_ptr<ConfigHotReloader> configReloader;
 };
\ No newline at end of file
@@ -0,0 +1,42 @@
+﻿#pragma once
+#include "../GameLogic/WaveManager.h"
+
+// EventBus で配信するゲーム内のイベント
+// オブジェクトはフレームの途中で削除されることがあるため、ポインタではなく ID と座標を渡す
+
+// 敵がダメージを受けた（撃破された場合は killed が true）
+struct EnemyDamagedEvent {
+    unsigned int enemyId = 0;
+    float x = 0.0f;       // 敵の中心
+    float y = 0.0f;
+    int damage = 0;
+    bool killed = false;
+};
+
+// 拠点が攻撃を受けた
+struct BaseDamagedEvent {
+    float impactX = 0.0f;
+    float impactY = 0.0f;
+    int damage = 0;
+    int remainingHP = 0;
+};
+
+// 弾が地形や敵に当たって消えた
+struct BulletImpactEvent {
+    float x = 0.0f;
+    float y = 0.0f;
+    float directionDegrees = 0.0f;  // 進行方向と逆向き（火花を散らす向き）
+};
+
+// プレイヤーが発砲した
+struct ShotFiredEvent {
+    float muzzleX = 0.0f;
+    float muzzleY = 0.0f;
+    float aimDegrees = 0.0f;
+};
+
+// ウェーブの状態が変わった
+struct WaveStateChangedEvent {
+    int waveIndex = 0;  // 0 始まり
+    WaveManager::State state = WaveManager::State::PREPARING;
+};
@@ -4,13 +4,34 @@
 #include <map>
 #include <vector>
 #include <string>
+#include <tuple>
+#include "StringId.h"
 
 using json = nlohmann::json;
 
+// StringId は JSON には文字列として保存する
+inline void to_json(json& j, const StringId& id) { j = id.str(); }
+inline void from_json(const json& j, StringId& id) { id = StringId(j.get<std::string>()); }
+
 namespace PhysicsSettings {
     constexpr float GravityScale = 100.0f;
 }
 
+// 設定のセクション（変更があったセクションに依存するオブジェクトだけを更新するためのビット）
+namespace ConfigSection {
+    enum : unsigned int {
+        None    = 0,
+        Player  = 1 << 0,
+        Gun     = 1 << 1,
+        Enemy   = 1 << 2,
+        Physics = 1 << 3,
+        Camera  = 1 << 4,
+        Base    = 1 << 5,
+        Levels  = 1 << 6,
+        All     = 0xFFFFFFFFu
+    };
+}
+
 enum class MovementType {
     Linear = 0,
     PathFollow = 1
@@ -33,6 +54,13 @@ struct PlayerParams {
     float jumpVelocity = 600.0f;
     float maxHealth = 100.0f;
 
+    // エディタの変更検出用（全項目の比較）
+    bool operator==(const PlayerParams& other) const {
+        return std::tie(moveSpeed, jumpVelocity, maxHealth) ==
+            std::tie(other.moveSpeed, other.jumpVelocity, other.maxHealth);
+    }
+    bool operator!=(const PlayerParams& other) const { return !(*this == other); }
+
     friend void to_json(json& j, const PlayerParams& p) {
         j = json{
             {"moveSpeed", p.moveSpeed},
@@ -59,6 +87,12 @@ struct GunParams {
     float reloadTime = 1.5f;
     std::string texturePath = "assets/images/guns/default_gun.png";
 
+    bool operator==(const GunParams& other) const {
+        return std::tie(fireRate, bulletSpeed, damage, spreadAngle, shotCount, offsetX, offsetY, magazineSize, reloadTime, texturePath) ==
+            std::tie(other.fireRate, other.bulletSpeed, other.damage, other.spreadAngle, other.shotCount, other.offsetX, other.offsetY, other.magazineSize, other.reloadTime, other.texturePath);
+    }
+    bool operator!=(const GunParams& other) const { return !(*this == other); }
+
     friend void to_json(json& j, const GunParams& p) {
         j = json{
             {"fireRate", p.fireRate},
@@ -90,16 +124,25 @@ struct GunParams {
 struct PhysicsParams {
     float gravity = 9.8f;
     float terminalVelocity = 1500.0f;
+    bool sweepAndPrune = true;   // 当たり判定の候補を X 方向の区間で絞る（false: 総当たり）
+
+    bool operator==(const PhysicsParams& other) const {
+        return std::tie(gravity, terminalVelocity, sweepAndPrune) ==
+            std::tie(other.gravity, other.terminalVelocity, other.sweepAndPrune);
+    }
+    bool operator!=(const PhysicsParams& other) const { return !(*this == other); }
 
     friend void to_json(json& j, const PhysicsParams& p) {
         j = json{
             {"gravity", p.gravity},
-            {"terminalVelocity", p.terminalVelocity}
+            {"terminalVelocity", p.terminalVelocity},
+            {"sweepAndPrune", p.sweepAndPrune}
         };
     }
     friend void from_json(const json& j, PhysicsParams& p) {
         if (j.contains("gravity")) j.at("gravity").get_to(p.gravity);
         if (j.contains("terminalVelocity")) j.at("terminalVelocity").get_to(p.terminalVelocity);
+        if (j.contains("sweepAndPrune")) j.at("sweepAndPrune").get_to(p.sweepAndPrune);
     }
 };
 
@@ -115,6 +158,12 @@ struct EnemyParams {
     std::string texturePath = "assets/images/enemies/default_enemy.png";
     std::string bulletTexturePath = "assets/images/enemies/enemy_bullet.png";
 
+    bool operator==(const EnemyParams& other) const {
+        return std::tie(baseHealth, attackPower, baseSpeed, attackRange, attackInterval, moveMethod, locomotionStyle, attackMethod, texturePath, bulletTexturePath) ==
+            std::tie(other.baseHealth, other.attackPower, other.baseSpeed, other.attackRange, other.attackInterval, other.moveMethod, other.locomotionStyle, other.attackMethod, other.texturePath, other.bulletTexturePath);
+    }
+    bool operator!=(const EnemyParams& other) const { return !(*this == other); }
+
     friend void to_json(json& j, const EnemyParams& p) {
         j = json{
             {"baseHealth", p.baseHealth},
@@ -149,6 +198,12 @@ struct CameraParams {
     int limitX = 2000;
     int limitY = 1000;
 
+    bool operator==(const CameraParams& other) const {
+        return std::tie(offsetX, offsetY, limitX, limitY) ==
+            std::tie(other.offsetX, other.offsetY, other.limitX, other.limitY);
+    }
+    bool operator!=(const CameraParams& other) const { return !(*this == other); }
+
     friend void to_json(json& j, const CameraParams& p) {
         j = json{
             {"offsetX", p.offsetX},
@@ -170,6 +225,12 @@ struct BaseParams {
     float defense = 0.0f;
     std::string texturePath = "assets/images/base/gate.png";
 
+    bool operator==(const BaseParams& other) const {
+        return std::tie(maxHealth, defense, texturePath) ==
+            std::tie(other.maxHealth, other.defense, other.texturePath);
+    }
+    bool operator!=(const BaseParams& other) const { return !(*this == other); }
+
     friend void to_json(json& j, const BaseParams& p) {
         j = json{
             {"maxHealth", p.maxHealth},
@@ -185,21 +246,66 @@ struct BaseParams {
 };
 
 struct EnemySpawnEntry {
-    std::string enemyPresetName = "Default";
+    StringId enemyPresetName = "Default";  // ウェーブのコンパイル時に番号で重複をまとめる
     int count = 1;
+    float startDelay = -1.0f;  // ウェーブ開始からの出現開始時刻（秒）。負の値なら前のエントリが出し終わった後
+    float interval = 1.0f;     // 次の出現までの間隔（秒）
+    int burstSize = 1;         // 1回に同時に出す数
+    int lane = -1;             // 出現レーンの番号（負の値ならランダム）
+
+    bool operator==(const EnemySpawnEntry& other) const {
+        return std::tie(enemyPresetName, count, startDelay, interval, burstSize, lane) ==
+            std::tie(other.enemyPresetName, other.count, other.startDelay, other.interval, other.burstSize, other.lane);
+    }
+    bool operator!=(const EnemySpawnEntry& other) const { return !(*this == other); }
 
     friend void to_json(json& j, const EnemySpawnEntry& p) {
-        j = json{ {"preset", p.enemyPresetName}, {"count", p.count} };
+        j = json{
+            {"preset", p.enemyPresetName}, {"count", p.count},
+            {"delay", p.startDelay}, {"interval", p.interval},
+            {"burst", p.burstSize}, {"lane", p.lane}
+        };
     }
     friend void from_json(const json& j, EnemySpawnEntry& p) {
         if (j.contains("preset")) j.at("preset").get_to(p.enemyPresetName);
         if (j.contains("count")) j.at("count").get_to(p.count);
+        if (j.contains("delay")) j.at("delay").get_to(p.startDelay);
+        if (j.contains("interval")) j.at("interval").get_to(p.interval);
+        if (j.contains("burst")) j.at("burst").get_to(p.burstSize);
+        if (j.contains("lane")) j.at("lane").get_to(p.lane);
+    }
+};
+
+// 敵の出現位置（x は固定、y は範囲内でランダム）
+struct SpawnLane {
+    float x = 1300.0f;
+    float minY = 50.0f;
+    float maxY = 400.0f;
+
+    bool operator==(const SpawnLane& other) const {
+        return std::tie(x, minY, maxY) ==
+            std::tie(other.x, other.minY, other.maxY);
+    }
+    bool operator!=(const SpawnLane& other) const { return !(*this == other); }
+
+    friend void to_json(json& j, const SpawnLane& p) {
+        j = json{ {"x", p.x}, {"minY", p.minY}, {"maxY", p.maxY} };
+    }
+    friend void from_json(const json& j, SpawnLane& p) {
+        if (j.contains("x")) j.at("x").get_to(p.x);
+        if (j.contains("minY")) j.at("minY").get_to(p.minY);
+        if (j.contains("maxY")) j.at("maxY").get_to(p.maxY);
     }
 };
 
 struct WaveParams {
     std::vector<EnemySpawnEntry> spawns;
 
+    bool operator==(const WaveParams& other) const {
+        return spawns == other.spawns;
+    }
+    bool operator!=(const WaveParams& other) const { return !(*this == other); }
+
     friend void to_json(json& j, const WaveParams& p) {
         j = json{ {"spawns", p.spawns} };
     }
@@ -210,12 +316,20 @@ struct WaveParams {
 
 struct LevelParams {
     std::vector<WaveParams> waves;
+    std::vector<SpawnLane> lanes;  // 空なら画面右端の外側の1レーン
+
+    bool operator==(const LevelParams& other) const {
+        return std::tie(waves, lanes) ==
+            std::tie(other.waves, other.lanes);
+    }
+    bool operator!=(const LevelParams& other) const { return !(*this == other); }
 
     friend void to_json(json& j, const LevelParams& p) {
-        j = json{ {"waves", p.waves} };
+        j = json{ {"waves", p.waves}, {"lanes", p.lanes} };
     }
     friend void from_json(const json& j, LevelParams& p) {
         if (j.contains("waves")) j.at("waves").get_to(p.waves);
+        if (j.contains("lanes")) j.at("lanes").get_to(p.lanes);
     }
 };
 
@@ -267,30 +381,71 @@ public:
         };
     }
 
+    // 全項目を一時変数に読み込んでから反映する（途中で型の違いなどの例外が出ても p は変わらない）
+    // プリセットからの上書きは、j にプリセットか選択中のプリセット名が含まれるセクションだけに行う
     friend void from_json(const json& j, GameParams& p) {
-        if (j.contains("Player")) j.at("Player").get_to(p.player);
-        if (j.contains("Gun")) j.at("Gun").get_to(p.gun);
-        if (j.contains("Physics")) j.at("Physics").get_to(p.physics);
-        if (j.contains("Enemy")) j.at("Enemy").get_to(p.enemy);
-        if (j.contains("Camera")) j.at("Camera").get_to(p.camera);
-        if (j.contains("Base")) j.at("Base").get_to(p.base);
-        if (j.contains("PlayerPresets")) j.at("PlayerPresets").get_to(p.playerPresets);
-        if (j.contains("ActivePlayerPreset")) j.at("ActivePlayerPreset").get_to(p.activePlayerPresetName);
-        if (j.contains("GunPresets")) j.at("GunPresets").get_to(p.gunPresets);
-        if (j.contains("ActiveGunPreset")) j.at("ActiveGunPreset").get_to(p.activeGunPresetName);
-        if (j.contains("EnemyPresets")) j.at("EnemyPresets").get_to(p.enemyPresets);
-        if (j.contains("ActiveEnemyPreset")) j.at("ActiveEnemyPreset").get_to(p.activeEnemyPresetName);
-        if (j.contains("CameraPresets")) j.at("CameraPresets").get_to(p.cameraPresets);
-        if (j.contains("ActiveCameraPreset")) j.at("ActiveCameraPreset").get_to(p.activeCameraPresetName);
-        if (j.contains("Levels")) j.at("Levels").get_to(p.levelConfigs);
-        p.applyActivePresets();
-    }
-
-    void applyActivePresets() {
-        if (playerPresets.count(activePlayerPresetName)) player = playerPresets.at(activePlayerPresetName);
-        if (gunPresets.count(activeGunPresetName)) gun = gunPresets.at(activeGunPresetName);
-        if (enemyPresets.count(activeEnemyPresetName)) enemy = enemyPresets.at(activeEnemyPresetName);
-        if (cameraPresets.count(activeCameraPresetName)) camera = cameraPresets.at(activeCameraPresetName);
+        PlayerParams player = p.player;
+        GunParams gun = p.gun;
+        PhysicsParams physics = p.physics;
+        EnemyParams enemy = p.enemy;
+        CameraParams camera = p.camera;
+        BaseParams base = p.base;
+        std::map<std::string, PlayerParams> playerPresets = p.playerPresets;
+        std::string activePlayerPresetName = p.activePlayerPresetName;
+        std::map<std::string, GunParams> gunPresets = p.gunPresets;
+        std::string activeGunPresetName = p.activeGunPresetName;
+        std::map<std::string, EnemyParams> enemyPresets = p.enemyPresets;
+        std::string activeEnemyPresetName = p.activeEnemyPresetName;
+        std::map<std::string, CameraParams> cameraPresets = p.cameraPresets;
+        std::string activeCameraPresetName = p.activeCameraPresetName;
+        std::map<int, LevelParams> levelConfigs = p.levelConfigs;
+
+        if (j.contains("Player")) j.at("Player").get_to(player);
+        if (j.contains("Gun")) j.at("Gun").get_to(gun);
+        if (j.contains("Physics")) j.at("Physics").get_to(physics);
+        if (j.contains("Enemy")) j.at("Enemy").get_to(enemy);
+        if (j.contains("Camera")) j.at("Camera").get_to(camera);
+        if (j.contains("Base")) j.at("Base").get_to(base);
+        if (j.contains("PlayerPresets")) j.at("PlayerPresets").get_to(playerPresets);
+        if (j.contains("ActivePlayerPreset")) j.at("ActivePlayerPreset").get_to(activePlayerPresetName);
+        if (j.contains("GunPresets")) j.at("GunPresets").get_to(gunPresets);
+        if (j.contains("ActiveGunPreset")) j.at("ActiveGunPreset").get_to(activeGunPresetName);
+        if (j.contains("EnemyPresets")) j.at("EnemyPresets").get_to(enemyPresets);
+        if (j.contains("ActiveEnemyPreset")) j.at("ActiveEnemyPreset").get_to(activeEnemyPresetName);
+        if (j.contains("CameraPresets")) j.at("CameraPresets").get_to(cameraPresets);
+        if (j.contains("ActiveCameraPreset")) j.at("ActiveCameraPreset").get_to(activeCameraPresetName);
+        if (j.contains("Levels")) j.at("Levels").get_to(levelConfigs);
+
+        p.player = std::move(player);
+        p.gun = std::move(gun);
+        p.physics = std::move(physics);
+        p.enemy = std::move(enemy);
+        p.camera = std::move(camera);
+        p.base = std::move(base);
+        p.playerPresets = std::move(playerPresets);
+        p.activePlayerPresetName = std::move(activePlayerPresetName);
+        p.gunPresets = std::move(gunPresets);
+        p.activeGunPresetName = std::move(activeGunPresetName);
+        p.enemyPresets = std::move(enemyPresets);
+        p.activeEnemyPresetName = std::move(activeEnemyPresetName);
+        p.cameraPresets = std::move(cameraPresets);
+        p.activeCameraPresetName = std::move(activeCameraPresetName);
+        p.levelConfigs = std::move(levelConfigs);
+
+        unsigned int presetSections = ConfigSection::None;
+        if (j.contains("PlayerPresets") || j.contains("ActivePlayerPreset")) presetSections |= ConfigSection::Player;
+        if (j.contains("GunPresets") || j.contains("ActiveGunPreset")) presetSections |= ConfigSection::Gun;
+        if (j.contains("EnemyPresets") || j.contains("ActiveEnemyPreset")) presetSections |= ConfigSection::Enemy;
+        if (j.contains("CameraPresets") || j.contains("ActiveCameraPreset")) presetSections |= ConfigSection::Camera;
+        p.applyActivePresets(presetSections);
+    }
+
+    // sections に含まれるセクションの値を、選択中のプリセットの内容で置き換える
+    void applyActivePresets(unsigned int sections = ConfigSection::All) {
+        if ((sections & ConfigSection::Player) && playerPresets.count(activePlayerPresetName)) player = playerPresets.at(activePlayerPresetName);
+        if ((sections & ConfigSection::Gun) && gunPresets.count(activeGunPresetName)) gun = gunPresets.at(activeGunPresetName);
+        if ((sections & ConfigSection::Enemy) && enemyPresets.count(activeEnemyPresetName)) enemy = enemyPresets.at(activeEnemyPresetName);
+        if ((sections & ConfigSection::Camera) && cameraPresets.count(activeCameraPresetName)) camera = cameraPresets.at(activeCameraPresetName);
     }
 
 private:
@@ -1,5 +1,8 @@
 #include "GameSession.h"
 #include "GameParams.h"
+#include "EventBus.h"
+#include "GameEvents.h"
+#include "Logger.h"
 #include <algorithm>
 
 void GameSession::ResetSession() {
@@ -19,24 +22,26 @@ void GameSession::ResetSession() {
     reloadSpeedBonus = 0.0f;
     movementSpeedBonus = 0.0f;
 
-    std::cout << "Game Session Initialized." << std::endl;
+    LOG_INFO(LogCategory::General, "Game Session Initialized.");
 }
 
-void GameSession::DamageBase(int damage) {
+void GameSession::DamageBase(int damage, float impactX, float impactY) {
     currentBaseHP -= damage;
     if (currentBaseHP < 0) currentBaseHP = 0;
 
-    std::cout << "Base Damaged! HP: " << currentBaseHP << "/" << maxBaseHP << std::endl;
+    EventBus::GetInstance().Publish(BaseDamagedEvent{ impactX, impactY, damage, currentBaseHP });
+
+    LOG_INFO(LogCategory::Combat, "Base Damaged! HP: " << currentBaseHP << "/" << maxBaseHP);
 
     if (currentBaseHP <= 0) {
-        std::cout << "GAME OVER: The Gate has fallen." << std::endl;
+        LOG_INFO(LogCategory::Combat, "GAME OVER: The Gate has fallen.");
         // V[JڂQ[I[o[CxgŃgK[
     }
 }
 
 void GameSession::RepairBase(int amount) {
     currentBaseHP = std::min(maxBaseHP, currentBaseHP + amount);
-    std::cout << "Base Repaired. HP: " << currentBaseHP << "/" << maxBaseHP << std::endl;
+    LOG_INFO(LogCategory::Combat, "Base Repaired. HP: " << currentBaseHP << "/" << maxBaseHP);
 }
 
 void GameSession::ChangeGun(const std::string& gunPresetName) {
@@ -47,6 +52,6 @@ void GameSession::ChangeGun(const std::string& gunPresetName) {
         equippedGunPresetName = gunPresetName;
         params.gun = params.gunPresets[gunPresetName];
         params.activeGunPresetName = gunPresetName;
-        std::cout << "Gun Swapped to: " << gunPresetName << std::endl;
+        LOG_INFO(LogCategory::Combat, "Gun Swapped to: " << gunPresetName);
     }
 }
\ No newline at end of file
@@ -32,9 +32,9 @@ public:
     void ResetSession();
 
     /**
-     * @brief _Ƀ_[W^
+     * @brief eʒuw肵ċ_Ƀ_[W^ïʒuɔjЃGtFNgoj
      */
-    void DamageBase(int damage);
+    void DamageBase(int damage, float impactX, float impactY);
 
     /**
      * @brief _C
@@ -0,0 +1,10 @@
+﻿#pragma once
+#include <cstdint>
+
+/**
+ * @brief 2次元のセル座標を unordered_map のキーにまとめる（上位 32 ビットが x、下位 32 ビットが y）
+ * 負の座標もそのまま扱えるよう、符号なしに変換してからシフトします。
+ */
+inline unsigned long long MakeGridKey(int cx, int cy) {
+    return ((unsigned long long)(std::uint32_t)cx << 32) | (std::uint32_t)cy;
+}
@@ -10,7 +10,9 @@ enum class GameAction {
     MoveRight,
     Shoot,
     Reload, 
-    Pause
+    Pause,
+    Undo,
+    Redo
 };
 
 class InputHandler {
@@ -24,6 +26,12 @@ public:
         keyMap[GameAction::Reload] = SDL_SCANCODE_R;
         keyMap[GameAction::Pause] = SDL_SCANCODE_ESCAPE;
 
+        // --- エディタのショートカット（修飾キーと組み合わせる） ---
+        keyMap[GameAction::Undo] = SDL_SCANCODE_Z;
+        keyMap[GameAction::Redo] = SDL_SCANCODE_Y;
+        modifierMap[GameAction::Undo] = KMOD_CTRL;
+        modifierMap[GameAction::Redo] = KMOD_CTRL;
+
         // --- マウス設定 ---
         mouseMap[GameAction::Shoot] = SDL_BUTTON_LEFT;
 
@@ -55,6 +63,8 @@ public:
 
     // 押しっぱなし判定
     bool IsPressed(GameAction action) {
+        if (!AreModifiersHeld(action)) return false;
+
         // キーボードチェック
         if (keyMap.count(action)) {
             if (keyboardState[keyMap[action]]) return true;
@@ -72,6 +82,8 @@ public:
 
     // 押した瞬間判定
     bool IsJustPressed(GameAction action) {
+        if (!AreModifiersHeld(action)) return false;
+
         //  キーボードチェック
         if (keyMap.count(action)) {
             SDL_Scancode key = keyMap[action];
@@ -91,8 +103,17 @@ public:
     }
 
 private:
+    // 修飾キーが必要なアクションは、そのキーが押されている時だけ有効にする
+    bool AreModifiersHeld(GameAction action) {
+        auto it = modifierMap.find(action);
+        if (it == modifierMap.end()) return true;
+        return (SDL_GetModState() & it->second) != 0;
+    }
+
     // キーボード用マップ
     std::map<GameAction, SDL_Scancode> keyMap;
+    // 修飾キーのマップ（Ctrl など。KMOD_CTRL は左右どちらでも良い）
+    std::map<GameAction, int> modifierMap;
     // マウス用マップ
     std::map<GameAction, int> mouseMap;
 
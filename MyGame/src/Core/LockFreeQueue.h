@@ -0,0 +1,72 @@
+﻿#pragma once
+#include <atomic>
+#include <memory>
+#include <cstddef>
+
+/**
+ * @brief 固定長のロックフリーなキュー（複数の書き込みスレッド・1つの読み出しスレッド）
+ * リングバッファの各要素に通し番号を持たせ、書き込み位置の確保だけを CAS で行います
+ * （D. Vyukov の bounded queue）。満杯の時は待たずに失敗を返すため、呼び出し側は止まりません。
+ * @tparam Capacity 2のべき乗であること
+ */
+template <typename T, size_t Capacity>
+class MPSCQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    MPSCQueue() : cells(new Cell[Capacity]) {
+        for (size_t i = 0; i < Capacity; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MPSCQueue(const MPSCQueue&) = delete;
+    MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+    // どのスレッドからでも呼べる。満杯なら false
+    bool TryPush(const T& value) {
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[pos & (Capacity - 1)];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+            if (diff == 0) {
+                // この位置が空いている。他の書き込みに先を越されなければ確保できる
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.data = value;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0) {
+                return false;
+            }
+            else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // 読み出しスレッドだけが呼ぶ。空なら false
+    bool TryPop(T& outValue) {
+        Cell& cell = cells[dequeuePos & (Capacity - 1)];
+        size_t seq = cell.sequence.load(std::memory_order_acquire);
+        if ((intptr_t)seq - (intptr_t)(dequeuePos + 1) < 0) return false;
+
+        outValue = cell.data;
+        cell.sequence.store(dequeuePos + Capacity, std::memory_order_release);
+        ++dequeuePos;
+        return true;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence{ 0 };
+        T data{};
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    // 書き込み側と読み出し側が同じキャッシュラインを取り合わないよう分ける
+    alignas(64) std::atomic<size_t> enqueuePos{ 0 };
+    alignas(64) size_t dequeuePos = 0;
+};
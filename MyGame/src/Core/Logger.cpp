@@ -0,0 +1,161 @@
+﻿#include "Logger.h"
+#include "LockFreeQueue.h"
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <cstring>
+#include <algorithm>
+
+namespace {
+    struct LogEntry {
+        LogLevel level = LogLevel::Info;
+        LogCategory category = LogCategory::General;
+        uint32_t suppressed = 0;
+        char text[Logger::MAX_MESSAGE_LENGTH] = {};
+    };
+
+    // 空の時に出力スレッドが待つ間隔（ミリ秒）
+    const int IDLE_INTERVAL_MS = 5;
+
+    MPSCQueue<LogEntry, 1024> queue;
+    std::thread worker;
+    std::atomic<bool> running{ false };
+    // running を確認してからキューに積み終えるまでの Write の数（停止時にこれが 0 になるまで待つ）
+    std::atomic<int> activeWriters{ 0 };
+    std::atomic<uint64_t> droppedCount{ 0 };
+
+    const char* LevelName(LogLevel level) {
+        switch (level) {
+        case LogLevel::Debug: return "DEBUG";
+        case LogLevel::Info: return "INFO";
+        case LogLevel::Warning: return "WARN";
+        case LogLevel::Error: return "ERROR";
+        }
+        return "?";
+    }
+
+    const char* CategoryName(LogCategory category) {
+        switch (category) {
+        case LogCategory::General: return "General";
+        case LogCategory::Asset: return "Asset";
+        case LogCategory::Config: return "Config";
+        case LogCategory::Wave: return "Wave";
+        case LogCategory::Combat: return "Combat";
+        case LogCategory::Scene: return "Scene";
+        case LogCategory::Editor: return "Editor";
+        }
+        return "?";
+    }
+
+    int64_t NowMs() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void Print(LogLevel level, LogCategory category, const char* text, uint32_t suppressed) {
+        std::ostream& out = (level >= LogLevel::Warning) ? std::cerr : std::cout;
+        out << "[" << LevelName(level) << "][" << CategoryName(category) << "] " << text;
+        if (suppressed > 0) out << " (" << suppressed << " similar messages suppressed)";
+        out << '\n';
+    }
+
+    // キューに溜まった分をすべて書き出す（出力スレッド、または出力スレッドを止めた後の Shutdown から呼ぶ）
+    bool Drain() {
+        static uint64_t reportedDrops = 0;
+        bool wroteAny = false;
+
+        LogEntry entry;
+        while (queue.TryPop(entry)) {
+            Print(entry.level, entry.category, entry.text, entry.suppressed);
+            wroteAny = true;
+        }
+
+        uint64_t drops = droppedCount.load(std::memory_order_relaxed);
+        if (drops != reportedDrops) {
+            std::cerr << "[WARN][General] Log buffer overflow: " << (drops - reportedDrops) << " messages dropped\n";
+            reportedDrops = drops;
+            wroteAny = true;
+        }
+
+        // フラッシュは1回のまとめ書きにつき1回だけ
+        if (wroteAny) {
+            std::cout.flush();
+            std::cerr.flush();
+        }
+        return wroteAny;
+    }
+
+    void Run() {
+        while (running.load(std::memory_order_acquire)) {
+            if (!Drain()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(IDLE_INTERVAL_MS));
+            }
+        }
+        Drain();
+    }
+}
+
+bool Logger::RateLimit::Allow(uint32_t& outSuppressed) {
+    int64_t now = NowMs();
+    int64_t start = windowStartMs.load(std::memory_order_relaxed);
+    if (now - start >= 1000 && windowStartMs.compare_exchange_strong(start, now, std::memory_order_relaxed)) {
+        countInWindow.store(0, std::memory_order_relaxed);
+    }
+
+    if (countInWindow.fetch_add(1, std::memory_order_relaxed) < maxPerSecond) {
+        outSuppressed = suppressed.exchange(0, std::memory_order_relaxed);
+        return true;
+    }
+    suppressed.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void Logger::Start() {
+    if (running) return;
+    running = true;
+    worker = std::thread(Run);
+}
+
+void Logger::Shutdown() {
+    if (!running && !worker.joinable()) return;
+
+    running = false;
+    if (worker.joinable()) {
+        worker.join();
+    }
+
+    // 停止の直前に running を確認した Write が積み終えるのを待ち、出力スレッドの最後の書き出しの
+    // 後に積まれた分をここで書き出す（以降の Write は直接出力するのでキューには積まれない）
+    while (activeWriters.load() != 0) {
+        std::this_thread::yield();
+    }
+    Drain();
+}
+
+void Logger::Write(LogLevel level, LogCategory category, const std::string& message, uint32_t suppressed) {
+    // 数えてから running を確認する（Shutdown は running を下ろしてからこの数を見る）
+    activeWriters.fetch_add(1);
+    if (!running.load()) {
+        activeWriters.fetch_sub(1);
+        Print(level, category, message.c_str(), suppressed);
+        std::cout.flush();
+        return;
+    }
+
+    LogEntry entry;
+    entry.level = level;
+    entry.category = category;
+    entry.suppressed = suppressed;
+    size_t length = std::min(message.size(), MAX_MESSAGE_LENGTH - 1);
+    std::memcpy(entry.text, message.data(), length);
+    entry.text[length] = '\0';
+
+    if (!queue.TryPush(entry)) {
+        droppedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    activeWriters.fetch_sub(1, std::memory_order_release);
+}
+
+uint64_t Logger::GetDroppedCount() {
+    return droppedCount.load(std::memory_order_relaxed);
+}
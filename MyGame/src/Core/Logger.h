@@ -0,0 +1,98 @@
+﻿#pragma once
+#include <string>
+#include <sstream>
+#include <atomic>
+#include <cstdint>
+
+// ログの重要度（数値が大きいほど重要）
+enum class LogLevel : int {
+    Debug = 0,
+    Info = 1,
+    Warning = 2,
+    Error = 3,
+};
+
+// ログの発生元（出力の先頭に付けて絞り込みやすくする）
+enum class LogCategory : int {
+    General,
+    Asset,
+    Config,
+    Wave,
+    Combat,
+    Scene,
+    Editor,
+};
+
+// これより低い重要度のログは呼び出しごとコンパイル時に取り除かれる（ビルド設定で上書きできる）
+#ifndef LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define LOG_MIN_LEVEL 1
+#else
+#define LOG_MIN_LEVEL 0
+#endif
+#endif
+
+/**
+ * @brief 非同期のログ出力
+ * 呼び出し側はメッセージをロックフリーのリングバッファに積むだけで、コンソールへの書き込みと
+ * フラッシュはバックグラウンドスレッドがまとめて行います。バッファが満杯の時は待たずに捨て、
+ * 捨てた件数を後で報告します。Start() の前と Shutdown() の後は呼び出したスレッドで直接出力します。
+ * 通常は LOG_INFO などのマクロから使います（呼び出し箇所ごとに1秒あたりの出力数が制限されます）。
+ */
+class Logger {
+public:
+    // 1件のメッセージの最大長（超えた分は切り捨てる）
+    static constexpr size_t MAX_MESSAGE_LENGTH = 192;
+    // 呼び出し箇所ごとの既定の上限（1秒あたりの件数）
+    static constexpr int DEFAULT_RATE_PER_SECOND = 10;
+
+    /**
+     * @brief 呼び出し箇所ごとの出力数の制限
+     * 1秒間に maxPerSecond 件を超えた分は捨て、次に出力するメッセージに捨てた件数を添えます。
+     */
+    class RateLimit {
+    public:
+        explicit RateLimit(int maxPerSecond) : maxPerSecond(maxPerSecond) {}
+
+        // 出力してよければ true。outSuppressed には前回の出力以降に捨てた件数が入る
+        bool Allow(uint32_t& outSuppressed);
+
+    private:
+        const int maxPerSecond;
+        std::atomic<int64_t> windowStartMs{ 0 };
+        std::atomic<int> countInWindow{ 0 };
+        std::atomic<uint32_t> suppressed{ 0 };
+    };
+
+    // 出力スレッドを開始する
+    static void Start();
+    // 残っているメッセージを書き出してから出力スレッドを止める
+    static void Shutdown();
+
+    static void Write(LogLevel level, LogCategory category, const std::string& message, uint32_t suppressed = 0);
+
+    // バッファが満杯で捨てたメッセージの累計
+    static uint64_t GetDroppedCount();
+
+private:
+    Logger() = delete;
+};
+
+// 重要度・発生元・1秒あたりの上限を指定して出力する。message は << で連結できる
+#define LOG_AT(level, category, ratePerSecond, message) \
+    do { \
+        if constexpr ((int)(level) >= LOG_MIN_LEVEL) { \
+            static Logger::RateLimit logRateLimit_(ratePerSecond); \
+            uint32_t logSuppressed_ = 0; \
+            if (logRateLimit_.Allow(logSuppressed_)) { \
+                std::ostringstream logStream_; \
+                logStream_ << message; \
+                Logger::Write(level, category, logStream_.str(), logSuppressed_); \
+            } \
+        } \
+    } while (0)
+
+#define LOG_DEBUG(category, message) LOG_AT(LogLevel::Debug, category, Logger::DEFAULT_RATE_PER_SECOND, message)
+#define LOG_INFO(category, message) LOG_AT(LogLevel::Info, category, Logger::DEFAULT_RATE_PER_SECOND, message)
+#define LOG_WARN(category, message) LOG_AT(LogLevel::Warning, category, Logger::DEFAULT_RATE_PER_SECOND, message)
+#define LOG_ERROR(category, message) LOG_AT(LogLevel::Error, category, Logger::DEFAULT_RATE_PER_SECOND, message)
@@ -0,0 +1,64 @@
+﻿#include "ObjectHotData.h"
+#include "../Objects/GameObject.h"
+
+std::uint8_t ObjectHotData::MakeFlags(const GameObject& obj) {
+    std::uint8_t result = 0;
+    if (obj.isDead) result |= DEAD;
+    if (obj.useGravity) result |= GRAVITY;
+    if (obj.isTrigger) result |= TRIGGER;
+    if (obj.isStatic) result |= STATIC;
+    if (obj.affectsNavigation) result |= AFFECTS_NAV;
+    if (obj.entity != NullEntity) result |= ECS;
+    if (obj.isSleeping) result |= SLEEPING;
+    if (obj.name == ObjectNames::Player || obj.name == ObjectNames::TestPlayer ||
+        obj.name == ObjectNames::Enemy || obj.name == ObjectNames::TestEnemy) {
+        result |= BODY;
+    }
+    return result;
+}
+
+void ObjectHotData::Gather(const std::vector<std::unique_ptr<GameObject>>& objects) {
+    size_t count = objects.size();
+    x.resize(count);
+    y.resize(count);
+    width.resize(count);
+    height.resize(count);
+    velX.resize(count);
+    velY.resize(count);
+    accX.resize(count);
+    accY.resize(count);
+    prevX.resize(count);
+    prevY.resize(count);
+    flags.resize(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        Refresh(i, *objects[i]);
+        prevX[i] = objects[i]->x;
+        prevY[i] = objects[i]->y;
+    }
+}
+
+void ObjectHotData::Refresh(size_t i, const GameObject& obj) {
+    x[i] = obj.x;
+    y[i] = obj.y;
+    width[i] = (float)obj.width;
+    height[i] = (float)obj.height;
+    velX[i] = obj.velX;
+    velY[i] = obj.velY;
+    accX[i] = obj.accX;
+    accY[i] = obj.accY;
+    flags[i] = MakeFlags(obj);
+}
+
+void ObjectHotData::ScatterMotion(const std::vector<std::unique_ptr<GameObject>>& objects) const {
+    for (size_t i = 0; i < objects.size(); ++i) {
+        if (flags[i] & (DEAD | ECS | SLEEPING)) continue;
+        GameObject& obj = *objects[i];
+        obj.x = x[i];
+        obj.y = y[i];
+        obj.velX = velX[i];
+        obj.velY = velY[i];
+        obj.accX = accX[i];
+        obj.accY = accY[i];
+    }
+}
@@ -0,0 +1,55 @@
+﻿#pragma once
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+class GameObject;
+
+/**
+ * @brief シーンの毎フレームの処理（物理・衝突判定）が読む値だけを、成分ごとの連続した配列に集めたもの
+ * GameObject は名前・テクスチャ・仮想関数表などを含むため1つで複数のキャッシュラインにまたがり、
+ * ヒープ上にも散らばっています。フレームの始めに一度だけ集め（Gather）、物理と衝突の判定は
+ * この配列を先頭から順に読み、結果を GameObject へ書き戻します（ScatterMotion / Refresh）。
+ * 添字はシーンのオブジェクト配列と同じです。
+ */
+struct ObjectHotData {
+    enum Flag : std::uint8_t {
+        DEAD = 1 << 0,
+        GRAVITY = 1 << 1,
+        TRIGGER = 1 << 2,
+        STATIC = 1 << 3,
+        AFFECTS_NAV = 1 << 4,
+        BODY = 1 << 5,     // 地面との押し戻しを受ける（プレイヤー・敵）
+        ECS = 1 << 6,      // 移動は ECS の MovementSystem が行う
+        SLEEPING = 1 << 7, // 静止して眠っている（積分と押し戻しを行わない）
+    };
+
+    std::vector<float> x, y;
+    std::vector<float> width, height;
+    std::vector<float> velX, velY;
+    std::vector<float> accX, accY;
+    std::vector<float> prevX, prevY;   // 積分前の位置（静的オブジェクトの移動検出と、着地の判定に使う）
+    std::vector<std::uint8_t> flags;
+
+    size_t Size() const { return flags.size(); }
+
+    bool Has(size_t i, Flag flag) const { return (flags[i] & flag) != 0; }
+
+    // オブジェクト配列から集め直す（配列は使い回す）
+    void Gather(const std::vector<std::unique_ptr<GameObject>>& objects);
+
+    // 1つのオブジェクトの値を取り直す（衝突の解決やコールバックで書き換わった後に呼ぶ。積分前の位置は変えない）
+    void Refresh(size_t i, const GameObject& obj);
+
+    // 位置・速度・加速度をオブジェクトへ書き戻す
+    void ScatterMotion(const std::vector<std::unique_ptr<GameObject>>& objects) const;
+
+    // AABB の重なり判定（Physics::CheckAABB と同じ条件）
+    bool Overlaps(size_t a, size_t b) const {
+        return x[a] < x[b] + width[b] && x[a] + width[a] > x[b] &&
+            y[a] < y[b] + height[b] && y[a] + height[a] > y[b];
+    }
+
+private:
+    static std::uint8_t MakeFlags(const GameObject& obj);
+};
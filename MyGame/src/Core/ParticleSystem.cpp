@@ -0,0 +1,302 @@
+﻿#include "ParticleSystem.h"
+#include "Camera.h"
+#include "DrawList.h"
+#include "EventBus.h"
+#include "GameEvents.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PARTICLE_USE_SSE2 1
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+ParticleSystem::ParticleSystem() {
+    // --- 着弾の火花（黄色、すぐ消える） ---
+    ParticleEmitterDesc& hit = pools[(int)ParticleEffect::Hit].desc;
+    hit.capacity = 16384;
+    hit.burstCount = 10;
+    hit.speedMin = 80.0f;
+    hit.speedMax = 260.0f;
+    hit.spreadDegrees = 120.0f;
+    hit.lifeMin = 0.15f;
+    hit.lifeMax = 0.35f;
+    hit.sizeStart = 4.0f;
+    hit.sizeEnd = 1.0f;
+    hit.gravity = 400.0f;
+    hit.drag = 3.0f;
+    hit.colorStart = { 255, 230, 120, 255 };
+    hit.colorEnd = { 255, 80, 0, 0 };
+
+    // --- 撃破（赤い破片が飛び散って落ちる） ---
+    ParticleEmitterDesc& death = pools[(int)ParticleEffect::Death].desc;
+    death.capacity = 24576;
+    death.burstCount = 40;
+    death.speedMin = 60.0f;
+    death.speedMax = 320.0f;
+    death.spreadDegrees = 360.0f;
+    death.lifeMin = 0.4f;
+    death.lifeMax = 0.9f;
+    death.sizeStart = 6.0f;
+    death.sizeEnd = 2.0f;
+    death.gravity = 600.0f;
+    death.drag = 1.5f;
+    death.colorStart = { 255, 70, 50, 255 };
+    death.colorEnd = { 90, 20, 20, 0 };
+
+    // --- 発砲炎（銃口の前方に短く広がる） ---
+    ParticleEmitterDesc& muzzle = pools[(int)ParticleEffect::MuzzleFlash].desc;
+    muzzle.capacity = 8192;
+    muzzle.burstCount = 6;
+    muzzle.speedMin = 120.0f;
+    muzzle.speedMax = 320.0f;
+    muzzle.spreadDegrees = 30.0f;
+    muzzle.lifeMin = 0.05f;
+    muzzle.lifeMax = 0.12f;
+    muzzle.sizeStart = 5.0f;
+    muzzle.sizeEnd = 2.0f;
+    muzzle.drag = 8.0f;
+    muzzle.colorStart = { 255, 255, 200, 255 };
+    muzzle.colorEnd = { 255, 150, 0, 0 };
+
+    // --- 拠点への攻撃（灰色の破片と粉塵） ---
+    ParticleEmitterDesc& baseImpact = pools[(int)ParticleEffect::BaseImpact].desc;
+    baseImpact.capacity = 16384;
+    baseImpact.burstCount = 16;
+    baseImpact.speedMin = 40.0f;
+    baseImpact.speedMax = 200.0f;
+    baseImpact.spreadDegrees = 140.0f;
+    baseImpact.lifeMin = 0.3f;
+    baseImpact.lifeMax = 0.7f;
+    baseImpact.sizeStart = 5.0f;
+    baseImpact.sizeEnd = 3.0f;
+    baseImpact.gravity = 300.0f;
+    baseImpact.drag = 2.0f;
+    baseImpact.colorStart = { 200, 200, 210, 255 };
+    baseImpact.colorEnd = { 120, 120, 130, 0 };
+
+    for (Pool& pool : pools) {
+        // SIMD でまとめて処理できるように4の倍数に切り上げる
+        size_t size = (size_t)((pool.desc.capacity + 3) & ~3);
+        pool.posX.assign(size, 0.0f);
+        pool.posY.assign(size, 0.0f);
+        pool.velX.assign(size, 0.0f);
+        pool.velY.assign(size, 0.0f);
+        pool.life.assign(size, 0.0f);
+        pool.invMaxLife.assign(size, 1.0f);
+    }
+
+    SubscribeEvents();
+}
+
+void ParticleSystem::SubscribeEvents() {
+    // 演出はイベントの購読だけで発生させる（発生元のクラスはパーティクルを知らない）
+    EventBus& bus = EventBus::GetInstance();
+    bus.Subscribe<EnemyDamagedEvent>([this](const EnemyDamagedEvent& e) {
+        if (e.killed) {
+            Emit(ParticleEffect::Death, e.x, e.y);
+        }
+        else {
+            // 被弾時は上向きに少しだけ飛び散らせる
+            Emit(ParticleEffect::Hit, e.x, e.y, -90.0f, 4);
+        }
+    });
+    bus.Subscribe<BulletImpactEvent>([this](const BulletImpactEvent& e) {
+        Emit(ParticleEffect::Hit, e.x, e.y, e.directionDegrees);
+    });
+    bus.Subscribe<ShotFiredEvent>([this](const ShotFiredEvent& e) {
+        Emit(ParticleEffect::MuzzleFlash, e.muzzleX, e.muzzleY, e.aimDegrees);
+    });
+    bus.Subscribe<BaseDamagedEvent>([this](const BaseDamagedEvent& e) {
+        Emit(ParticleEffect::BaseImpact, e.impactX, e.impactY, 0.0f);
+    });
+}
+
+float ParticleSystem::RandomRange(float minValue, float maxValue) {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    float t = (rngState & 0xFFFFFF) / (float)0x1000000;
+    return minValue + (maxValue - minValue) * t;
+}
+
+void ParticleSystem::Emit(ParticleEffect effect, float x, float y, float directionDegrees, int countOverride) {
+    Pool& pool = pools[(int)effect];
+    const ParticleEmitterDesc& desc = pool.desc;
+
+    int count = (countOverride >= 0) ? countOverride : desc.burstCount;
+    count = std::min(count, desc.capacity - pool.count);
+    if (count <= 0) return;
+
+    float baseRad = directionDegrees * (float)M_PI / 180.0f;
+    float halfSpread = desc.spreadDegrees * 0.5f * (float)M_PI / 180.0f;
+
+    for (int i = 0; i < count; ++i) {
+        int p = pool.count++;
+        float rad = baseRad + RandomRange(-halfSpread, halfSpread);
+        float speed = RandomRange(desc.speedMin, desc.speedMax);
+        float lifeTime = RandomRange(desc.lifeMin, desc.lifeMax);
+
+        pool.posX[p] = x;
+        pool.posY[p] = y;
+        pool.velX[p] = std::cos(rad) * speed;
+        pool.velY[p] = std::sin(rad) * speed;
+        pool.life[p] = lifeTime;
+        pool.invMaxLife[p] = 1.0f / lifeTime;
+    }
+}
+
+void ParticleSystem::Update(float deltaTime) {
+    if (deltaTime <= 0.0f) return;
+    for (Pool& pool : pools) {
+        if (pool.count == 0) continue;
+        IntegratePool(pool, deltaTime);
+        CompactPool(pool);
+    }
+}
+
+void ParticleSystem::IntegratePool(Pool& pool, float deltaTime) {
+    float damping = std::max(0.0f, 1.0f - pool.desc.drag * deltaTime);
+    float gravityStep = pool.desc.gravity * deltaTime;
+
+    int i = 0;
+#ifdef PARTICLE_USE_SSE2
+    // 4粒子ずつまとめて処理する（配列は4の倍数で確保済みなので端数も同じ処理で良い）
+    __m128 vDt = _mm_set1_ps(deltaTime);
+    __m128 vDamping = _mm_set1_ps(damping);
+    __m128 vGravity = _mm_set1_ps(gravityStep);
+    for (; i < pool.count; i += 4) {
+        __m128 vx = _mm_mul_ps(_mm_loadu_ps(&pool.velX[i]), vDamping);
+        __m128 vy = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&pool.velY[i]), vDamping), vGravity);
+        __m128 px = _mm_add_ps(_mm_loadu_ps(&pool.posX[i]), _mm_mul_ps(vx, vDt));
+        __m128 py = _mm_add_ps(_mm_loadu_ps(&pool.posY[i]), _mm_mul_ps(vy, vDt));
+        __m128 lf = _mm_sub_ps(_mm_loadu_ps(&pool.life[i]), vDt);
+
+        _mm_storeu_ps(&pool.velX[i], vx);
+        _mm_storeu_ps(&pool.velY[i], vy);
+        _mm_storeu_ps(&pool.posX[i], px);
+        _mm_storeu_ps(&pool.posY[i], py);
+        _mm_storeu_ps(&pool.life[i], lf);
+    }
+#else
+    for (; i < pool.count; ++i) {
+        pool.velX[i] *= damping;
+        pool.velY[i] = pool.velY[i] * damping + gravityStep;
+        pool.posX[i] += pool.velX[i] * deltaTime;
+        pool.posY[i] += pool.velY[i] * deltaTime;
+        pool.life[i] -= deltaTime;
+    }
+#endif
+}
+
+void ParticleSystem::CompactPool(Pool& pool) {
+    // 寿命が尽きた粒子は末尾の粒子で上書きして詰める（順序は保たない）
+    int i = 0;
+    while (i < pool.count) {
+        if (pool.life[i] > 0.0f) {
+            ++i;
+            continue;
+        }
+        int last = --pool.count;
+        pool.posX[i] = pool.posX[last];
+        pool.posY[i] = pool.posY[last];
+        pool.velX[i] = pool.velX[last];
+        pool.velY[i] = pool.velY[last];
+        pool.life[i] = pool.life[last];
+        pool.invMaxLife[i] = pool.invMaxLife[last];
+    }
+}
+
+void ParticleSystem::Render(DrawList& drawList, const Camera* camera) {
+    float camX = camera ? camera->x : 0.0f;
+    float camY = camera ? camera->y : 0.0f;
+    int viewW = 0, viewH = 0;
+    if (camera) {
+        viewW = camera->w;
+        viewH = camera->h;
+    }
+    else {
+        viewW = drawList.GetOutputWidth();
+        viewH = drawList.GetOutputHeight();
+    }
+
+    // テクスチャなしのジオメトリは描画色のブレンドモードを使うため、アルファ合成に切り替える
+    SDL_BlendMode prevBlend = drawList.GetDrawBlendMode();
+    drawList.SetDrawBlendMode(SDL_BLENDMODE_BLEND);
+
+    for (const Pool& pool : pools) {
+        if (pool.count == 0) continue;
+
+        vertices.clear();
+        AppendPoolGeometry(pool, camX, camY, viewW, viewH);
+        if (vertices.empty()) continue;
+
+        // 四角形ごとに 0-1-2, 2-3-0 の順で2枚の三角形を作る（インデックスは使い回す）
+        int quadCount = (int)vertices.size() / 4;
+        int needed = quadCount * 6;
+        if ((int)indices.size() < needed) {
+            int oldQuads = (int)indices.size() / 6;
+            indices.resize(needed);
+            for (int q = oldQuads; q < quadCount; ++q) {
+                int v = q * 4;
+                int* idx = &indices[q * 6];
+                idx[0] = v; idx[1] = v + 1; idx[2] = v + 2;
+                idx[3] = v + 2; idx[4] = v + 3; idx[5] = v;
+            }
+        }
+
+        drawList.Geometry(vertices.data(), (int)vertices.size(), indices.data(), needed);
+    }
+
+    drawList.SetDrawBlendMode(prevBlend);
+}
+
+void ParticleSystem::AppendPoolGeometry(const Pool& pool, float camX, float camY, int viewW, int viewH) {
+    const ParticleEmitterDesc& desc = pool.desc;
+    float maxSize = std::max(desc.sizeStart, desc.sizeEnd);
+
+    for (int i = 0; i < pool.count; ++i) {
+        float sx = pool.posX[i] - camX;
+        float sy = pool.posY[i] - camY;
+
+        // 画面外の粒子は頂点を作らない
+        if (sx < -maxSize || sy < -maxSize || sx > viewW + maxSize || sy > viewH + maxSize) continue;
+
+        // t: 0（発生直後）→ 1（消滅直前）
+        float t = 1.0f - std::clamp(pool.life[i] * pool.invMaxLife[i], 0.0f, 1.0f);
+        float half = (desc.sizeStart + (desc.sizeEnd - desc.sizeStart) * t) * 0.5f;
+
+        SDL_Color color = {
+            (Uint8)(desc.colorStart.r + (desc.colorEnd.r - desc.colorStart.r) * t),
+            (Uint8)(desc.colorStart.g + (desc.colorEnd.g - desc.colorStart.g) * t),
+            (Uint8)(desc.colorStart.b + (desc.colorEnd.b - desc.colorStart.b) * t),
+            (Uint8)(desc.colorStart.a + (desc.colorEnd.a - desc.colorStart.a) * t)
+        };
+
+        SDL_Vertex quad[4] = {
+            { { sx - half, sy - half }, color, { 0.0f, 0.0f } },
+            { { sx + half, sy - half }, color, { 0.0f, 0.0f } },
+            { { sx + half, sy + half }, color, { 0.0f, 0.0f } },
+            { { sx - half, sy + half }, color, { 0.0f, 0.0f } }
+        };
+        vertices.insert(vertices.end(), quad, quad + 4);
+    }
+}
+
+void ParticleSystem::Clear() {
+    for (Pool& pool : pools) {
+        pool.count = 0;
+    }
+}
+
+int ParticleSystem::GetActiveCount() const {
+    int total = 0;
+    for (const Pool& pool : pools) {
+        total += pool.count;
+    }
+    return total;
+}
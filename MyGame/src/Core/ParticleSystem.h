@@ -0,0 +1,99 @@
+﻿#pragma once
+#include <SDL.h>
+#include <vector>
+
+class Camera;
+class DrawList;
+
+// 発生させるエフェクトの種類（種類ごとに専用のプールを持つ）
+enum class ParticleEffect {
+    Hit = 0,        // 被弾・着弾の火花
+    Death,          // 敵の撃破
+    MuzzleFlash,    // 銃口の発砲炎
+    BaseImpact,     // 拠点への攻撃
+    Count
+};
+
+/**
+ * @brief 1種類のエフェクトの見た目と挙動の設定
+ */
+struct ParticleEmitterDesc {
+    int capacity = 4096;          // プールの最大粒子数（超えた分は発生させない）
+    int burstCount = 8;           // 1回の発生数
+    float speedMin = 50.0f;
+    float speedMax = 200.0f;
+    float spreadDegrees = 360.0f; // 発射方向を中心とした拡散角
+    float lifeMin = 0.2f;
+    float lifeMax = 0.5f;
+    float sizeStart = 4.0f;
+    float sizeEnd = 1.0f;
+    float gravity = 0.0f;         // 下向きの加速度（ピクセル/秒^2）
+    float drag = 0.0f;            // 1秒あたりの速度減衰率
+    SDL_Color colorStart = { 255, 255, 255, 255 };
+    SDL_Color colorEnd = { 255, 255, 255, 0 };
+};
+
+/**
+ * @brief 着弾・撃破・発砲などの演出用パーティクルを管理するシングルトン
+ * 粒子はエフェクトごとのプールに SoA（成分ごとの配列）で格納され、
+ * 更新は SIMD（SSE2、使えない環境ではスカラー）でまとめて行います。
+ * 描画はプールごとに1回のジオメトリ命令（SDL_RenderGeometry）にまとめるため、ソフトウェアレンダラでも大量に描けます。
+ */
+class ParticleSystem {
+public:
+    static ParticleSystem& GetInstance() {
+        static ParticleSystem instance;
+        return instance;
+    }
+
+    /**
+     * @brief 指定位置にエフェクトを発生させる
+     * @param directionDegrees 発射方向（0度が右、時計回り）。拡散角 360 のエフェクトでは無視されます
+     * @param countOverride 0 以上なら設定の発生数の代わりに使う
+     */
+    void Emit(ParticleEffect effect, float x, float y, float directionDegrees = 0.0f, int countOverride = -1);
+
+    // 全プールの粒子を進める（寿命が尽きた粒子は詰めて取り除く）
+    void Update(float deltaTime);
+
+    // カメラに映る粒子をまとめて描画する
+    void Render(DrawList& drawList, const Camera* camera);
+
+    // シーン切り替え時などに全粒子を消す
+    void Clear();
+
+    int GetActiveCount() const;
+
+    ParticleEmitterDesc& GetDesc(ParticleEffect effect) { return pools[(int)effect].desc; }
+
+private:
+    ParticleSystem();
+    ParticleSystem(const ParticleSystem&) = delete;
+    ParticleSystem& operator=(const ParticleSystem&) = delete;
+
+    // 1エフェクト分のプール（SoA）。配列は SIMD 用に4の倍数の長さで確保する
+    struct Pool {
+        ParticleEmitterDesc desc;
+        int count = 0;
+        std::vector<float> posX, posY;
+        std::vector<float> velX, velY;
+        std::vector<float> life, invMaxLife;
+    };
+
+    // 被弾・着弾・発砲などのイベントを購読して、対応するエフェクトを発生させる
+    void SubscribeEvents();
+
+    static void IntegratePool(Pool& pool, float deltaTime);
+    static void CompactPool(Pool& pool);
+    void AppendPoolGeometry(const Pool& pool, float camX, float camY, int viewW, int viewH);
+
+    // 簡易乱数（xorshift）
+    float RandomRange(float minValue, float maxValue);
+
+    Pool pools[(int)ParticleEffect::Count];
+    unsigned int rngState = 0x9E3779B9u;
+
+    // 描画用の作業バッファ（毎フレームの確保を避ける）
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+};
@@ -2,6 +2,22 @@
 #include "../Objects/GameObject.h"
 #include "../Core/Time.h"
 #include "../Core/GameParams.h" 
+#include "ObjectHotData.h"
+#include "ContactCache.h"
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#define PHYSICS_USE_SSE2 1
+// AVX2 の関数はビルド全体の設定ではなく関数単位で有効にし、実行時に CPU を確認してから呼ぶ
+#if defined(_MSC_VER)
+#define PHYSICS_USE_AVX2 1
+#define PHYSICS_TARGET_AVX2
+#elif defined(__GNUC__)
+#define PHYSICS_USE_AVX2 1
+#define PHYSICS_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
 
 void Physics::ApplyPhysics(GameObject* obj, float deltaTime) {
     if (!obj) return;
@@ -36,4 +52,228 @@ void Physics::ApplyPhysics(GameObject* obj, float deltaTime) {
     // 4. 加速度のリセット（フレームごとに外力をクリアするため）
     obj->accX = 0;
     obj->accY = 0;
-}
\ No newline at end of file
+}
+
+bool Physics::ResolveContact(GameObject* a, GameObject* b, Contact& contact, float previousBottom) {
+    // 前のフレームで上面からこの距離までにいたものは、上に乗っているものとして扱う
+    const float GROUND_SNAP = 1.0f;
+
+    float dx = (a->x + a->width / 2.0f) - (b->x + b->width / 2.0f);
+    float dy = (a->y + a->height / 2.0f) - (b->y + b->height / 2.0f);
+    float overlapX = (a->width / 2.0f) + (b->width / 2.0f) - std::abs(dx);
+    float overlapY = (a->height / 2.0f) + (b->height / 2.0f) - std::abs(dy);
+
+    // 前のフレームの向きを引き継ぐ。ただし深くめり込んでいる場合（瞬間移動など）は向きを決め直す
+    ContactNormal normal = contact.normal;
+    if (normal == ContactNormal::Ground || normal == ContactNormal::Ceiling) {
+        if (overlapY > std::min(a->height, b->height) / 2.0f) normal = ContactNormal::None;
+    }
+    else if (normal == ContactNormal::Left || normal == ContactNormal::Right) {
+        if (overlapX > std::min(a->width, b->width) / 2.0f) normal = ContactNormal::None;
+    }
+
+    if (normal == ContactNormal::None) {
+        if (previousBottom <= b->y + GROUND_SNAP) normal = ContactNormal::Ground;
+        else if (overlapX < overlapY) normal = (dx > 0) ? ContactNormal::Right : ContactNormal::Left;
+        else normal = (dy > 0) ? ContactNormal::Ceiling : ContactNormal::Ground;
+    }
+    contact.normal = normal;
+
+    // 押し戻した向きへ進んでいる速度だけを打ち消す（離れる向きの速度、例えばジャンプの初速は残す）
+    switch (normal) {
+    case ContactNormal::Ground:
+        a->y -= overlapY;
+        if (a->velY > 0) a->velY = 0;
+        return true;
+    case ContactNormal::Ceiling:
+        a->y += overlapY;
+        if (a->velY < 0) a->velY = 0;
+        return false;
+    case ContactNormal::Left:
+        a->x -= overlapX;
+        if (a->velX > 0) a->velX = 0;
+        return false;
+    case ContactNormal::Right:
+        a->x += overlapX;
+        if (a->velX < 0) a->velX = 0;
+        return false;
+    default:
+        return false;
+    }
+}
+
+namespace {
+    // ループの外で一度だけ求める値
+    struct IntegrateConstants {
+        float deltaTime;
+        float gravityStep;
+        float terminalVelocity;
+    };
+
+    // 1個分の積分（Scalar の実装と、SIMD の実装の端数の処理で使う）
+    inline void IntegrateOne(ObjectHotData& hot, size_t i, const IntegrateConstants& c) {
+        std::uint8_t flags = hot.flags[i];
+        if (flags & (ObjectHotData::DEAD | ObjectHotData::ECS | ObjectHotData::SLEEPING)) return;
+
+        bool useGravity = (flags & ObjectHotData::GRAVITY) != 0;
+        if (!useGravity && hot.velX[i] == 0.0f && hot.velY[i] == 0.0f) return;
+
+        float vx = hot.velX[i];
+        float vy = hot.velY[i];
+        if (useGravity) {
+            vy += c.gravityStep;
+            if (vy > c.terminalVelocity) vy = c.terminalVelocity;
+            else if (vy < -c.terminalVelocity) vy = -c.terminalVelocity;
+        }
+        vx += hot.accX[i] * c.deltaTime;
+        vy += hot.accY[i] * c.deltaTime;
+
+        hot.velX[i] = vx;
+        hot.velY[i] = vy;
+        hot.x[i] += vx * c.deltaTime;
+        hot.y[i] += vy * c.deltaTime;
+        hot.accX[i] = 0.0f;
+        hot.accY[i] = 0.0f;
+    }
+
+    void IntegrateScalar(ObjectHotData& hot, size_t begin, const IntegrateConstants& c) {
+        const size_t count = hot.Size();
+        for (size_t i = begin; i < count; ++i) {
+            IntegrateOne(hot, i, c);
+        }
+    }
+
+#ifdef PHYSICS_USE_SSE2
+    // 4個ずつ処理する。分岐の代わりに、積分する対象かどうかのマスクで結果と元の値を選ぶ
+    size_t IntegrateSSE2(ObjectHotData& hot, const IntegrateConstants& c) {
+        const size_t count = hot.Size();
+        const __m128 vDt = _mm_set1_ps(c.deltaTime);
+        const __m128 vGravity = _mm_set1_ps(c.gravityStep);
+        const __m128 vMaxFall = _mm_set1_ps(c.terminalVelocity);
+        const __m128 vMinFall = _mm_set1_ps(-c.terminalVelocity);
+        const __m128 vZero = _mm_setzero_ps();
+        const __m128i vSkipBits = _mm_set1_epi32(ObjectHotData::DEAD | ObjectHotData::ECS | ObjectHotData::SLEEPING);
+        const __m128i vGravityBit = _mm_set1_epi32(ObjectHotData::GRAVITY);
+        const __m128i vZeroI = _mm_setzero_si128();
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            // 4個分のフラグ（1バイトずつ）を32ビットずつに広げる
+            int packed;
+            std::memcpy(&packed, &hot.flags[i], sizeof(packed));
+            __m128i f = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(packed), vZeroI), vZeroI);
+            __m128 skip = _mm_castsi128_ps(_mm_cmpgt_epi32(_mm_and_si128(f, vSkipBits), vZeroI));
+            __m128 gravity = _mm_castsi128_ps(_mm_cmpgt_epi32(_mm_and_si128(f, vGravityBit), vZeroI));
+
+            __m128 vx = _mm_loadu_ps(&hot.velX[i]);
+            __m128 vy = _mm_loadu_ps(&hot.velY[i]);
+            __m128 moving = _mm_or_ps(gravity, _mm_or_ps(_mm_cmpneq_ps(vx, vZero), _mm_cmpneq_ps(vy, vZero)));
+            __m128 active = _mm_andnot_ps(skip, moving);
+
+            // 重力と終端速度（引数の順は Scalar の比較と同じ結果になるように選んでいる）
+            __m128 fall = _mm_max_ps(vMinFall, _mm_min_ps(vMaxFall, _mm_add_ps(vy, vGravity)));
+            __m128 vy1 = _mm_or_ps(_mm_and_ps(gravity, fall), _mm_andnot_ps(gravity, vy));
+
+            __m128 ax = _mm_loadu_ps(&hot.accX[i]);
+            __m128 ay = _mm_loadu_ps(&hot.accY[i]);
+            __m128 nvx = _mm_add_ps(vx, _mm_mul_ps(ax, vDt));
+            __m128 nvy = _mm_add_ps(vy1, _mm_mul_ps(ay, vDt));
+            __m128 px = _mm_loadu_ps(&hot.x[i]);
+            __m128 py = _mm_loadu_ps(&hot.y[i]);
+            __m128 npx = _mm_add_ps(px, _mm_mul_ps(nvx, vDt));
+            __m128 npy = _mm_add_ps(py, _mm_mul_ps(nvy, vDt));
+
+            _mm_storeu_ps(&hot.velX[i], _mm_or_ps(_mm_and_ps(active, nvx), _mm_andnot_ps(active, vx)));
+            _mm_storeu_ps(&hot.velY[i], _mm_or_ps(_mm_and_ps(active, nvy), _mm_andnot_ps(active, vy)));
+            _mm_storeu_ps(&hot.x[i], _mm_or_ps(_mm_and_ps(active, npx), _mm_andnot_ps(active, px)));
+            _mm_storeu_ps(&hot.y[i], _mm_or_ps(_mm_and_ps(active, npy), _mm_andnot_ps(active, py)));
+            _mm_storeu_ps(&hot.accX[i], _mm_andnot_ps(active, ax));
+            _mm_storeu_ps(&hot.accY[i], _mm_andnot_ps(active, ay));
+        }
+        return i;
+    }
+#endif
+
+#ifdef PHYSICS_USE_AVX2
+    // 8個ずつ処理する（計算の手順は SSE2 版と同じ）
+    PHYSICS_TARGET_AVX2 size_t IntegrateAVX2(ObjectHotData& hot, const IntegrateConstants& c) {
+        const size_t count = hot.Size();
+        const __m256 vDt = _mm256_set1_ps(c.deltaTime);
+        const __m256 vGravity = _mm256_set1_ps(c.gravityStep);
+        const __m256 vMaxFall = _mm256_set1_ps(c.terminalVelocity);
+        const __m256 vMinFall = _mm256_set1_ps(-c.terminalVelocity);
+        const __m256 vZero = _mm256_setzero_ps();
+        const __m256i vSkipBits = _mm256_set1_epi32(ObjectHotData::DEAD | ObjectHotData::ECS | ObjectHotData::SLEEPING);
+        const __m256i vGravityBit = _mm256_set1_epi32(ObjectHotData::GRAVITY);
+        const __m256i vZeroI = _mm256_setzero_si256();
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m256i f = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(&hot.flags[i])));
+            __m256 skip = _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_and_si256(f, vSkipBits), vZeroI));
+            __m256 gravity = _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_and_si256(f, vGravityBit), vZeroI));
+
+            __m256 vx = _mm256_loadu_ps(&hot.velX[i]);
+            __m256 vy = _mm256_loadu_ps(&hot.velY[i]);
+            __m256 moving = _mm256_or_ps(gravity, _mm256_or_ps(
+                _mm256_cmp_ps(vx, vZero, _CMP_NEQ_UQ), _mm256_cmp_ps(vy, vZero, _CMP_NEQ_UQ)));
+            __m256 active = _mm256_andnot_ps(skip, moving);
+
+            __m256 fall = _mm256_max_ps(vMinFall, _mm256_min_ps(vMaxFall, _mm256_add_ps(vy, vGravity)));
+            __m256 vy1 = _mm256_blendv_ps(vy, fall, gravity);
+
+            __m256 ax = _mm256_loadu_ps(&hot.accX[i]);
+            __m256 ay = _mm256_loadu_ps(&hot.accY[i]);
+            __m256 nvx = _mm256_add_ps(vx, _mm256_mul_ps(ax, vDt));
+            __m256 nvy = _mm256_add_ps(vy1, _mm256_mul_ps(ay, vDt));
+            __m256 px = _mm256_loadu_ps(&hot.x[i]);
+            __m256 py = _mm256_loadu_ps(&hot.y[i]);
+            __m256 npx = _mm256_add_ps(px, _mm256_mul_ps(nvx, vDt));
+            __m256 npy = _mm256_add_ps(py, _mm256_mul_ps(nvy, vDt));
+
+            _mm256_storeu_ps(&hot.velX[i], _mm256_blendv_ps(vx, nvx, active));
+            _mm256_storeu_ps(&hot.velY[i], _mm256_blendv_ps(vy, nvy, active));
+            _mm256_storeu_ps(&hot.x[i], _mm256_blendv_ps(px, npx, active));
+            _mm256_storeu_ps(&hot.y[i], _mm256_blendv_ps(py, npy, active));
+            _mm256_storeu_ps(&hot.accX[i], _mm256_andnot_ps(active, ax));
+            _mm256_storeu_ps(&hot.accY[i], _mm256_andnot_ps(active, ay));
+        }
+        return i;
+    }
+#endif
+}
+
+Physics::IntegratePath Physics::GetBestIntegratePath() {
+#ifdef PHYSICS_USE_AVX2
+    static const bool hasAVX2 = SDL_HasAVX2() == SDL_TRUE;
+    if (hasAVX2) return IntegratePath::AVX2;
+#endif
+#ifdef PHYSICS_USE_SSE2
+    return IntegratePath::SSE2;
+#else
+    return IntegratePath::Scalar;
+#endif
+}
+
+void Physics::IntegrateHot(ObjectHotData& hot, float deltaTime, IntegratePath path) {
+    // 設定はループの外で一度だけ読む
+    const GameParams& params = GameParams::GetInstance();
+    IntegrateConstants constants;
+    constants.deltaTime = deltaTime;
+    constants.gravityStep = params.physics.gravity * PhysicsSettings::GravityScale * deltaTime;
+    constants.terminalVelocity = params.physics.terminalVelocity;
+
+    // 指定された実装が使えない場合は使えるものに落とす
+    IntegratePath best = GetBestIntegratePath();
+    if (path == IntegratePath::Auto || (int)path > (int)best) path = best;
+
+    size_t done = 0;
+#ifdef PHYSICS_USE_AVX2
+    if (path == IntegratePath::AVX2) done = IntegrateAVX2(hot, constants);
+#endif
+#ifdef PHYSICS_USE_SSE2
+    if (path == IntegratePath::SSE2) done = IntegrateSSE2(hot, constants);
+#endif
+    // 端数（Scalar の場合はすべて）
+    IntegrateScalar(hot, done, constants);
+}
@@ -7,12 +7,32 @@
 
 // 前方宣言
 class Game;
+struct ObjectHotData;
+struct Contact;
 
 class Physics {
 public:
     // 物理演算の適用（重力と終端速度の計算を含む）
     static void ApplyPhysics(GameObject* obj, float deltaTime);
 
+    // IntegrateHot の実装の選択（Auto は実行中の CPU で使える最も速いもの）
+    enum class IntegratePath {
+        Auto,
+        Scalar,
+        SSE2,
+        AVX2,
+    };
+
+    /**
+     * @brief 配列にまとめたオブジェクトの重力・加速度・速度をまとめて積分する（ApplyPhysics と同じ計算）
+     * 削除済みのもの・ECS が移動を担当するもの・眠っているものは飛ばします。止まっていて重力も受けないものは変更しません。
+     * SSE2 では4個ずつ、AVX2 に対応した CPU では8個ずつ処理します。どの実装でも結果は Scalar と一致します。
+     */
+    static void IntegrateHot(ObjectHotData& hot, float deltaTime, IntegratePath path = IntegratePath::Auto);
+
+    // この環境で Auto が選ぶ実装（ビルドが対応していない実装は選ばれない）
+    static IntegratePath GetBestIntegratePath();
+
     // --- 衝突判定ロジック ---
 
     static bool CheckAABB(GameObject* a, GameObject* b) {
@@ -68,19 +88,16 @@ public:
     }
 
     /**
-     * @brief 衝突解決（押し戻し処理）
-     * @return true: 下方向に衝突（着地）した / false: それ以外
+     * @brief 押し戻しを行う組かどうか（どちらかが Trigger の場合は地面との組だけ物理的にぶつかる）
      */
-    static bool ResolveCollision(GameObject* a, GameObject* b) {
-        if (!CheckAABB(a, b)) return false;
-
+    static bool IsSolidPair(GameObject* a, GameObject* b) {
         // --- 修正点: Trigger（通り抜け）の判定ロジック ---
         // どちらかがTrigger設定されている場合
         if (a->isTrigger || b->isTrigger) {
             // 基本的には押し戻さないが、「地面（Block）」との判定時のみ物理的にぶつかる
             // 名前で地面かどうかを判定する（dynamic_castによる循環参照を避けるため）
-            bool aIsGround = (a->name == "Block" || a->name == "Editor Ground");
-            bool bIsGround = (b->name == "Block" || b->name == "Editor Ground");
+            bool aIsGround = (a->name == ObjectNames::Block || a->name == ObjectNames::EditorGround);
+            bool bIsGround = (b->name == ObjectNames::Block || b->name == ObjectNames::EditorGround);
 
             // aがTriggerの場合、bが地面でなければ無視
             if (a->isTrigger && !bIsGround) return false;
@@ -90,6 +107,25 @@ public:
             // 両方Triggerなら当然無視
             if (a->isTrigger && b->isTrigger) return false;
         }
+        return true;
+    }
+
+    /**
+     * @brief 前のフレームから続く接触の向きを使って a を押し戻す（a と b は重なっていること）
+     * 初めての接触では、積分前の a の下端が b の上面より上にあれば着地とみなします（並んだブロックの継ぎ目で
+     * 横に押し戻されないようにするため）。それ以外は重なりの少ない軸で押し戻し、決まった向きを contact に残します。
+     * @param previousBottom 積分前の a の下端の座標
+     * @return true: 着地している / false: それ以外
+     */
+    static bool ResolveContact(GameObject* a, GameObject* b, Contact& contact, float previousBottom);
+
+    /**
+     * @brief 衝突解決（押し戻し処理）
+     * @return true: 下方向に衝突（着地）した / false: それ以外
+     */
+    static bool ResolveCollision(GameObject* a, GameObject* b) {
+        if (!CheckAABB(a, b)) return false;
+        if (!IsSolidPair(a, b)) return false;
 
         // --- 以下の押し戻し処理は、上記のフィルタを通過した（＝物理的にぶつかるべき）場合のみ実行される ---
 
@@ -0,0 +1,225 @@
+﻿#include "RenderThread.h"
+#include "DrawList.h"
+#include "Logger.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+
+namespace {
+    // Invoke で頼まれた処理（頼んだ側は終わるまで待つので、スタック上のものを指す）
+    struct Task {
+        const std::function<void()>* fn = nullptr;
+        bool finished = false;
+    };
+
+    std::thread worker;
+    std::thread::id workerId;
+    std::mutex mutex;
+    std::condition_variable wake;       // 描画スレッドを起こす
+    std::condition_variable progress;   // フレームや依頼の完了を待つ側を起こす
+
+    // 以下は mutex で守る
+    bool running = false;
+    bool ready = false;
+    bool stopRequested = false;
+    const DrawList* pending = nullptr;  // 渡されたが表示し終えていないフレーム
+    std::deque<Task*> tasks;
+    std::vector<std::function<void()>> graveyard;   // 描画中のフレームが終わってから行う後始末
+    int outputWidth = 0;
+    int outputHeight = 0;
+
+    // 描画スレッドが作り、開始後は変わらない
+    SDL_Renderer* renderer = nullptr;
+    bool targetSupported = false;
+
+    bool OnRenderThread() {
+        return std::this_thread::get_id() == workerId;
+    }
+
+    // 後回しにした破棄を行う（描画スレッドから、フレームを描いていない時に呼ぶ）
+    void DestroyGraveyard(std::unique_lock<std::mutex>& lock) {
+        if (graveyard.empty()) return;
+        std::vector<std::function<void()>> deferred;
+        deferred.swap(graveyard);
+        lock.unlock();
+        for (const auto& fn : deferred) {
+            fn();
+        }
+        lock.lock();
+    }
+
+    void Run(SDL_Window* window, Uint32 rendererFlags) {
+        SDL_Renderer* created = SDL_CreateRenderer(window, -1, rendererFlags);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            workerId = std::this_thread::get_id();
+            renderer = created;
+            if (created) {
+                targetSupported = SDL_RenderTargetSupported(created) == SDL_TRUE;
+                SDL_GetRendererOutputSize(created, &outputWidth, &outputHeight);
+            }
+            ready = true;
+        }
+        progress.notify_all();
+        if (!created) return;
+
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            wake.wait(lock, []() {
+                return stopRequested || pending || !tasks.empty() || !graveyard.empty();
+            });
+
+            // 依頼はフレームの間に処理する（頼んだ側は待っているので、その間に扱うデータは書き換わらない）
+            while (!tasks.empty()) {
+                Task* task = tasks.front();
+                tasks.pop_front();
+                lock.unlock();
+                (*task->fn)();
+                lock.lock();
+                task->finished = true;
+                progress.notify_all();
+            }
+
+            if (pending) {
+                const DrawList* list = pending;
+                lock.unlock();
+
+                list->Execute(created);
+                SDL_RenderPresent(created);
+
+                int width = 0, height = 0;
+                SDL_GetRendererOutputSize(created, &width, &height);
+
+                lock.lock();
+                outputWidth = width;
+                outputHeight = height;
+                pending = nullptr;
+                progress.notify_all();
+            }
+
+            // 表示し終えたフレームが参照していたテクスチャをここで破棄する
+            DestroyGraveyard(lock);
+
+            if (stopRequested && !pending && tasks.empty()) break;
+        }
+
+        DestroyGraveyard(lock);
+        renderer = nullptr;
+        lock.unlock();
+        SDL_DestroyRenderer(created);
+    }
+}
+
+bool RenderThread::Start(SDL_Window* window, Uint32 rendererFlags) {
+    if (!window) return false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (running) return true;
+        ready = false;
+        stopRequested = false;
+    }
+
+    worker = std::thread(Run, window, rendererFlags);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    progress.wait(lock, []() { return ready; });
+    if (!renderer) {
+        lock.unlock();
+        worker.join();
+        workerId = std::thread::id();
+        LOG_ERROR(LogCategory::General, "Failed to create renderer: " << SDL_GetError());
+        return false;
+    }
+    running = true;
+    return true;
+}
+
+void RenderThread::Stop() {
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!running) return;
+        progress.wait(lock, []() { return pending == nullptr; });
+        stopRequested = true;
+        running = false;
+    }
+    wake.notify_one();
+    worker.join();
+    workerId = std::thread::id();
+}
+
+bool RenderThread::IsRunning() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return running;
+}
+
+SDL_Renderer* RenderThread::GetRenderer() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return renderer;
+}
+
+bool RenderThread::RenderTargetSupported() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return targetSupported;
+}
+
+void RenderThread::GetOutputSize(int* width, int* height) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (width) *width = outputWidth;
+    if (height) *height = outputHeight;
+}
+
+void RenderThread::Invoke(const std::function<void()>& fn) {
+    if (!fn) return;
+    if (OnRenderThread()) {
+        fn();
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    if (!running) {
+        lock.unlock();
+        fn();
+        return;
+    }
+
+    Task task;
+    task.fn = &fn;
+    tasks.push_back(&task);
+    wake.notify_one();
+    progress.wait(lock, [&task]() { return task.finished; });
+}
+
+void RenderThread::DestroyTexture(SDL_Texture* texture) {
+    if (!texture) return;
+    Defer([texture]() { SDL_DestroyTexture(texture); });
+}
+
+void RenderThread::Defer(std::function<void()> fn) {
+    if (!fn) return;
+    if (!OnRenderThread()) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (running) {
+            graveyard.push_back(std::move(fn));
+            wake.notify_one();
+            return;
+        }
+    }
+    fn();
+}
+
+void RenderThread::Submit(const DrawList* list) {
+    if (!list) return;
+    std::unique_lock<std::mutex> lock(mutex);
+    if (!running) return;
+    progress.wait(lock, []() { return pending == nullptr; });
+    pending = list;
+    wake.notify_one();
+}
+
+void RenderThread::WaitIdle() {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (!running) return;
+    progress.wait(lock, []() { return pending == nullptr; });
+}
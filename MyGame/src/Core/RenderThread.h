@@ -0,0 +1,59 @@
+﻿#pragma once
+#include <SDL.h>
+#include <functional>
+
+class DrawList;
+
+/**
+ * @brief SDL_Renderer を持ち、記録済みの DrawList を実行して画面に出す描画スレッド
+ * メインスレッドは DrawList を記録して Submit で渡すだけなので、フレーム N の表示（VSYNC 待ちを含む）と
+ * フレーム N+1 のシミュレーションが並行して進みます。ウィンドウとイベント処理はメインスレッドに残ります。
+ * レンダラーを使う処理（テクスチャの作成・更新）は Invoke で描画スレッドに頼み、
+ * テクスチャの破棄は DestroyTexture で描画中のフレームが終わるまで遅らせます。
+ * Start() の前と Stop() の後は、どちらも呼び出したスレッドでその場で実行します（計測用の単体実行など）。
+ */
+class RenderThread {
+public:
+    // 描画スレッドを開始し、そのスレッドで window のレンダラーを作る（作れなければ false）
+    static bool Start(SDL_Window* window, Uint32 rendererFlags);
+
+    // 渡したフレームを描き終え、残りの依頼と破棄を済ませてからレンダラーを破棄して止める
+    static void Stop();
+
+    static bool IsRunning();
+
+    // 描画スレッドのレンダラー（テクスチャを作る関数に渡すためのもの。描画スレッド以外で描画に使わない）
+    static SDL_Renderer* GetRenderer();
+
+    // レンダーターゲットが使えるか（開始時に一度だけ調べる）
+    static bool RenderTargetSupported();
+
+    // 出力先の大きさ（開始時と各フレームの表示後に更新される）
+    static void GetOutputSize(int* width, int* height);
+
+    /**
+     * @brief fn を描画スレッドで実行し、終わるまで待つ
+     * 描画スレッドはフレームとフレームの間で依頼を処理するため、最大で1フレーム分待ちます。
+     * 描画スレッド自身から呼んだ場合や、描画スレッドが動いていない場合はその場で実行します。
+     */
+    static void Invoke(const std::function<void()>& fn);
+
+    // テクスチャを、描画中のフレームが終わった後で破棄する
+    static void DestroyTexture(SDL_Texture* texture);
+
+    // 描画中のフレームが終わった後で fn を描画スレッドで実行する（待たない。描画スレッドが使うものの後始末に使う）
+    static void Defer(std::function<void()> fn);
+
+    /**
+     * @brief 記録の終わったリストを渡す
+     * 前に渡したフレームの表示が終わるまで待ってから渡します。渡したリストは
+     * 次の Submit から戻るまで描画スレッドが読むため、その間は書き換えないでください（2つを交互に使う）。
+     */
+    static void Submit(const DrawList* list);
+
+    // 渡したフレームの表示が終わるまで待つ
+    static void WaitIdle();
+
+private:
+    RenderThread() = delete;
+};
@@ -0,0 +1,132 @@
+﻿#include "SpatialHash.h"
+#include "../Objects/GameObject.h"
+#include <algorithm>
+#include <cmath>
+
+int SpatialHash::ToCell(float value) {
+    return (int)std::floor(value / CELL_SIZE);
+}
+
+SpatialHash::CellRange SpatialHash::RangeOf(const GameObject* obj) {
+    CellRange range;
+    if (!obj || obj->isDead) return range;
+    range.minCX = ToCell(obj->x);
+    range.minCY = ToCell(obj->y);
+    range.maxCX = ToCell(obj->x + obj->width);
+    range.maxCY = ToCell(obj->y + obj->height);
+    return range;
+}
+
+void SpatialHash::Build(const std::vector<std::unique_ptr<GameObject>>& objects) {
+    source = &objects;
+
+    // セルの配列は使い回す（毎回の確保を避ける）
+    for (auto& pair : cells) {
+        pair.second.clear();
+    }
+
+    // インデックスの昇順に追加するので、各セルは並べ替えなしで昇順になる
+    ranges.resize(objects.size());
+    for (int i = 0; i < (int)objects.size(); ++i) {
+        ranges[i] = RangeOf(objects[i].get());
+        const CellRange& range = ranges[i];
+        for (int cy = range.minCY; cy <= range.maxCY; ++cy) {
+            for (int cx = range.minCX; cx <= range.maxCX; ++cx) {
+                cells[MakeGridKey(cx, cy)].push_back(i);
+            }
+        }
+    }
+
+    visitStamp.assign(objects.size(), 0);
+    currentStamp = 0;
+}
+
+void SpatialHash::Refresh() {
+    if (!source) return;
+    if (ranges.size() != source->size()) {
+        // 通知なしに一覧が変わっていた場合は作り直す
+        Build(*source);
+        return;
+    }
+
+    // セルの範囲が変わらない移動（同じセル内での移動）はそのままでよい（検索時に実際の矩形で判定する）
+    for (int i = 0; i < (int)ranges.size(); ++i) {
+        CellRange range = RangeOf((*source)[i].get());
+        if (range == ranges[i]) continue;
+        Erase(i, ranges[i]);
+        Insert(i, range);
+        ranges[i] = range;
+    }
+}
+
+void SpatialHash::Insert(int index, const CellRange& range) {
+    for (int cy = range.minCY; cy <= range.maxCY; ++cy) {
+        for (int cx = range.minCX; cx <= range.maxCX; ++cx) {
+            std::vector<int>& cell = cells[MakeGridKey(cx, cy)];
+            cell.insert(std::lower_bound(cell.begin(), cell.end(), index), index);
+        }
+    }
+}
+
+void SpatialHash::Erase(int index, const CellRange& range) {
+    for (int cy = range.minCY; cy <= range.maxCY; ++cy) {
+        for (int cx = range.minCX; cx <= range.maxCX; ++cx) {
+            auto it = cells.find(MakeGridKey(cx, cy));
+            if (it == cells.end()) continue;
+            std::vector<int>& cell = it->second;
+            auto pos = std::lower_bound(cell.begin(), cell.end(), index);
+            if (pos != cell.end() && *pos == index) cell.erase(pos);
+        }
+    }
+}
+
+void SpatialHash::QueryPoint(float x, float y, std::vector<int>& outIndices) const {
+    outIndices.clear();
+    if (!source) return;
+
+    auto it = cells.find(MakeGridKey(ToCell(x), ToCell(y)));
+    if (it == cells.end()) return;
+
+    // 1点は1セルにしか属さないので重複は起きない。セル内はインデックスの昇順に並んでいる
+    for (int index : it->second) {
+        const GameObject* obj = (*source)[index].get();
+        if (x >= obj->x && x <= obj->x + obj->width &&
+            y >= obj->y && y <= obj->y + obj->height) {
+            outIndices.push_back(index);
+        }
+    }
+}
+
+void SpatialHash::QueryRect(const SDL_FRect& rect, std::vector<int>& outIndices) const {
+    outIndices.clear();
+    if (!source) return;
+
+    if (++currentStamp == 0) {
+        std::fill(visitStamp.begin(), visitStamp.end(), 0);
+        currentStamp = 1;
+    }
+
+    int minCX = ToCell(rect.x);
+    int minCY = ToCell(rect.y);
+    int maxCX = ToCell(rect.x + rect.w);
+    int maxCY = ToCell(rect.y + rect.h);
+    for (int cy = minCY; cy <= maxCY; ++cy) {
+        for (int cx = minCX; cx <= maxCX; ++cx) {
+            auto it = cells.find(MakeGridKey(cx, cy));
+            if (it == cells.end()) continue;
+
+            for (int index : it->second) {
+                if (visitStamp[index] == currentStamp) continue;
+                visitStamp[index] = currentStamp;
+
+                const GameObject* obj = (*source)[index].get();
+                if (obj->x < rect.x + rect.w && obj->x + obj->width > rect.x &&
+                    obj->y < rect.y + rect.h && obj->y + obj->height > rect.y) {
+                    outIndices.push_back(index);
+                }
+            }
+        }
+    }
+
+    std::sort(outIndices.begin(), outIndices.end());
+}
@@ -0,0 +1,60 @@
+﻿#pragma once
+#include <SDL.h>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include "GridKey.h"
+
+class GameObject;
+
+/**
+ * @brief オブジェクトを一定サイズのセルに振り分けた空間インデックス（一様グリッドのハッシュ）
+ * 点や矩形に重なるオブジェクトを、全オブジェクトを走査せずに周辺のセルだけから探せます。
+ * 結果はシーンのオブジェクト配列のインデックスで、配列内の順序（＝描画順）の昇順に並びます。
+ */
+class SpatialHash {
+public:
+    // 1セルの一辺（ワールド座標のピクセル数）
+    static constexpr int CELL_SIZE = 128;
+
+    /**
+     * @brief オブジェクト配列から作り直す（削除済みのオブジェクトは含めない）
+     */
+    void Build(const std::vector<std::unique_ptr<GameObject>>& objects);
+
+    /**
+     * @brief 前回の Build / Refresh の後に動いた・消えたオブジェクトだけセルを移し替える
+     * 配列の並び（追加・削除）が変わっていない時に使います。変わった場合は Build で作り直してください。
+     */
+    void Refresh();
+
+    // 点を含むオブジェクトのインデックスを集める
+    void QueryPoint(float x, float y, std::vector<int>& outIndices) const;
+
+    // 矩形に重なるオブジェクトのインデックスを集める（重複なし）
+    void QueryRect(const SDL_FRect& rect, std::vector<int>& outIndices) const;
+
+private:
+    // 登録したセルの範囲（min > max なら未登録）
+    struct CellRange {
+        int minCX = 0, minCY = 0, maxCX = -1, maxCY = -1;
+        bool operator==(const CellRange& other) const {
+            return minCX == other.minCX && minCY == other.minCY && maxCX == other.maxCX && maxCY == other.maxCY;
+        }
+    };
+
+    static int ToCell(float value);
+    static CellRange RangeOf(const GameObject* obj);
+
+    // セル内はインデックスの昇順を保つ
+    void Insert(int index, const CellRange& range);
+    void Erase(int index, const CellRange& range);
+
+    const std::vector<std::unique_ptr<GameObject>>* source = nullptr;
+    std::unordered_map<unsigned long long, std::vector<int>> cells;
+    std::vector<CellRange> ranges;  // 配列のインデックスごとに登録したセルの範囲
+
+    // 複数セルにまたがるオブジェクトの重複を除くための作業領域
+    mutable std::vector<unsigned int> visitStamp;
+    mutable unsigned int currentStamp = 0;
+};
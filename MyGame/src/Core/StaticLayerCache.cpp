@@ -0,0 +1,131 @@
+﻿#include "StaticLayerCache.h"
+#include "Camera.h"
+#include "DrawList.h"
+#include "../Objects/GameObject.h"
+
+void StaticLayerCache::MarkDirty(const SDL_Rect& worldRect) {
+    int minCX = ToChunk(worldRect.x);
+    int minCY = ToChunk(worldRect.y);
+    int maxCX = ToChunk(worldRect.x + worldRect.w);
+    int maxCY = ToChunk(worldRect.y + worldRect.h);
+
+    for (int cy = minCY; cy <= maxCY; ++cy) {
+        for (int cx = minCX; cx <= maxCX; ++cx) {
+            auto it = chunks.find(MakeGridKey(cx, cy));
+            if (it != chunks.end()) {
+                it->second.dirty = true;
+            }
+        }
+    }
+}
+
+void StaticLayerCache::InvalidateAll(bool releaseTextures) {
+    if (releaseTextures) {
+        chunks.clear();
+        return;
+    }
+    for (auto& pair : chunks) {
+        pair.second.dirty = true;
+    }
+}
+
+void StaticLayerCache::Render(DrawList& drawList, Camera* camera,
+    const std::vector<std::unique_ptr<GameObject>>& objects) {
+    if (!camera) return;
+
+    // レンダーターゲットが使えない場合は従来通り1つずつ描画する
+    if (!RenderThread::RenderTargetSupported()) {
+        RenderDirect(drawList, camera, objects);
+        return;
+    }
+
+    // カメラに映っているチャンクの範囲
+    int minCX = ToChunk((int)camera->x);
+    int minCY = ToChunk((int)camera->y);
+    int maxCX = ToChunk((int)camera->x + camera->w);
+    int maxCY = ToChunk((int)camera->y + camera->h);
+
+    for (int cy = minCY; cy <= maxCY; ++cy) {
+        for (int cx = minCX; cx <= maxCX; ++cx) {
+            Chunk& chunk = chunks[MakeGridKey(cx, cy)];
+            if (chunk.dirty) {
+                RebuildChunk(drawList, chunk, cx, cy, objects);
+            }
+            if (chunk.empty || !chunk.texture) continue;
+
+            SDL_Rect dest = {
+                cx * CHUNK_SIZE - (int)camera->x,
+                cy * CHUNK_SIZE - (int)camera->y,
+                CHUNK_SIZE, CHUNK_SIZE
+            };
+            drawList.Copy(chunk.texture.get(), NULL, &dest);
+        }
+    }
+}
+
+void StaticLayerCache::RebuildChunk(DrawList& drawList, Chunk& chunk, int cx, int cy,
+    const std::vector<std::unique_ptr<GameObject>>& objects) {
+    chunk.dirty = false;
+
+    SDL_Rect chunkRect = { cx * CHUNK_SIZE, cy * CHUNK_SIZE, CHUNK_SIZE, CHUNK_SIZE };
+
+    // このチャンクに重なる静的オブジェクトがあるか先に調べる（空チャンクはテクスチャを持たない）
+    bool hasContent = false;
+    for (const auto& obj : objects) {
+        if (!obj || !obj->isStatic || obj->isDead) continue;
+        SDL_Rect objRect = { (int)obj->x, (int)obj->y, obj->width, obj->height };
+        if (SDL_HasIntersection(&chunkRect, &objRect)) {
+            hasContent = true;
+            break;
+        }
+    }
+
+    chunk.empty = !hasContent;
+    if (chunk.empty) {
+        chunk.texture.reset();
+        return;
+    }
+
+    if (!chunk.texture) {
+        // テクスチャの作成だけは描画スレッドで済ませておく
+        SDL_Texture* created = nullptr;
+        RenderThread::Invoke([&created]() {
+            created = SDL_CreateTexture(RenderThread::GetRenderer(), SDL_PIXELFORMAT_RGBA8888,
+                SDL_TEXTUREACCESS_TARGET, CHUNK_SIZE, CHUNK_SIZE);
+            if (created) SDL_SetTextureBlendMode(created, SDL_BLENDMODE_BLEND);
+        });
+        chunk.texture.reset(created);
+        if (!chunk.texture) {
+            chunk.empty = true;
+            return;
+        }
+    }
+
+    SDL_Texture* prevTarget = drawList.GetTarget();
+    drawList.SetTarget(chunk.texture.get());
+
+    // 透明でクリアしてから、チャンク原点を映すカメラで焼き込む
+    drawList.SetDrawColor(0, 0, 0, 0);
+    drawList.Clear();
+
+    Camera chunkCamera(CHUNK_SIZE, CHUNK_SIZE);
+    chunkCamera.x = (float)chunkRect.x;
+    chunkCamera.y = (float)chunkRect.y;
+
+    for (const auto& obj : objects) {
+        if (!obj || !obj->isStatic || obj->isDead) continue;
+        SDL_Rect objRect = { (int)obj->x, (int)obj->y, obj->width, obj->height };
+        if (SDL_HasIntersection(&chunkRect, &objRect)) {
+            obj->RenderWithCamera(drawList, &chunkCamera);
+        }
+    }
+
+    drawList.SetTarget(prevTarget);
+}
+
+void StaticLayerCache::RenderDirect(DrawList& drawList, Camera* camera,
+    const std::vector<std::unique_ptr<GameObject>>& objects) {
+    for (const auto& obj : objects) {
+        if (obj && obj->isStatic) obj->RenderWithCamera(drawList, camera);
+    }
+}
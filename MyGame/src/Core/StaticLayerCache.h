@@ -0,0 +1,71 @@
+﻿#pragma once
+#include <SDL.h>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include "RenderThread.h"
+#include "GridKey.h"
+
+class GameObject;
+class Camera;
+class DrawList;
+
+/**
+ * @brief 動かないオブジェクト（地面 Block など）をチャンク単位のテクスチャに焼き込むキャッシュ
+ * 各チャンクは一度だけ描画され、エディタで中身が変更された時のみ再生成されます。
+ * メイン描画ではカメラに映っているチャンクだけを転送します。
+ */
+class StaticLayerCache {
+public:
+    // 1チャンクの一辺（ワールド座標のピクセル数）
+    static constexpr int CHUNK_SIZE = 512;
+
+    StaticLayerCache() = default;
+    ~StaticLayerCache() = default;
+
+    /**
+     * @brief 指定範囲（ワールド座標）に重なるチャンクを再描画対象にする
+     */
+    void MarkDirty(const SDL_Rect& worldRect);
+
+    /**
+     * @brief 全チャンクを再描画対象にする
+     * @param releaseTextures true の場合はテクスチャ自体も破棄する（デバイスロスト時）
+     */
+    void InvalidateAll(bool releaseTextures = false);
+
+    /**
+     * @brief カメラに映るチャンクを描画する（必要ならその場で再生成）
+     * 再生成はチャンクのテクスチャを描画先にした命令として記録し、描画スレッドで焼き込まれます。
+     * レンダーターゲット非対応の環境では静的オブジェクトを直接描画します。
+     */
+    void Render(DrawList& drawList, Camera* camera,
+        const std::vector<std::unique_ptr<GameObject>>& objects);
+
+private:
+    struct TextureDeleter {
+        void operator()(SDL_Texture* t) const {
+            if (t) RenderThread::DestroyTexture(t);
+        }
+    };
+    using ChunkTexturePtr = std::unique_ptr<SDL_Texture, TextureDeleter>;
+
+    struct Chunk {
+        ChunkTexturePtr texture;
+        bool dirty = true;
+        bool empty = true; // 静的オブジェクトが1つも重なっていない
+    };
+
+    // 負の座標でも正しく切り捨てるチャンク座標変換
+    static int ToChunk(int worldPos) {
+        return (worldPos >= 0) ? worldPos / CHUNK_SIZE : -((-worldPos + CHUNK_SIZE - 1) / CHUNK_SIZE);
+    }
+
+    void RebuildChunk(DrawList& drawList, Chunk& chunk, int cx, int cy,
+        const std::vector<std::unique_ptr<GameObject>>& objects);
+
+    void RenderDirect(DrawList& drawList, Camera* camera,
+        const std::vector<std::unique_ptr<GameObject>>& objects);
+
+    std::unordered_map<unsigned long long, Chunk> chunks;
+};
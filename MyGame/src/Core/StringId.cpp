@@ -0,0 +1,66 @@
+﻿#include "StringId.h"
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+    // 文字列の表（静的初期化の順序に左右されないよう、最初に使った時に作る）
+    struct Table {
+        std::mutex mutex;
+        std::deque<std::string> strings;   // 番号 -> 文字列（deque なので追加しても参照は動かない）
+        std::unordered_map<std::string, std::uint32_t> ids;
+
+        Table() {
+            strings.emplace_back();
+            ids.emplace(std::string(), 0u);
+        }
+    };
+
+    Table& GetTable() {
+        static Table table;
+        return table;
+    }
+
+    std::uint32_t Intern(const char* text, size_t length) {
+        if (length == 0) return 0;
+        Table& table = GetTable();
+        std::lock_guard<std::mutex> lock(table.mutex);
+        std::string key(text, length);
+        auto it = table.ids.find(key);
+        if (it != table.ids.end()) return it->second;
+
+        std::uint32_t value = (std::uint32_t)table.strings.size();
+        table.strings.push_back(key);
+        table.ids.emplace(std::move(key), value);
+        return value;
+    }
+}
+
+StringId::StringId(const char* text)
+    : value(text ? Intern(text, std::char_traits<char>::length(text)) : 0)
+{
+}
+
+StringId::StringId(const std::string& text)
+    : value(Intern(text.data(), text.size()))
+{
+}
+
+StringId StringId::Find(const std::string& text) {
+    Table& table = GetTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    auto it = table.ids.find(text);
+    return (it != table.ids.end()) ? StringId(it->second) : StringId();
+}
+
+size_t StringId::GetRegisteredCount() {
+    Table& table = GetTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    return table.strings.size();
+}
+
+const std::string& StringId::str() const {
+    Table& table = GetTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    return table.strings[value];
+}
@@ -0,0 +1,59 @@
+﻿#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <ostream>
+#include <functional>
+
+/**
+ * @brief 全体で1つの表に登録（インターン）した文字列の番号
+ * 同じ文字列は必ず同じ番号になるため、比較とハッシュは整数1つで済みます。
+ * 表を引くのは文字列から作る時だけなので、毎フレーム比べる名前は static const で一度だけ作っておいてください。
+ * 文字列との == は毎回表を引いてしまうため、わざと使えなくしてあります。
+ * 番号 0 は空文字列です。登録した文字列は終了まで解放しません（登録はどのスレッドからでも可）。
+ */
+class StringId {
+public:
+    StringId() = default;
+    StringId(const char* text);
+    StringId(const std::string& text);
+
+    // 登録済みの文字列なら番号を返す。未登録なら表に追加せず空の StringId を返す
+    static StringId Find(const std::string& text);
+
+    // 登録されている文字列の数（空文字列を含む）
+    static size_t GetRegisteredCount();
+
+    std::uint32_t GetValue() const { return value; }
+    bool empty() const { return value == 0; }
+
+    // 登録された文字列（参照は終了まで有効）
+    const std::string& str() const;
+    const char* c_str() const { return str().c_str(); }
+
+    bool operator==(StringId other) const { return value == other.value; }
+    bool operator!=(StringId other) const { return value != other.value; }
+    // 登録順の比較（map のキー用。表示用に文字列順が欲しい場合は str() を比べる）
+    bool operator<(StringId other) const { return value < other.value; }
+
+    bool operator==(const char*) const = delete;
+    bool operator!=(const char*) const = delete;
+    bool operator==(const std::string&) const = delete;
+    bool operator!=(const std::string&) const = delete;
+
+private:
+    explicit StringId(std::uint32_t value) : value(value) {}
+
+    std::uint32_t value = 0;
+};
+
+inline std::ostream& operator<<(std::ostream& os, StringId id) {
+    return os << id.str();
+}
+
+namespace std {
+    template <>
+    struct hash<StringId> {
+        size_t operator()(StringId id) const noexcept { return std::hash<std::uint32_t>()(id.GetValue()); }
+    };
+}
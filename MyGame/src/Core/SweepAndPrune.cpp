@@ -0,0 +1,141 @@
+﻿#include "SweepAndPrune.h"
+#include "ObjectHotData.h"
+#include "../Objects/GameObject.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    const std::uint32_t REMOVED = 0xFFFFFFFFu;
+
+    // 新しく並びに加わった数がこれより多い場合は、挿入ソートではなくまとめて並べ直す
+    const size_t MAX_INSERTIONS = 64;
+}
+
+void SweepAndPrune::Reset() {
+    order.clear();
+    previous.clear();
+}
+
+size_t SweepAndPrune::CarryOver(const std::vector<std::unique_ptr<GameObject>>& objects) {
+    const size_t count = objects.size();
+
+    // 削除は順序を保ったまま詰められ、追加は末尾に入るため、前から順に照らし合わせれば対応が分かる
+    remap.assign(previous.size(), REMOVED);
+    size_t next = 0;
+    for (size_t k = 0; k < previous.size() && next < count; ++k) {
+        if (objects[next].get() == previous[k]) remap[k] = (std::uint32_t)next++;
+    }
+
+    placed.assign(count, 0);
+    size_t kept = 0;
+    for (std::uint32_t index : order) {
+        std::uint32_t mapped = index < remap.size() ? remap[index] : REMOVED;
+        if (mapped == REMOVED || placed[mapped]) continue;
+        placed[mapped] = 1;
+        order[kept++] = mapped;
+    }
+    order.resize(kept);
+
+    // 新しいもの（と、外部で並びが変えられて対応が取れなかったもの）は末尾に加える
+    for (size_t i = 0; i < count; ++i) {
+        if (!placed[i]) order.push_back((std::uint32_t)i);
+    }
+
+    previous.resize(count);
+    for (size_t i = 0; i < count; ++i) previous[i] = objects[i].get();
+    return kept;
+}
+
+void SweepAndPrune::Update(const std::vector<std::unique_ptr<GameObject>>& objects, const ObjectHotData& hot) {
+    const size_t count = objects.size();
+    size_t carried = count;
+    bool unchanged = previous.size() == count;
+    for (size_t i = 0; unchanged && i < count; ++i) unchanged = previous[i] == objects[i].get();
+    if (!unchanged) carried = CarryOver(objects);
+
+    // 並べ替えのキー（NaN は順序を壊すので先頭に寄せる。どのオブジェクトとも重ならない）
+    minX.resize(count);
+    for (size_t k = 0; k < count; ++k) {
+        float x = hot.x[order[k]];
+        minX[k] = std::isnan(x) ? -INFINITY : x;
+    }
+
+    if (count - carried > MAX_INSERTIONS) {
+        // 一度に多く加わった場合（シーンの開始やウェーブの出現）はまとめて並べ直す
+        std::sort(order.begin(), order.end(), [&hot](std::uint32_t a, std::uint32_t b) {
+            float xa = std::isnan(hot.x[a]) ? -INFINITY : hot.x[a];
+            float xb = std::isnan(hot.x[b]) ? -INFINITY : hot.x[b];
+            return xa < xb;
+        });
+        for (size_t k = 0; k < count; ++k) {
+            float x = hot.x[order[k]];
+            minX[k] = std::isnan(x) ? -INFINITY : x;
+        }
+    }
+    else {
+        // 前のフレームの並びはほぼ整列済みなので、挿入ソートで直す
+        for (size_t k = 1; k < count; ++k) {
+            float key = minX[k];
+            std::uint32_t index = order[k];
+            size_t m = k;
+            while (m > 0 && minX[m - 1] > key) {
+                minX[m] = minX[m - 1];
+                order[m] = order[m - 1];
+                --m;
+            }
+            minX[m] = key;
+            order[m] = index;
+        }
+    }
+
+    // 左から順に見て、まだ右端に達していないもの（active）とだけ組にする
+    // 眠っているもの同士はどちらも動かないので組にしない（眠っているものは sleepingActive に分けておく）
+    pairs.clear();
+    active.clear();
+    sleepingActive.clear();
+    auto sweep = [&](std::vector<std::uint32_t>& list, std::uint32_t index, float left) {
+        for (size_t a = 0; a < list.size();) {
+            std::uint32_t other = list[a];
+            if (hot.x[other] + hot.width[other] <= left) {
+                list[a] = list.back();
+                list.pop_back();
+                continue;
+            }
+            pairs.push_back(other);
+            pairs.push_back(index);
+            ++a;
+        }
+    };
+    for (size_t k = 0; k < count; ++k) {
+        std::uint32_t index = order[k];
+        float left = minX[k];
+        float right = hot.x[index] + hot.width[index];
+        if (std::isnan(right)) continue;
+
+        sweep(active, index, left);
+        if (hot.Has(index, ObjectHotData::SLEEPING)) {
+            sleepingActive.push_back(index);
+        }
+        else {
+            sweep(sleepingActive, index, left);
+            active.push_back(index);
+        }
+    }
+
+    // 組をオブジェクトごとの候補の一覧にする（総当たりと同じ順で処理できるよう添字の昇順に並べる）
+    candidateStart.assign(count + 1, 0);
+    for (std::uint32_t index : pairs) ++candidateStart[index + 1];
+    for (size_t i = 0; i < count; ++i) candidateStart[i + 1] += candidateStart[i];
+
+    candidates.resize(pairs.size());
+    remap.assign(candidateStart.begin(), candidateStart.end() - 1);
+    for (size_t p = 0; p < pairs.size(); p += 2) {
+        std::uint32_t a = pairs[p];
+        std::uint32_t b = pairs[p + 1];
+        candidates[remap[a]++] = b;
+        candidates[remap[b]++] = a;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        std::sort(candidates.begin() + candidateStart[i], candidates.begin() + candidateStart[i + 1]);
+    }
+}
@@ -0,0 +1,58 @@
+﻿#pragma once
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+class GameObject;
+struct ObjectHotData;
+
+/**
+ * @brief X 軸方向の区間で当たり判定の候補を絞り込む（sort and sweep）
+ * オブジェクトを左端の座標で並べ、左から順に見ていきながら区間が重なっているものだけを候補にします。
+ * 並び順はフレームをまたいで使い回し、挿入ソートで直します。多くのオブジェクトは1フレームで
+ * 少ししか動かないため、並べ直しはほぼオブジェクト数に比例する時間で終わります。
+ * 横に長いステージでは総当たりに比べて調べる組が大幅に減ります。
+ * 眠っている（ObjectHotData::SLEEPING）もの同士の組は候補にしません。
+ */
+class SweepAndPrune {
+public:
+    // 候補の添字の並び（範囲 for で使う）
+    struct Range {
+        const std::uint32_t* first;
+        const std::uint32_t* last;
+        const std::uint32_t* begin() const { return first; }
+        const std::uint32_t* end() const { return last; }
+    };
+
+    /**
+     * @brief 候補を求め直す（hot は objects から集めた直後のもの）
+     * 前回からの追加・削除は、前回のオブジェクトの並びと比べて並び順に反映します。
+     */
+    void Update(const std::vector<std::unique_ptr<GameObject>>& objects, const ObjectHotData& hot);
+
+    // i と X 方向の区間が重なる候補（添字の昇順。本当に重なっているかは呼び出し側で確認する）
+    Range Candidates(size_t i) const {
+        const std::uint32_t* base = candidates.data();
+        return { base + candidateStart[i], base + candidateStart[i + 1] };
+    }
+
+    // 前回の並び順を捨てる（次の Update で並べ直す）
+    void Reset();
+
+private:
+    // 前回のオブジェクトの並びから、今回の添字へ並び順を引き継ぐ（戻り値は引き継げた数。残りは末尾に加わる）
+    size_t CarryOver(const std::vector<std::unique_ptr<GameObject>>& objects);
+
+    std::vector<std::uint32_t> order;          // 左端の座標の昇順に並べたオブジェクトの添字
+    std::vector<const GameObject*> previous;   // 前回 Update した時のオブジェクトの並び
+
+    // 作業用（毎フレーム使い回す）
+    std::vector<float> minX;
+    std::vector<std::uint32_t> remap;
+    std::vector<std::uint8_t> placed;
+    std::vector<std::uint32_t> active;
+    std::vector<std::uint32_t> sleepingActive;
+    std::vector<std::uint32_t> pairs;          // 2つずつ組で入れる
+    std::vector<std::uint32_t> candidateStart;
+    std::vector<std::uint32_t> candidates;
+};
@@ -8,6 +8,21 @@ public:
     // フレームの最初に呼び出して時間を更新する関数
     static void Update();
 
+    /**
+     * @brief 生きている間だけ deltaTime を差し替え、破棄時に元の値へ戻す（早送りの固定ステップなど）
+     * 差し替えと復元を1か所にまとめるため、途中で抜ける経路があっても戻し忘れません。
+     */
+    class ScopedDeltaTime {
+    public:
+        explicit ScopedDeltaTime(float stepSeconds) : saved(deltaTime) { deltaTime = stepSeconds; }
+        ~ScopedDeltaTime() { deltaTime = saved; }
+        ScopedDeltaTime(const ScopedDeltaTime&) = delete;
+        ScopedDeltaTime& operator=(const ScopedDeltaTime&) = delete;
+
+    private:
+        float saved;
+    };
+
 private:
     // 前回のフレームの時刻（ミリ秒）
     static unsigned int lastFrameTime;
@@ -1,5 +1,7 @@
 ﻿#include "Game.h"
 #include "Time.h"
+#include "Benchmark.h"
+#include "Logger.h"
 #include "../Scenes/Scene.h" 
 #include "../Objects/GameObject.h" 
 #include "Game.h"
@@ -8,6 +10,11 @@
 Game* game = nullptr;
 
 int main(int argc, char* argv[]) {
+    // --bench が指定された場合は計測だけ行って終了する
+    if (Benchmark::RunFromCommandLine(argc, argv)) {
+        return 0;
+    }
+
     // FPS制御用の定数 (60FPSを目指す)
     const int FPS = 60;
     const int frameDelay = 1000 / FPS; // 1フレームあたりの目標時間 (約16ms)
@@ -15,6 +22,9 @@ int main(int argc, char* argv[]) {
     Uint32 frameStart;
     int frameTime;
 
+    // ログの書き出しはバックグラウンドスレッドで行う
+    Logger::Start();
+
     game = new Game();
 
     // 初期化
@@ -47,5 +57,8 @@ int main(int argc, char* argv[]) {
     game->Clean();
     delete game; // newしたのでdeleteも忘れずに
 
+    // 残っているログを書き出してから終了する
+    Logger::Shutdown();
+
     return 0;
 }
\ No newline at end of file
@@ -3,16 +3,20 @@
 #include "imgui_impl_sdl2.h"
 #include "imgui_impl_sdlrenderer2.h"
 #include <string>
-#include <iostream>
 #include <map>
 #include <vector>
 #include <algorithm> 
 #include <cstring> 
+#include <cstdio>
+#include <functional>
+#include <unordered_map>
 #include <filesystem> 
 #include <windows.h>
 #include <commdlg.h> 
 
 #include "../Core/Game.h"
+#include "../Core/DrawList.h"
+#include "../Core/RenderThread.h"
 #include "../Core/GameParams.h" 
 #include "../Core/GameSession.h"
 #include "../Scenes/Scene.h"
@@ -22,19 +26,28 @@
 #include "../Objects/Enemy.h"
 #include "../Objects/Base.h"
 #include "../Core/ConfigManager.h" 
+#include "../Core/ConfigHotReloader.h"
+#include "../Core/Logger.h"
+#include <ctime>
 
 // Shorten filesystem namespace
 namespace fs = std::filesystem;
 
 // Static member definitions
 GameObject* EditorGUI::selectedObject = nullptr;
+std::vector<GameObject*> EditorGUI::selectedObjects;
 EditorGUI::Mode EditorGUI::currentMode = EditorGUI::Mode::GAME;
 EditorGUI::ConfigViewMode EditorGUI::currentConfigView = EditorGUI::ConfigViewMode::NONE;
 bool EditorGUI::isTestMode = false;
 bool EditorGUI::isWaveSimMode = false;
 int EditorGUI::simLevelID = 1;
+int EditorGUI::simTimeScale = 1;
+bool EditorGUI::runToWaveEnd = false;
+bool EditorGUI::showEnemyRoutes = false;
+UndoStack EditorGUI::undoStack;
 
 // --- Forward declarations of helper functions ---
+static void RemoveFromHierarchyCache(GameObject* obj);
 static void DrawPlayerConfigPanel(GameParams& params);
 static void DrawGunConfigPanel(GameParams& params, SDL_Renderer* renderer, Scene* currentScene);
 static void DrawEnemyConfigPanel(GameParams& params, SDL_Renderer* renderer, Scene* currentScene, Game* game);
@@ -53,7 +66,8 @@ void EditorGUI::Init(SDL_Window* window, SDL_Renderer* renderer) {
 
     ImGui::StyleColorsDark();
 
-    ImGui_ImplSDL2_InitForSDLRenderer(window, renderer);
+    // レンダラーは描画スレッドが使っているため、プラットフォーム側には渡さずウィンドウから大きさを取る
+    ImGui_ImplSDL2_InitForOther(window);
     ImGui_ImplSDLRenderer2_Init(renderer);
 
     GameParams& params = GameParams::GetInstance();
@@ -65,13 +79,80 @@ void EditorGUI::HandleEvents(SDL_Event* event) {
 }
 
 void EditorGUI::Clean() {
-    ImGui_ImplSDLRenderer2_Shutdown();
+    // フォントのテクスチャを破棄するため描画スレッドで行う
+    RenderThread::Invoke([]() { ImGui_ImplSDLRenderer2_Shutdown(); });
     ImGui_ImplSDL2_Shutdown();
     ImGui::DestroyContext();
 }
 
 void EditorGUI::SetMode(Mode newMode) {
     currentMode = newMode;
+    // 履歴はシーンとレンダラーを参照しているため、シーンを出入りする時に破棄する
+    undoStack.Clear();
+}
+
+void EditorGUI::SelectObject(GameObject* obj, bool additive) {
+    if (!additive) {
+        selectedObjects.clear();
+        selectedObject = nullptr;
+    }
+    if (!obj) return;
+
+    auto it = std::find(selectedObjects.begin(), selectedObjects.end(), obj);
+    if (it != selectedObjects.end()) {
+        // 追加選択で選択済みのものを指定したら外す
+        if (additive) {
+            selectedObjects.erase(it);
+            if (selectedObject == obj) {
+                selectedObject = selectedObjects.empty() ? nullptr : selectedObjects.back();
+            }
+        }
+        return;
+    }
+    selectedObjects.push_back(obj);
+    selectedObject = obj;
+}
+
+void EditorGUI::SelectObjects(const std::vector<GameObject*>& objects, bool additive) {
+    if (!additive) {
+        selectedObjects.clear();
+        selectedObject = nullptr;
+    }
+    for (GameObject* obj : objects) {
+        if (!obj || IsSelected(obj)) continue;
+        selectedObjects.push_back(obj);
+    }
+    if (!selectedObject && !selectedObjects.empty()) {
+        selectedObject = selectedObjects.front();
+    }
+}
+
+void EditorGUI::ClearSelection() {
+    selectedObjects.clear();
+    selectedObject = nullptr;
+}
+
+bool EditorGUI::IsSelected(const GameObject* obj) {
+    return std::find(selectedObjects.begin(), selectedObjects.end(), obj) != selectedObjects.end();
+}
+
+void EditorGUI::OnObjectRemoved(GameObject* obj) {
+    RemoveFromHierarchyCache(obj);
+
+    auto it = std::find(selectedObjects.begin(), selectedObjects.end(), obj);
+    if (it == selectedObjects.end()) return;
+    selectedObjects.erase(it);
+    if (selectedObject == obj) {
+        selectedObject = selectedObjects.empty() ? nullptr : selectedObjects.back();
+    }
+}
+
+void EditorGUI::Undo() {
+    undoStack.Undo();
+}
+
+void EditorGUI::Redo() {
+    undoStack.Redo();
 }
 
 std::string EditorGUI::ImportTexture() {
@@ -101,7 +182,7 @@ std::string EditorGUI::ImportTexture() {
             return destPath;
         }
         catch (const fs::filesystem_error& e) {
-            std::cerr << "File system error: " << e.what() << std::endl;
+            LOG_ERROR(LogCategory::Editor, "File system error: " << e.what());
         }
     }
     return "";
@@ -109,47 +190,194 @@ std::string EditorGUI::ImportTexture() {
 
 static void NotifyPlayerGunChanged(SDL_Renderer* renderer, Scene* currentScene) {
     if (!currentScene) return;
-    auto& objects = currentScene->GetObjects();
-    for (auto& obj : objects) {
-        Player* player = dynamic_cast<Player*>(obj.get());
-        if (player) {
-            player->RefreshGunConfig(renderer);
-        }
-    }
+    currentScene->ApplyConfigChange(ConfigSection::Gun, renderer);
 }
 
 static void NotifyEnemyConfigChanged(SDL_Renderer* renderer, Scene* currentScene) {
     if (!currentScene) return;
-    auto& objects = currentScene->GetObjects();
-    for (auto& obj : objects) {
-        Enemy* enemy = dynamic_cast<Enemy*>(obj.get());
-        if (enemy) {
-            enemy->RefreshConfig(renderer);
-        }
-    }
+    currentScene->ApplyConfigChange(ConfigSection::Enemy, renderer);
 }
 
 static void NotifyBaseConfigChanged(SDL_Renderer* renderer, Scene* currentScene) {
     if (!currentScene) return;
-    auto& objects = currentScene->GetObjects();
-    for (auto& obj : objects) {
-        Base* b = dynamic_cast<Base*>(obj.get());
-        if (b) {
-            b->RefreshConfig(renderer);
+    currentScene->ApplyConfigChange(ConfigSection::Base, renderer);
+    GameSession::GetInstance().maxBaseHP = GameParams::GetInstance().base.maxHealth;
+}
+
+// 取り消し履歴の上限判定用に、値が持つ文字列や配列の中身も含めたおおよそのサイズを返す
+template <typename T>
+static size_t ApproxByteSize(const T&) { return sizeof(T); }
+static size_t ApproxByteSize(const GunParams& value) { return sizeof(value) + value.texturePath.size(); }
+static size_t ApproxByteSize(const BaseParams& value) { return sizeof(value) + value.texturePath.size(); }
+static size_t ApproxByteSize(const EnemyParams& value) {
+    return sizeof(value) + value.texturePath.size() + value.bulletTexturePath.size();
+}
+static size_t ApproxByteSize(const LevelParams& value) {
+    size_t size = sizeof(value) + value.lanes.size() * sizeof(SpawnLane);
+    for (const WaveParams& wave : value.waves) {
+        size += sizeof(wave) + wave.spawns.size() * sizeof(EnemySpawnEntry);
+    }
+    return size;
+}
+
+/**
+ * @brief パネルで編集される設定セクション（GunParams など）の変更を取り消し履歴に記録する
+ * 前回記録した値（基準）を型ごとに保持し、破棄時に operator== で比べて変わっていれば変更前後をコマンドとして積みます。
+ * 生成時も基準と比べ、取り消しやホットリロードなどパネルの外で変わっていた場合は記録せずに基準だけ取り直します。
+ * 値の複製は変更があった時だけなので、パネルを開いているだけなら毎フレームの比較2回で済みます。
+ * アクティブなプリセット名も一緒に記録するので、プリセットの切り替えも1回で元に戻せます。
+ * 基準は型ごとに1つなので、1つの型は1つのパネルでだけ使います。
+ */
+template <typename T>
+class SectionEditScope {
+public:
+    SectionEditScope(const char* label, std::function<T*()> resolve,
+        std::string* presetName = nullptr, std::function<void()> onApplied = nullptr)
+        : label(label), resolve(std::move(resolve)), presetName(presetName), onApplied(std::move(onApplied)) {
+        T* section = this->resolve();
+        valid = (section != nullptr);
+        if (valid && !MatchesBaseline(*section)) {
+            TakeBaseline(*section);
         }
     }
-    GameSession::GetInstance().maxBaseHP = GameParams::GetInstance().base.maxHealth;
+
+    ~SectionEditScope() {
+        T* section = resolve();
+        if (!valid || !section || MatchesBaseline(*section)) return;
+
+        Snapshot before = baseline;
+        TakeBaseline(*section);
+        Snapshot after = baseline;
+
+        auto apply = [resolve = resolve, namePtr = presetName, notify = onApplied](const Snapshot& snapshot) {
+            T* target = resolve();
+            if (!target) return;
+            *target = snapshot.value;
+            if (namePtr) *namePtr = snapshot.presetName;
+            if (notify) notify();
+        };
+
+        UndoStack::Command command;
+        command.label = label;
+        command.byteSize = sizeof(UndoStack::Command) + ApproxByteSize(before.value) + ApproxByteSize(after.value) +
+            before.presetName.size() + after.presetName.size();
+        command.undo = [apply, snapshot = std::move(before)]() { apply(snapshot); };
+        command.redo = [apply, snapshot = std::move(after)]() { apply(snapshot); };
+        EditorGUI::GetUndoStack().Push(std::move(command), section);
+    }
+
+    // 別のコマンドとして記録済みの変更（プリセット保存など）を二重に記録しないよう、比較の基準を今の値にする
+    void Rebase() {
+        T* section = resolve();
+        valid = (section != nullptr);
+        if (valid) TakeBaseline(*section);
+    }
+
+private:
+    struct Snapshot {
+        T value;
+        std::string presetName;
+    };
+
+    bool MatchesBaseline(const T& section) const {
+        return hasBaseline && baseline.value == section &&
+            (!presetName || baseline.presetName == *presetName);
+    }
+
+    void TakeBaseline(const T& section) {
+        baseline.value = section;
+        baseline.presetName = presetName ? *presetName : std::string();
+        hasBaseline = true;
+    }
+
+    // 前回記録した（またはパネルの外での変更後に取り直した）値
+    static inline Snapshot baseline;
+    static inline bool hasBaseline = false;
+
+    const char* label;
+    std::function<T*()> resolve;
+    std::string* presetName;
+    std::function<void()> onApplied;
+    bool valid = false;
+};
+
+// プリセットの保存を、上書き前の内容ごと取り消し履歴に記録する
+template <typename T>
+static void SavePresetWithUndo(const char* label, std::map<std::string, T>& presets,
+    std::string& activeName, const std::string& name, const T& value) {
+    auto it = presets.find(name);
+    bool existed = (it != presets.end());
+    T oldValue = existed ? it->second : T();
+    std::string oldActive = activeName;
+
+    presets[name] = value;
+    activeName = name;
+
+    std::map<std::string, T>* presetsPtr = &presets;
+    std::string* activePtr = &activeName;
+
+    UndoStack::Command command;
+    command.label = label;
+    command.undo = [presetsPtr, activePtr, name, existed, oldValue, oldActive]() {
+        if (existed) (*presetsPtr)[name] = oldValue;
+        else presetsPtr->erase(name);
+        *activePtr = oldActive;
+    };
+    command.redo = [presetsPtr, activePtr, name, value]() {
+        (*presetsPtr)[name] = value;
+        *activePtr = name;
+    };
+    command.byteSize = sizeof(UndoStack::Command) + ApproxByteSize(oldValue) + ApproxByteSize(value) +
+        name.size() * 2 + oldActive.size();
+    EditorGUI::GetUndoStack().Push(std::move(command));
 }
 
-void EditorGUI::Render(SDL_Renderer* renderer, Scene* currentScene, Game* game) {
+// インスペクターで編集できるオブジェクトの状態
+struct ObjectEditState {
+    float x, y;
+    int width, height;
+    bool useGravity;
+    float velX, velY;
+
+    static ObjectEditState Capture(const GameObject* obj) {
+        return { obj->x, obj->y, obj->width, obj->height, obj->useGravity, obj->velX, obj->velY };
+    }
+
+    bool operator==(const ObjectEditState& other) const {
+        return x == other.x && y == other.y && width == other.width && height == other.height &&
+            useGravity == other.useGravity && velX == other.velX && velY == other.velY;
+    }
+};
+
+// オブジェクトは取り消す時点で id から探し直す（削除済みなら何もしない）
+static void ApplyObjectEditState(Scene* scene, unsigned int objectId, const ObjectEditState& state) {
+    if (!scene) return;
+    GameObject* obj = scene->FindObjectById(objectId);
+    if (!obj) return;
+
+    SDL_Rect before = { (int)obj->x, (int)obj->y, obj->width, obj->height };
+    obj->x = state.x;
+    obj->y = state.y;
+    obj->width = state.width;
+    obj->height = state.height;
+    obj->useGravity = state.useGravity;
+    obj->velX = state.velX;
+    obj->velY = state.velY;
+    scene->NotifyObjectChanged(obj, before);
+}
+
+void EditorGUI::Render(DrawList& drawList, Scene* currentScene, Game* game) {
+    // パネルからの設定変更でテクスチャを読み込む時に使う
+    SDL_Renderer* renderer = game ? game->GetRenderer() : nullptr;
+
     ImGui_ImplSDLRenderer2_NewFrame();
     ImGui_ImplSDL2_NewFrame();
     ImGui::NewFrame();
 
     if (currentMode == Mode::EDITOR) {
         DrawHierarchy(currentScene);
-        DrawInspector();
-        DrawParameters();
+        DrawInspector(currentScene);
+        DrawParameters(game);
 
         if (currentConfigView != ConfigViewMode::NONE) {
             GameParams& params = GameParams::GetInstance();
@@ -178,7 +406,7 @@ void EditorGUI::Render(SDL_Renderer* renderer, Scene* currentScene, Game* game)
                 case ConfigViewMode::PHYSICS: DrawPhysicsConfigPanel(params); break;
                 case ConfigViewMode::CAMERA:  DrawCameraConfigPanel(params);  break;
                 case ConfigViewMode::BASE:    DrawBaseConfigPanel(params, renderer, currentScene); break;
-                case ConfigViewMode::WAVE:    DrawWaveConfigPanel(params); break;
+                case ConfigViewMode::WAVE:    DrawWaveConfigPanel(params, currentScene); break;
                 default: break;
                 }
                 ImGui::End();
@@ -186,8 +414,88 @@ void EditorGUI::Render(SDL_Renderer* renderer, Scene* currentScene, Game* game)
         }
     }
 
+    // ドラッグや入力が終わったら、次の変更は別の操作として記録する
+    if (!ImGui::IsAnyItemActive()) {
+        undoStack.Seal();
+    }
+
     ImGui::Render();
-    ImGui_ImplSDLRenderer2_RenderDrawData(ImGui::GetDrawData(), renderer);
+    drawList.SubmitImGui(ImGui::GetDrawData());
+}
+
+// 階層ビューの表示用キャッシュ
+// Update 内の追加・削除は OnObjectAdded / OnObjectRemoved でその分だけ反映し、
+// 作り直すのは一覧がまとめて変わった時（シーンの切り替えなど）と検索文字列が変わった時だけにする
+struct HierarchyGroup {
+    const char* typeName;
+    std::vector<GameObject*> objects;
+    std::unordered_map<const GameObject*, size_t> indexOf;  // objects 内の位置（削除を定数時間で行う）
+    std::string header;  // "Bullet (2314)" のような見出し
+    bool headerDirty = true;
+};
+
+static struct {
+    unsigned int structureVersion = 0;
+    std::string filterText;
+    ImGuiTextFilter filter;
+    std::vector<HierarchyGroup> groups;
+} hierarchyCache;
+
+static HierarchyGroup& FindOrAddHierarchyGroup(const char* typeName) {
+    for (HierarchyGroup& group : hierarchyCache.groups) {
+        if (group.typeName == typeName || std::strcmp(group.typeName, typeName) == 0) return group;
+    }
+    hierarchyCache.groups.push_back({ typeName, {}, {}, "" });
+    return hierarchyCache.groups.back();
+}
+
+// 種類ごとのグループの末尾に加える（文字列の生成は見出しだけで、行ごとには行わない）
+static void AddToHierarchyCache(GameObject* obj) {
+    if (hierarchyCache.filter.IsActive() && !hierarchyCache.filter.PassFilter(obj->name.c_str())) return;
+
+    HierarchyGroup& group = FindOrAddHierarchyGroup(obj->GetTypeName());
+    if (!group.indexOf.emplace(obj, group.objects.size()).second) return;
+    group.objects.push_back(obj);
+    group.headerDirty = true;
+}
+
+// 末尾の要素と入れ替えて取り除く（グループ内の並びは変わる）
+static void RemoveFromHierarchyCache(GameObject* obj) {
+    for (HierarchyGroup& group : hierarchyCache.groups) {
+        auto it = group.indexOf.find(obj);
+        if (it == group.indexOf.end()) continue;
+
+        size_t index = it->second;
+        group.indexOf.erase(it);
+        if (index + 1 != group.objects.size()) {
+            group.objects[index] = group.objects.back();
+            group.indexOf[group.objects[index]] = index;
+        }
+        group.objects.pop_back();
+        group.headerDirty = true;
+        return;
+    }
+}
+
+static void RebuildHierarchyCache(Scene* currentScene) {
+    for (HierarchyGroup& group : hierarchyCache.groups) {
+        group.objects.clear();
+        group.indexOf.clear();
+    }
+    for (auto& obj : currentScene->GetObjects()) {
+        if (obj) AddToHierarchyCache(obj.get());
+    }
+
+    // 空になった種類は消す
+    hierarchyCache.groups.erase(std::remove_if(hierarchyCache.groups.begin(), hierarchyCache.groups.end(),
+        [](const HierarchyGroup& group) { return group.objects.empty(); }), hierarchyCache.groups.end());
+
+    hierarchyCache.structureVersion = currentScene->GetStructureVersion();
+    hierarchyCache.filterText = hierarchyCache.filter.InputBuf;
+}
+
+void EditorGUI::OnObjectAdded(GameObject* obj) {
+    AddToHierarchyCache(obj);
 }
 
 void EditorGUI::DrawHierarchy(Scene* currentScene) {
@@ -195,51 +503,146 @@ void EditorGUI::DrawHierarchy(Scene* currentScene) {
     ImGui::SetNextWindowSize(ImVec2(220, 780), ImGuiCond_Once);
 
     ImGui::Begin("Hierarchy", nullptr, ImGuiWindowFlags_NoCollapse);
+    hierarchyCache.filter.Draw("Filter", -1.0f);
+    ImGui::Separator();
+
     if (currentScene) {
-        auto& objects = currentScene->GetObjects();
-        int index = 0;
-        for (auto& obj : objects) {
-            if (!obj) continue;
-            ImGui::PushID(index);
-            std::string label = obj->name.empty() ? "Object " + std::to_string(index) : obj->name;
-            if (ImGui::Selectable(label.c_str(), selectedObject == obj.get())) {
-                selectedObject = obj.get();
+        if (hierarchyCache.structureVersion != currentScene->GetStructureVersion() ||
+            hierarchyCache.filterText != hierarchyCache.filter.InputBuf) {
+            RebuildHierarchyCache(currentScene);
+        }
+
+        // 見えている行だけを ImGuiListClipper で描画する（弾が数千発あっても表示行数分のコストで済む）
+        char fallbackLabel[32];
+        for (HierarchyGroup& group : hierarchyCache.groups) {
+            if (group.objects.empty()) continue;
+            if (group.headerDirty) {
+                group.header = std::string(group.typeName) + " (" + std::to_string(group.objects.size()) + ")";
+                group.headerDirty = false;
             }
-            ImGui::PopID();
-            index++;
+            ImGui::SetNextItemOpen(group.objects.size() <= 64, ImGuiCond_Once);
+            if (!ImGui::TreeNode(group.typeName, "%s", group.header.c_str())) continue;
+
+            ImGuiListClipper clipper;
+            clipper.Begin((int)group.objects.size());
+            while (clipper.Step()) {
+                for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+                    GameObject* obj = group.objects[i];
+                    ImGui::PushID((int)obj->id);
+
+                    const char* label = obj->name.c_str();
+                    if (obj->name.empty()) {
+                        std::snprintf(fallbackLabel, sizeof(fallbackLabel), "Object %u", obj->id);
+                        label = fallbackLabel;
+                    }
+                    if (ImGui::Selectable(label, IsSelected(obj))) {
+                        SelectObject(obj, ImGui::GetIO().KeyCtrl);
+                    }
+                    // 右クリックメニューからの削除（選択はシーンから取り除かれる時に解除される）
+                    if (ImGui::BeginPopupContextItem()) {
+                        if (ImGui::MenuItem("Delete")) {
+                            obj->isDead = true;
+                        }
+                        ImGui::EndPopup();
+                    }
+                    ImGui::PopID();
+                }
+            }
+            ImGui::TreePop();
         }
     }
     ImGui::End();
 }
 
-void EditorGUI::DrawInspector() {
+void EditorGUI::DrawInspector(Scene* currentScene) {
     ImGui::SetNextWindowPos(ImVec2(890, 10), ImGuiCond_Once);
     ImGui::SetNextWindowSize(ImVec2(300, 350), ImGuiCond_Once);
 
     ImGui::Begin("Inspector", nullptr, ImGuiWindowFlags_NoCollapse);
     if (selectedObject) {
-        if (selectedObject->isDead) { selectedObject = nullptr; ImGui::End(); return; }
+        if (selectedObject->isDead) { OnObjectRemoved(selectedObject); ImGui::End(); return; }
         ImGui::TextColored(ImVec4(0.4f, 0.8f, 1.0f, 1.0f), "Target: %s", selectedObject->name.c_str());
+        if (selectedObjects.size() > 1) {
+            ImGui::TextDisabled("+ %d more selected (edits apply to all)", (int)selectedObjects.size() - 1);
+        }
         ImGui::Separator();
+
+        // 主選択を編集し、変化分を他の選択中のオブジェクトにも適用する
+        std::vector<ObjectEditState> beforeStates;
+        beforeStates.reserve(selectedObjects.size());
+        for (GameObject* obj : selectedObjects) {
+            beforeStates.push_back(ObjectEditState::Capture(obj));
+        }
+        ObjectEditState beforeEdit = ObjectEditState::Capture(selectedObject);
+
         if (ImGui::CollapsingHeader("Transform", ImGuiTreeNodeFlags_DefaultOpen)) {
-            ImGui::DragFloat("X", &selectedObject->x, 1.0f);
-            ImGui::DragFloat("Y", &selectedObject->y, 1.0f);
-            ImGui::DragInt("W", &selectedObject->width, 1, 1, 1200);
-            ImGui::DragInt("H", &selectedObject->height, 1, 1, 800);
+            SDL_Rect before = { (int)selectedObject->x, (int)selectedObject->y, selectedObject->width, selectedObject->height };
+            bool changed = false;
+            changed |= ImGui::DragFloat("X", &selectedObject->x, 1.0f);
+            changed |= ImGui::DragFloat("Y", &selectedObject->y, 1.0f);
+            changed |= ImGui::DragInt("W", &selectedObject->width, 1, 1, 1200);
+            changed |= ImGui::DragInt("H", &selectedObject->height, 1, 1, 800);
+
+            // 移動前後の範囲だけ静的レイヤーのチャンクと流れ場を再計算させる
+            if (changed && currentScene) {
+                currentScene->NotifyObjectChanged(selectedObject, before);
+            }
         }
         if (ImGui::CollapsingHeader("Physics", ImGuiTreeNodeFlags_DefaultOpen)) {
             ImGui::Checkbox("Use Gravity", &selectedObject->useGravity);
             ImGui::DragFloat("Vel X", &selectedObject->velX, 0.1f);
             ImGui::DragFloat("Vel Y", &selectedObject->velY, 0.1f);
         }
+
+        ObjectEditState afterEdit = ObjectEditState::Capture(selectedObject);
+        if (!(afterEdit == beforeEdit)) {
+            // 位置は移動量を、それ以外は変更された項目の値をそのまま他のオブジェクトへ反映する
+            for (GameObject* obj : selectedObjects) {
+                if (obj == selectedObject) continue;
+                SDL_Rect before = { (int)obj->x, (int)obj->y, obj->width, obj->height };
+                obj->x += afterEdit.x - beforeEdit.x;
+                obj->y += afterEdit.y - beforeEdit.y;
+                if (afterEdit.width != beforeEdit.width) obj->width = afterEdit.width;
+                if (afterEdit.height != beforeEdit.height) obj->height = afterEdit.height;
+                if (afterEdit.useGravity != beforeEdit.useGravity) obj->useGravity = afterEdit.useGravity;
+                if (afterEdit.velX != beforeEdit.velX) obj->velX = afterEdit.velX;
+                if (afterEdit.velY != beforeEdit.velY) obj->velY = afterEdit.velY;
+                if (currentScene) currentScene->NotifyObjectChanged(obj, before);
+            }
+
+            // 取り消し用に、選択中の全オブジェクトの変更前後を id と一緒に記録する
+            std::vector<std::pair<unsigned int, ObjectEditState>> beforeList, afterList;
+            for (size_t i = 0; i < selectedObjects.size(); ++i) {
+                beforeList.push_back({ selectedObjects[i]->id, beforeStates[i] });
+                afterList.push_back({ selectedObjects[i]->id, ObjectEditState::Capture(selectedObjects[i]) });
+            }
+
+            UndoStack::Command command;
+            command.label = (selectedObjects.size() > 1)
+                ? "Edit " + std::to_string(selectedObjects.size()) + " Objects"
+                : "Edit " + selectedObject->name.str();
+            command.undo = [currentScene, beforeList]() {
+                for (const auto& entry : beforeList) ApplyObjectEditState(currentScene, entry.first, entry.second);
+            };
+            command.redo = [currentScene, afterList]() {
+                for (const auto& entry : afterList) ApplyObjectEditState(currentScene, entry.first, entry.second);
+            };
+            command.byteSize = sizeof(UndoStack::Command) + command.label.size() +
+                (sizeof(unsigned int) + sizeof(ObjectEditState)) * 2 * selectedObjects.size();
+            undoStack.Push(std::move(command), selectedObject);
+        }
         ImGui::SetCursorPosY(ImGui::GetWindowHeight() - 35);
-        if (ImGui::Button("Delete Object", ImVec2(-1, 0))) { selectedObject->isDead = true; selectedObject = nullptr; }
+        const char* deleteLabel = (selectedObjects.size() > 1) ? "Delete Selected" : "Delete Object";
+        if (ImGui::Button(deleteLabel, ImVec2(-1, 0))) {
+            for (GameObject* obj : selectedObjects) obj->isDead = true;
+            ClearSelection();
+        }
     }
     else { ImGui::TextDisabled("(No object selected)"); }
     ImGui::End();
 }
 
-void EditorGUI::DrawParameters() {
+void EditorGUI::DrawParameters(Game* game) {
     ImGui::SetNextWindowPos(ImVec2(240, 10), ImGuiCond_Once);
     ImGui::SetNextWindowSize(ImVec2(200, 350), ImGuiCond_Once);
 
@@ -253,16 +656,90 @@ void EditorGUI::DrawParameters() {
     if (ImGui::Button("Camera", ImVec2(-1, 35)))  currentConfigView = ConfigViewMode::CAMERA;
     if (ImGui::Button("Wave", ImVec2(-1, 35)))  currentConfigView = ConfigViewMode::WAVE;
 
+    ImGui::Separator();
+    ImGui::Checkbox("Show Enemy Routes", &showEnemyRoutes);
+
+    ImGui::Separator();
+    ImGui::BeginDisabled(!undoStack.CanUndo());
+    if (ImGui::Button("Undo", ImVec2(ImGui::GetContentRegionAvail().x * 0.5f, 0))) Undo();
+    ImGui::EndDisabled();
+    ImGui::SameLine();
+    ImGui::BeginDisabled(!undoStack.CanRedo());
+    if (ImGui::Button("Redo", ImVec2(-1, 0))) Redo();
+    ImGui::EndDisabled();
+    if (undoStack.CanUndo()) {
+        ImGui::TextDisabled("Last: %s", undoStack.GetUndoLabel().c_str());
+    }
+
     ImGui::Separator();
     ImGui::PushStyleColor(ImGuiCol_Button, (ImVec4)ImColor::HSV(0.4f, 0.6f, 0.6f));
     if (ImGui::Button("SAVE ALL TO FILE", ImVec2(-1, 40))) {
-        ConfigManager::Save(GameParams::GetInstance());
+        // 書き込みは別スレッドで行う。自分で保存した内容をホットリロードで再適用しないよう基準も更新する
+        json snapshot = ConfigManager::SaveAsync(GameParams::GetInstance());
+        if (game && game->GetConfigReloader()) {
+            game->GetConfigReloader()->SetBaseline(snapshot);
+        }
     }
     ImGui::PopStyleColor();
+
+    // 保存状況の表示
+    ConfigManager::SaveStatus status = ConfigManager::GetSaveStatus();
+    switch (status.state) {
+    case ConfigManager::SaveState::Saving:
+        ImGui::TextColored(ImVec4(1.0f, 1.0f, 0.0f, 1.0f), "Saving...");
+        break;
+    case ConfigManager::SaveState::Saved: {
+        char timeText[16] = "";
+        std::tm* local = std::localtime(&status.finishedAt);
+        if (local) std::strftime(timeText, sizeof(timeText), "%H:%M:%S", local);
+        ImGui::TextColored(ImVec4(0.4f, 1.0f, 0.4f, 1.0f), "Saved at %s", timeText);
+        break;
+    }
+    case ConfigManager::SaveState::Failed:
+        ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "Save failed");
+        if (ImGui::IsItemHovered()) ImGui::SetTooltip("%s", status.message.c_str());
+        break;
+    default:
+        break;
+    }
     ImGui::End();
 }
 
-void EditorGUI::DrawWaveConfigPanel(GameParams& params) {
+void EditorGUI::DrawWaveSimControls(Scene* currentScene) {
+    // 早送りの倍率（固定ステップを描画1フレームあたり複数回進める）
+    static const int SCALES[] = { 1, 2, 4, 8, 16, 32 };
+    ImGui::Text("Time Scale");
+    for (int scale : SCALES) {
+        std::string label = std::to_string(scale) + "x";
+        if (scale != SCALES[0]) ImGui::SameLine();
+        if (ImGui::RadioButton(label.c_str(), simTimeScale == scale)) simTimeScale = scale;
+    }
+
+    ImGui::BeginDisabled(!isWaveSimMode || runToWaveEnd);
+    if (ImGui::Button("Run To End Of Wave", ImVec2(-1, 0))) runToWaveEnd = true;
+    ImGui::EndDisabled();
+
+    EditorScene* edScene = dynamic_cast<EditorScene*>(currentScene);
+    if (!isWaveSimMode || !edScene) return;
+
+    const WaveSimStats& stats = edScene->GetSimStats();
+    const WaveManager& waves = edScene->GetWaveManager();
+    ImGui::Text("Wave %d / %d   Time %.1f s", waves.GetCurrentWaveNumber(), waves.GetTotalWaves(), stats.simulatedSeconds);
+    ImGui::Text("Enemies %d (peak %d)   Gate HP min %d", stats.enemiesAlive, stats.peakEnemies, stats.lowestBaseHP);
+    ImGui::Text("Killed %d   Gate damage taken %d", stats.enemiesKilled, stats.baseDamageTaken);
+
+    // 目標に届いていなければ CPU 側が律速していることを示す
+    ImVec4 tpsColor = stats.cpuBound ? ImVec4(1.0f, 0.4f, 0.3f, 1.0f) : ImVec4(0.6f, 1.0f, 0.6f, 1.0f);
+    if (stats.targetTicksPerSecond > 0.0f) {
+        ImGui::TextColored(tpsColor, "%.0f / %.0f ticks/s (%d per frame)%s", stats.ticksPerSecond,
+            stats.targetTicksPerSecond, stats.ticksLastFrame, stats.cpuBound ? " CPU bound" : "");
+    }
+    else {
+        ImGui::TextColored(tpsColor, "%.0f ticks/s (%d per frame)", stats.ticksPerSecond, stats.ticksLastFrame);
+    }
+}
+
+void EditorGUI::DrawWaveConfigPanel(GameParams& params, Scene* currentScene) {
     static int selectedLevel = 1;
     ImGui::InputInt("Level ID", &selectedLevel);
     if (selectedLevel < 1) selectedLevel = 1;
@@ -270,6 +747,14 @@ void EditorGUI::DrawWaveConfigPanel(GameParams& params) {
     if (params.levelConfigs.find(selectedLevel) == params.levelConfigs.end()) {
         if (ImGui::Button("Create Level Config")) {
             params.levelConfigs[selectedLevel] = LevelParams();
+
+            int levelId = selectedLevel;
+            UndoStack::Command command;
+            command.label = "Create Level " + std::to_string(levelId);
+            command.undo = [levelId]() { GameParams::GetInstance().levelConfigs.erase(levelId); };
+            command.redo = [levelId]() { GameParams::GetInstance().levelConfigs[levelId] = LevelParams(); };
+            command.byteSize = sizeof(UndoStack::Command) + command.label.size();
+            undoStack.Push(std::move(command));
         }
         return;
     }
@@ -279,16 +764,47 @@ void EditorGUI::DrawWaveConfigPanel(GameParams& params) {
     std::string simLabel = isWaveSimMode ? "STOP SIMULATION" : "SIMULATE THIS LEVEL";
     if (ImGui::Button(simLabel.c_str(), ImVec2(-1, 40))) {
         isWaveSimMode = !isWaveSimMode;
+        runToWaveEnd = false;
         if (isWaveSimMode) {
             simLevelID = selectedLevel;
             isTestMode = true;
         }
     }
     ImGui::PopStyleColor();
+    DrawWaveSimControls(currentScene);
     ImGui::Separator();
 
     LevelParams& level = params.levelConfigs[selectedLevel];
 
+    // レベルは取り消し時に id で探し直す（レベル作成を取り消すと要素ごと消えるため）
+    int levelId = selectedLevel;
+    SectionEditScope<LevelParams> levelEdit("Edit Waves", [levelId]() -> LevelParams* {
+        auto& levels = GameParams::GetInstance().levelConfigs;
+        auto it = levels.find(levelId);
+        return (it != levels.end()) ? &it->second : nullptr;
+    });
+
+    // 出現レーン（なければ画面右端の外側の1レーンを使う）
+    if (ImGui::CollapsingHeader("Spawn Lanes")) {
+        for (size_t l = 0; l < level.lanes.size(); ++l) {
+            ImGui::PushID(static_cast<int>(1000 + l));
+            SpawnLane& lane = level.lanes[l];
+            ImGui::Text("Lane %d", (int)l);
+            ImGui::SameLine();
+            bool removed = ImGui::SmallButton("X");
+            ImGui::DragFloat("X", &lane.x, 1.0f);
+            ImGui::DragFloatRange2("Y Range", &lane.minY, &lane.maxY, 1.0f);
+            ImGui::PopID();
+            if (removed) {
+                level.lanes.erase(level.lanes.begin() + l);
+                break;
+            }
+        }
+        if (ImGui::Button("+ Add Lane")) {
+            level.lanes.push_back(SpawnLane());
+        }
+    }
+
     if (ImGui::Button("Add New Wave", ImVec2(-1, 30))) {
         level.waves.push_back(WaveParams());
     }
@@ -308,7 +824,7 @@ void EditorGUI::DrawWaveConfigPanel(GameParams& params) {
                     // エラー回避: 構造化束縛を使わずイテレータを使用
                     for (auto it = params.enemyPresets.begin(); it != params.enemyPresets.end(); ++it) {
                         const std::string& name = it->first;
-                        bool isSelected = (wave.spawns[e].enemyPresetName == name);
+                        bool isSelected = (wave.spawns[e].enemyPresetName.str() == name);
                         if (ImGui::Selectable(name.c_str(), isSelected)) {
                             wave.spawns[e].enemyPresetName = name;
                         }
@@ -328,6 +844,21 @@ void EditorGUI::DrawWaveConfigPanel(GameParams& params) {
                     break;
                 }
 
+                // 出現のペース（開始時刻が負なら前のエントリの後に続く）
+                EnemySpawnEntry& entry = wave.spawns[e];
+                ImGui::Indent();
+                ImGui::SetNextItemWidth(55);
+                ImGui::DragFloat("Delay", &entry.startDelay, 0.1f, -1.0f, 600.0f, entry.startDelay < 0.0f ? "after" : "%.1fs");
+                ImGui::SameLine();
+                ImGui::SetNextItemWidth(50);
+                ImGui::DragFloat("Every", &entry.interval, 0.05f, 0.0f, 30.0f, "%.2fs");
+                ImGui::SetNextItemWidth(55);
+                ImGui::DragInt("Burst", &entry.burstSize, 1, 1, 50);
+                ImGui::SameLine();
+                ImGui::SetNextItemWidth(50);
+                ImGui::DragInt("Lane", &entry.lane, 1, -1, std::max(0, (int)level.lanes.size() - 1), entry.lane < 0 ? "any" : "%d");
+                ImGui::Unindent();
+
                 ImGui::PopID();
             }
 
@@ -365,6 +896,9 @@ static void DrawPlayerConfigPanel(GameParams& params) {
     ImGui::PopStyleColor();
     ImGui::Separator();
 
+    SectionEditScope<PlayerParams> playerEdit("Edit Player", []() { return &GameParams::GetInstance().player; },
+        &params.activePlayerPresetName);
+
     if (ImGui::CollapsingHeader("Edit Active Parameters", ImGuiTreeNodeFlags_DefaultOpen)) {
         ImGui::SliderFloat("Speed", &params.player.moveSpeed, 50.0f, 600.0f, "%.1f");
         ImGui::SliderFloat("Jump", &params.player.jumpVelocity, 100.0f, 1000.0f, "%.1f");
@@ -385,8 +919,8 @@ static void DrawPlayerConfigPanel(GameParams& params) {
 
         ImGui::InputText("Name", nameBuf, IM_ARRAYSIZE(nameBuf));
         if (ImGui::Button("SAVE PRESET", ImVec2(-1, 0))) {
-            params.playerPresets[nameBuf] = params.player;
-            params.activePlayerPresetName = nameBuf;
+            SavePresetWithUndo("Save Player Preset", params.playerPresets, params.activePlayerPresetName, nameBuf, params.player);
+            playerEdit.Rebase();
         }
     }
 }
@@ -397,6 +931,9 @@ static void DrawGunConfigPanel(GameParams& params, SDL_Renderer* renderer, Scene
         strncpy_s(nameBuf, params.activeGunPresetName.c_str(), _TRUNCATE);
     }
 
+    SectionEditScope<GunParams> gunEdit("Edit Gun", []() { return &GameParams::GetInstance().gun; },
+        &params.activeGunPresetName, [renderer, currentScene]() { NotifyPlayerGunChanged(renderer, currentScene); });
+
     if (ImGui::CollapsingHeader("Edit Active Gun Settings", ImGuiTreeNodeFlags_DefaultOpen)) {
         if (ImGui::SliderFloat("Fire Rate", &params.gun.fireRate, 0.05f, 1.0f, "%.2f sec")) NotifyPlayerGunChanged(renderer, currentScene);
         if (ImGui::SliderFloat("Bullet Speed", &params.gun.bulletSpeed, 10.0f, 100.0f, "%.0f")) NotifyPlayerGunChanged(renderer, currentScene);
@@ -430,8 +967,8 @@ static void DrawGunConfigPanel(GameParams& params, SDL_Renderer* renderer, Scene
 
         ImGui::InputText("Preset Name", nameBuf, IM_ARRAYSIZE(nameBuf));
         if (ImGui::Button("SAVE PRESET", ImVec2(-1, 0))) {
-            params.gunPresets[nameBuf] = params.gun;
-            params.activeGunPresetName = nameBuf;
+            SavePresetWithUndo("Save Gun Preset", params.gunPresets, params.activeGunPresetName, nameBuf, params.gun);
+            gunEdit.Rebase();
         }
     }
 }
@@ -451,6 +988,9 @@ static void DrawEnemyConfigPanel(GameParams& params, SDL_Renderer* renderer, Sce
     ImGui::PopStyleColor();
     ImGui::Separator();
 
+    SectionEditScope<EnemyParams> enemyEdit("Edit Enemy", []() { return &GameParams::GetInstance().enemy; },
+        &params.activeEnemyPresetName, [renderer, currentScene]() { NotifyEnemyConfigChanged(renderer, currentScene); });
+
     if (ImGui::CollapsingHeader("Status Settings", ImGuiTreeNodeFlags_DefaultOpen)) {
         if (ImGui::InputInt("Health", &params.enemy.baseHealth)) NotifyEnemyConfigChanged(renderer, currentScene);
         if (ImGui::InputInt("Attack", &params.enemy.attackPower)) NotifyEnemyConfigChanged(renderer, currentScene);
@@ -515,8 +1055,8 @@ static void DrawEnemyConfigPanel(GameParams& params, SDL_Renderer* renderer, Sce
 
         ImGui::InputText("Preset Name", nameBuf, IM_ARRAYSIZE(nameBuf));
         if (ImGui::Button("SAVE PRESET", ImVec2(-1, 0))) {
-            params.enemyPresets[nameBuf] = params.enemy;
-            params.activeEnemyPresetName = nameBuf;
+            SavePresetWithUndo("Save Enemy Preset", params.enemyPresets, params.activeEnemyPresetName, nameBuf, params.enemy);
+            enemyEdit.Rebase();
         }
     }
 }
@@ -529,6 +1069,9 @@ static void DrawBaseConfigPanel(GameParams& params, SDL_Renderer* renderer, Scen
     ImGui::PopStyleColor();
     ImGui::Separator();
 
+    SectionEditScope<BaseParams> baseEdit("Edit Base", []() { return &GameParams::GetInstance().base; },
+        nullptr, [renderer, currentScene]() { NotifyBaseConfigChanged(renderer, currentScene); });
+
     if (ImGui::CollapsingHeader("Base Stats", ImGuiTreeNodeFlags_DefaultOpen)) {
         if (ImGui::InputInt("Max Health", &params.base.maxHealth)) NotifyBaseConfigChanged(renderer, currentScene);
         if (ImGui::SliderFloat("Defense", &params.base.defense, 0.0f, 100.0f)) NotifyBaseConfigChanged(renderer, currentScene);
@@ -547,13 +1090,19 @@ static void DrawBaseConfigPanel(GameParams& params, SDL_Renderer* renderer, Scen
 }
 
 static void DrawPhysicsConfigPanel(GameParams& params) {
+    SectionEditScope<PhysicsParams> physicsEdit("Edit Physics", []() { return &GameParams::GetInstance().physics; });
+
     if (ImGui::CollapsingHeader("Global Physics", ImGuiTreeNodeFlags_DefaultOpen)) {
         ImGui::SliderFloat("Gravity", &params.physics.gravity, 0.0f, 100.0f, "%.2f");
         ImGui::SliderFloat("Terminal Vel", &params.physics.terminalVelocity, 100.0f, 5000.0f, "%.0f");
+        ImGui::Checkbox("Sweep And Prune", &params.physics.sweepAndPrune);
+        if (ImGui::IsItemHovered()) ImGui::SetTooltip("Off: test every pair of objects (for comparison)");
     }
 }
 
 static void DrawCameraConfigPanel(GameParams& params) {
+    SectionEditScope<CameraParams> cameraEdit("Edit Camera", []() { return &GameParams::GetInstance().camera; });
+
     if (ImGui::CollapsingHeader("Camera Settings", ImGuiTreeNodeFlags_DefaultOpen)) {
         ImGui::SliderFloat("Offset X", &params.camera.offsetX, -400.0f, 400.0f, "%.1f px");
         ImGui::SliderFloat("Offset Y", &params.camera.offsetY, -500.0f, 300.0f, "%.1f px");
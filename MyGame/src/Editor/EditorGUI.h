@@ -2,10 +2,14 @@
 #include <SDL.h>
 #include "../Scenes/Scene.h"
 #include "../Objects/GameObject.h"
+#include "UndoStack.h"
 #include <string>
+#include <vector>
 
 // エディタ用のGUIを管理する静的クラス
 
+class DrawList;
+
 class EditorGUI {
 public:
     enum class Mode {
@@ -26,8 +30,8 @@ public:
 
     static void Init(SDL_Window* window, SDL_Renderer* renderer);
     static void HandleEvents(SDL_Event* event);
-    // 第3引数に Game* を追加
-    static void Render(SDL_Renderer* renderer, Scene* currentScene, class Game* game);
+    // UI を組み立て、ImGui の描画データを drawList に複製して積む
+    static void Render(DrawList& drawList, Scene* currentScene, class Game* game);
     static void Clean();
 
     static void SetMode(Mode newMode);
@@ -35,20 +39,40 @@ public:
     // 画像ファイルをプロジェクト内に取り込むユーティリティ
     static std::string ImportTexture();
 
-    static GameObject* selectedObject;
+    // 取り消し・やり直し（Ctrl+Z / Ctrl+Y からも呼ばれる）
+    static void Undo();
+    static void Redo();
+    static UndoStack& GetUndoStack() { return undoStack; }
+
+    // 選択の操作（additive なら既存の選択に追加し、選択済みのものは外す）
+    static void SelectObject(GameObject* obj, bool additive = false);
+    static void SelectObjects(const std::vector<GameObject*>& objects, bool additive = false);
+    static void ClearSelection();
+    static bool IsSelected(const GameObject* obj);
+    // シーンにオブジェクトが加わった時・取り除かれる時に呼ばれる（選択と階層ビューに反映する）
+    static void OnObjectAdded(GameObject* obj);
+    static void OnObjectRemoved(GameObject* obj);
+
+    static GameObject* selectedObject;                 // 主選択（インスペクターに表示される）
+    static std::vector<GameObject*> selectedObjects;   // 複数選択（主選択も含む）
     static bool isTestMode;       // プレイヤーのテスト操作
     static bool isWaveSimMode;    // ウェーブのシミュレーション実行中フラグ
     static int simLevelID;        // シミュレーション対象のレベルID
+    static int simTimeScale;      // シミュレーションの早送り倍率（1〜32）
+    static bool runToWaveEnd;     // 現在のウェーブが終わるまで最大速度で進める
+    static bool showEnemyRoutes;  // 流れ場に沿った敵ルートのプレビュー表示
 
 private:
     static void DrawHierarchy(Scene* currentScene);
-    static void DrawInspector();
-    static void DrawParameters();
+    static void DrawInspector(Scene* currentScene);
+    static void DrawParameters(class Game* game);
     static void DrawConfigEditorWindow();
 
     // ウェーブ設定用パネル
-    static void DrawWaveConfigPanel(class GameParams& params);
+    static void DrawWaveConfigPanel(class GameParams& params, Scene* currentScene);
+    static void DrawWaveSimControls(Scene* currentScene);
 
     static ConfigViewMode currentConfigView;
     static Mode currentMode;
+    static UndoStack undoStack;
 };
\ No newline at end of file
@@ -0,0 +1,70 @@
+﻿#include "UndoStack.h"
+
+namespace {
+    const std::string EMPTY_LABEL;
+}
+
+void UndoStack::Push(Command command, const void* mergeKey) {
+    // 新しい操作をしたらやり直し履歴は無効になる
+    for (const Command& c : redoList) totalBytes -= c.byteSize;
+    redoList.clear();
+
+    // 同じ対象への連続した変更は、最初の「元に戻す」を残したまま「やり直す」だけ差し替える
+    if (mergeKey && mergeKey == openMergeKey && !undoList.empty()) {
+        Command& merged = undoList.back();
+        merged.redo = std::move(command.redo);
+        totalBytes = totalBytes - merged.byteSize + command.byteSize;
+        merged.byteSize = command.byteSize;
+        return;
+    }
+
+    totalBytes += command.byteSize;
+    undoList.push_back(std::move(command));
+    openMergeKey = mergeKey;
+    Trim();
+}
+
+bool UndoStack::Undo() {
+    Seal();
+    if (undoList.empty()) return false;
+
+    Command command = std::move(undoList.back());
+    undoList.pop_back();
+    if (command.undo) command.undo();
+    redoList.push_back(std::move(command));
+    return true;
+}
+
+bool UndoStack::Redo() {
+    Seal();
+    if (redoList.empty()) return false;
+
+    Command command = std::move(redoList.back());
+    redoList.pop_back();
+    if (command.redo) command.redo();
+    undoList.push_back(std::move(command));
+    return true;
+}
+
+const std::string& UndoStack::GetUndoLabel() const {
+    return undoList.empty() ? EMPTY_LABEL : undoList.back().label;
+}
+
+const std::string& UndoStack::GetRedoLabel() const {
+    return redoList.empty() ? EMPTY_LABEL : redoList.back().label;
+}
+
+void UndoStack::Clear() {
+    undoList.clear();
+    redoList.clear();
+    openMergeKey = nullptr;
+    totalBytes = 0;
+}
+
+void UndoStack::Trim() {
+    // 件数とサイズの上限を超えたら古い操作から捨てる（直前の操作は必ず残す）
+    while (undoList.size() > 1 && (undoList.size() > MAX_COMMANDS || totalBytes > MAX_BYTES)) {
+        totalBytes -= undoList.front().byteSize;
+        undoList.pop_front();
+    }
+}
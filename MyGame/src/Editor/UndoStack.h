@@ -0,0 +1,57 @@
+﻿#pragma once
+#include <deque>
+#include <vector>
+#include <string>
+#include <functional>
+
+/**
+ * @brief エディタ操作の取り消し・やり直し履歴
+ * 1つの操作は「元に戻す処理」と「やり直す処理」の組（コマンド）として記録します。
+ * コマンドは変更された値の前後だけを保持するため、GameParams 全体を複製するよりはるかに小さく済みます。
+ * 同じ対象（mergeKey）へ続けて記録されたコマンドは、Seal() されるまで1つにまとめられます
+ * （スライダーをドラッグしている間の毎フレームの変更が1回の操作になります）。
+ */
+class UndoStack {
+public:
+    struct Command {
+        std::string label;
+        std::function<void()> undo;
+        std::function<void()> redo;
+        size_t byteSize = 0;  // 履歴の上限判定に使うおおよそのサイズ（取り込んだ値が持つ文字列や配列の中身も含める）
+    };
+
+    // 履歴の上限（古いものから捨てる）
+    static constexpr size_t MAX_COMMANDS = 200;
+    static constexpr size_t MAX_BYTES = 1024 * 1024;
+
+    /**
+     * @brief 実行済みの操作を履歴に積む（やり直し履歴は破棄される）
+     * @param mergeKey 直前のコマンドと同じキーで、まだ Seal されていなければ1つにまとめる（nullptr ならまとめない）
+     */
+    void Push(Command command, const void* mergeKey = nullptr);
+
+    // 直前のコマンドへのまとめを打ち切る（ドラッグが終わった時など）
+    void Seal() { openMergeKey = nullptr; }
+
+    bool Undo();
+    bool Redo();
+
+    bool CanUndo() const { return !undoList.empty(); }
+    bool CanRedo() const { return !redoList.empty(); }
+
+    // メニュー表示用（履歴が空なら空文字列）
+    const std::string& GetUndoLabel() const;
+    const std::string& GetRedoLabel() const;
+
+    void Clear();
+
+    size_t GetByteSize() const { return totalBytes; }
+
+private:
+    void Trim();
+
+    std::deque<Command> undoList;
+    std::vector<Command> redoList;
+    const void* openMergeKey = nullptr;
+    size_t totalBytes = 0;
+};
@@ -0,0 +1,415 @@
+﻿#include "FlowField.h"
+#include "../Objects/GameObject.h"
+#include "../Objects/Base.h"
+#include "../Objects/Turret.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <functional>
+
+namespace {
+    const float INF_DISTANCE = std::numeric_limits<float>::max();
+
+    // 8近傍（斜め移動を含む）
+    const int NEIGHBOR_DX[8] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+    const int NEIGHBOR_DY[8] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+    const float NEIGHBOR_LEN[8] = { 1.0f, 1.0f, 1.0f, 1.0f, 1.41421356f, 1.41421356f, 1.41421356f, 1.41421356f };
+}
+
+void FlowField::Init(int worldWidth, int worldHeight) {
+    cols = std::max(1, (worldWidth + CELL_SIZE - 1) / CELL_SIZE);
+    rows = std::max(1, (worldHeight + CELL_SIZE - 1) / CELL_SIZE);
+
+    size_t count = (size_t)cols * rows;
+    cost.assign(count, 1);
+    goal.assign(count, 0);
+    integration.assign(count, INF_DISTANCE);
+    parent.assign(count, -1);
+    directions.assign(count, { 0.0f, 0.0f });
+    visitStamp.assign(count, 0);
+    currentStamp = 0;
+    goalCount = 0;
+
+    // 初回は全体を計算する
+    needsFullRebuild = true;
+    dirty = true;
+    dirtyMinCX = 0;
+    dirtyMinCY = 0;
+    dirtyMaxCX = cols - 1;
+    dirtyMaxCY = rows - 1;
+}
+
+void FlowField::MarkDirty(const SDL_Rect& worldRect) {
+    if (cols <= 0 || rows <= 0) return;
+
+    // タレットの危険範囲も含めて広げておく
+    int margin = DANGER_RADIUS + 1;
+    int minCX = std::max(0, (int)std::floor((float)worldRect.x / CELL_SIZE) - margin);
+    int minCY = std::max(0, (int)std::floor((float)worldRect.y / CELL_SIZE) - margin);
+    int maxCX = std::min(cols - 1, (int)std::floor((float)(worldRect.x + worldRect.w) / CELL_SIZE) + margin);
+    int maxCY = std::min(rows - 1, (int)std::floor((float)(worldRect.y + worldRect.h) / CELL_SIZE) + margin);
+    if (minCX > maxCX || minCY > maxCY) return;
+
+    if (!dirty) {
+        dirty = true;
+        dirtyMinCX = minCX;
+        dirtyMinCY = minCY;
+        dirtyMaxCX = maxCX;
+        dirtyMaxCY = maxCY;
+    }
+    else {
+        dirtyMinCX = std::min(dirtyMinCX, minCX);
+        dirtyMinCY = std::min(dirtyMinCY, minCY);
+        dirtyMaxCX = std::max(dirtyMaxCX, maxCX);
+        dirtyMaxCY = std::max(dirtyMaxCY, maxCY);
+    }
+}
+
+void FlowField::Update(const std::vector<std::unique_ptr<GameObject>>& objects) {
+    if (!dirty || cols <= 0 || rows <= 0) return;
+    dirty = false;
+
+    if (needsFullRebuild) {
+        needsFullRebuild = false;
+        RasterizeCells(0, 0, cols - 1, rows - 1, objects);
+        goalCount = (int)std::count(goal.begin(), goal.end(), (unsigned char)1);
+        BuildIntegrationField();
+        BuildDirections();
+        ++version;
+        return;
+    }
+
+    // 変更前のコストを退避してから範囲内だけ再ラスタライズする
+    int rangeW = dirtyMaxCX - dirtyMinCX + 1;
+    int rangeH = dirtyMaxCY - dirtyMinCY + 1;
+    prevCost.resize((size_t)rangeW * rangeH);
+    prevGoal.resize((size_t)rangeW * rangeH);
+    for (int cy = 0; cy < rangeH; ++cy) {
+        int src = (dirtyMinCY + cy) * cols + dirtyMinCX;
+        std::copy(cost.begin() + src, cost.begin() + src + rangeW, prevCost.begin() + cy * rangeW);
+        std::copy(goal.begin() + src, goal.begin() + src + rangeW, prevGoal.begin() + cy * rangeW);
+    }
+
+    RasterizeCells(dirtyMinCX, dirtyMinCY, dirtyMaxCX, dirtyMaxCY, objects);
+
+    // 実際に値が変わったセルだけを修復の起点にする
+    std::vector<int> changedCells;
+    for (int cy = 0; cy < rangeH; ++cy) {
+        for (int cx = 0; cx < rangeW; ++cx) {
+            int index = (dirtyMinCY + cy) * cols + dirtyMinCX + cx;
+            int local = cy * rangeW + cx;
+            if (cost[index] == prevCost[local] && goal[index] == prevGoal[local]) continue;
+            goalCount += (int)goal[index] - (int)prevGoal[local];
+            changedCells.push_back(index);
+        }
+    }
+    if (changedCells.empty()) return;
+
+    RepairIntegrationField(changedCells);
+    ++version;
+}
+
+void FlowField::RasterizeCells(int minCX, int minCY, int maxCX, int maxCY,
+    const std::vector<std::unique_ptr<GameObject>>& objects) {
+    for (int cy = minCY; cy <= maxCY; ++cy) {
+        for (int cx = minCX; cx <= maxCX; ++cx) {
+            cost[cy * cols + cx] = 1;
+            goal[cy * cols + cx] = 0;
+        }
+    }
+
+    // オブジェクトが重なるセル範囲（指定範囲内にクリップ）を求める
+    auto cellRange = [&](const GameObject* obj, int inflate, int& x0, int& y0, int& x1, int& y1) {
+        x0 = std::max(minCX, (int)std::floor(obj->x / CELL_SIZE) - inflate);
+        y0 = std::max(minCY, (int)std::floor(obj->y / CELL_SIZE) - inflate);
+        x1 = std::min(maxCX, (int)std::floor((obj->x + obj->width - 1) / CELL_SIZE) + inflate);
+        y1 = std::min(maxCY, (int)std::floor((obj->y + obj->height - 1) / CELL_SIZE) + inflate);
+        return x0 <= x1 && y0 <= y1;
+    };
+
+    // 地形（通行不可）とタレット（危険コスト）を先に書き込む
+    for (const auto& obj : objects) {
+        if (!obj || obj->isDead || !obj->affectsNavigation) continue;
+        if (dynamic_cast<Base*>(obj.get())) continue;
+
+        int x0, y0, x1, y1;
+        if (dynamic_cast<Turret*>(obj.get())) {
+            if (!cellRange(obj.get(), DANGER_RADIUS, x0, y0, x1, y1)) continue;
+            for (int cy = y0; cy <= y1; ++cy) {
+                for (int cx = x0; cx <= x1; ++cx) {
+                    unsigned char& c = cost[cy * cols + cx];
+                    if (c != BLOCKED) c = (unsigned char)std::min(254, c + DANGER_COST);
+                }
+            }
+        }
+        else {
+            if (!cellRange(obj.get(), 0, x0, y0, x1, y1)) continue;
+            for (int cy = y0; cy <= y1; ++cy) {
+                for (int cx = x0; cx <= x1; ++cx) {
+                    cost[cy * cols + cx] = BLOCKED;
+                }
+            }
+        }
+    }
+
+    // 拠点は地面と重なっていても到達できるように最後に書き込む
+    for (const auto& obj : objects) {
+        if (!obj || obj->isDead || !obj->affectsNavigation) continue;
+        if (!dynamic_cast<Base*>(obj.get())) continue;
+
+        int x0, y0, x1, y1;
+        if (!cellRange(obj.get(), 0, x0, y0, x1, y1)) continue;
+        for (int cy = y0; cy <= y1; ++cy) {
+            for (int cx = x0; cx <= x1; ++cx) {
+                cost[cy * cols + cx] = 1;
+                goal[cy * cols + cx] = 1;
+            }
+        }
+    }
+}
+
+bool FlowField::CanStep(int cx, int cy, int n, int& outIndex) const {
+    int nx = cx + NEIGHBOR_DX[n];
+    int ny = cy + NEIGHBOR_DY[n];
+    if (nx < 0 || ny < 0 || nx >= cols || ny >= rows) return false;
+
+    outIndex = ny * cols + nx;
+    if (cost[outIndex] == BLOCKED) return false;
+
+    // 斜め移動は角をすり抜けないようにする
+    if (n >= 4 && (cost[cy * cols + nx] == BLOCKED || cost[ny * cols + cx] == BLOCKED)) return false;
+    return true;
+}
+
+void FlowField::BuildIntegrationField() {
+    std::fill(integration.begin(), integration.end(), INF_DISTANCE);
+    std::fill(parent.begin(), parent.end(), -1);
+
+    std::vector<std::pair<float, int>> heap;
+    for (int i = 0; i < cols * rows; ++i) {
+        if (goal[i]) {
+            integration[i] = 0.0f;
+            heap.push_back({ 0.0f, i });
+        }
+    }
+    std::make_heap(heap.begin(), heap.end(), std::greater<std::pair<float, int>>());
+
+    PropagateDistances(heap, nullptr);
+}
+
+void FlowField::PropagateDistances(std::vector<std::pair<float, int>>& heap, std::vector<int>* outTouched) {
+    using Node = std::pair<float, int>;
+    std::greater<Node> cmp;
+
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), cmp);
+        Node node = heap.back();
+        heap.pop_back();
+
+        int index = node.second;
+        if (node.first > integration[index]) continue;
+
+        int cx = index % cols;
+        int cy = index / cols;
+
+        for (int n = 0; n < 8; ++n) {
+            int nIndex;
+            if (!CanStep(cx, cy, n, nIndex)) continue;
+            if (goal[nIndex]) continue;
+
+            float newDist = node.first + cost[nIndex] * NEIGHBOR_LEN[n];
+            if (newDist < integration[nIndex]) {
+                integration[nIndex] = newDist;
+                parent[nIndex] = index;
+                heap.push_back({ newDist, nIndex });
+                std::push_heap(heap.begin(), heap.end(), cmp);
+                if (outTouched) outTouched->push_back(nIndex);
+            }
+        }
+    }
+}
+
+void FlowField::InvalidateSubtree(int root, std::vector<int>& outInvalidated) {
+    if (visitStamp[root] == currentStamp) return;
+
+    std::vector<int> stack;
+    stack.push_back(root);
+    visitStamp[root] = currentStamp;
+
+    while (!stack.empty()) {
+        int index = stack.back();
+        stack.pop_back();
+
+        integration[index] = INF_DISTANCE;
+        parent[index] = -1;
+        outInvalidated.push_back(index);
+
+        // このセルを経由して拠点へ向かっていた隣接セルも無効にする
+        int cx = index % cols;
+        int cy = index / cols;
+        for (int n = 0; n < 8; ++n) {
+            int nx = cx + NEIGHBOR_DX[n];
+            int ny = cy + NEIGHBOR_DY[n];
+            if (nx < 0 || ny < 0 || nx >= cols || ny >= rows) continue;
+
+            int nIndex = ny * cols + nx;
+            if (parent[nIndex] == index && visitStamp[nIndex] != currentStamp) {
+                visitStamp[nIndex] = currentStamp;
+                stack.push_back(nIndex);
+            }
+        }
+    }
+}
+
+void FlowField::NextStamp() {
+    if (++currentStamp == 0) {
+        // カウンタが一周したら印をリセットする
+        std::fill(visitStamp.begin(), visitStamp.end(), 0);
+        currentStamp = 1;
+    }
+}
+
+void FlowField::RepairIntegrationField(const std::vector<int>& changedCells) {
+    NextStamp();
+
+    // 1. 変化したセルと、そこを経由していた経路（部分木）を無効化する
+    std::vector<int> invalidated;
+    for (int index : changedCells) {
+        InvalidateSubtree(index, invalidated);
+
+        // 通行不可になったセルの角をすり抜ける斜め移動も使えなくなる
+        if (cost[index] != BLOCKED) continue;
+        int cx = index % cols;
+        int cy = index / cols;
+        for (int n = 0; n < 8; ++n) {
+            int bx = cx + NEIGHBOR_DX[n];
+            int by = cy + NEIGHBOR_DY[n];
+            if (bx < 0 || by < 0 || bx >= cols || by >= rows) continue;
+
+            int bIndex = by * cols + bx;
+            int p = parent[bIndex];
+            if (p < 0) continue;
+            int px = p % cols;
+            int py = p / cols;
+            if (px == bx || py == by) continue;
+            if (py * cols + bx == index || by * cols + px == index) {
+                InvalidateSubtree(bIndex, invalidated);
+            }
+        }
+    }
+
+    // 2. 無効化した領域の境界と変化したセルの周囲（まだ有効なセル）から再伝播する
+    //    通行可能になったセルの周囲では新しい斜め移動も使えるようになるため、それも含める
+    std::vector<std::pair<float, int>> heap;
+    auto pushValidNeighbors = [&](int index) {
+        int cx = index % cols;
+        int cy = index / cols;
+        for (int n = 0; n < 8; ++n) {
+            int nx = cx + NEIGHBOR_DX[n];
+            int ny = cy + NEIGHBOR_DY[n];
+            if (nx < 0 || ny < 0 || nx >= cols || ny >= rows) continue;
+
+            int nIndex = ny * cols + nx;
+            if (integration[nIndex] != INF_DISTANCE) {
+                heap.push_back({ integration[nIndex], nIndex });
+            }
+        }
+    };
+
+    for (int index : invalidated) {
+        if (goal[index]) {
+            integration[index] = 0.0f;
+            heap.push_back({ 0.0f, index });
+        }
+        else {
+            pushValidNeighbors(index);
+        }
+    }
+    for (int index : changedCells) {
+        pushValidNeighbors(index);
+    }
+    std::make_heap(heap.begin(), heap.end(), std::greater<std::pair<float, int>>());
+
+    std::vector<int> touched = invalidated;
+    PropagateDistances(heap, &touched);
+
+    // 3. 距離が変わったセルとその隣接セルだけ進行方向を計算し直す
+    NextStamp();
+    for (int index : touched) {
+        int cx = index % cols;
+        int cy = index / cols;
+        for (int dy = -1; dy <= 1; ++dy) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                int nx = cx + dx;
+                int ny = cy + dy;
+                if (nx < 0 || ny < 0 || nx >= cols || ny >= rows) continue;
+
+                int nIndex = ny * cols + nx;
+                if (visitStamp[nIndex] == currentStamp) continue;
+                visitStamp[nIndex] = currentStamp;
+                ComputeDirection(nIndex);
+            }
+        }
+    }
+}
+
+void FlowField::ComputeDirection(int index) {
+    directions[index] = { 0.0f, 0.0f };
+    if (goal[index] || integration[index] == INF_DISTANCE) return;
+
+    // 最も拠点に近い隣接セルの方向を向く
+    int cx = index % cols;
+    int cy = index / cols;
+    float best = integration[index];
+    int bestN = -1;
+    for (int n = 0; n < 8; ++n) {
+        int nx = cx + NEIGHBOR_DX[n];
+        int ny = cy + NEIGHBOR_DY[n];
+        if (nx < 0 || ny < 0 || nx >= cols || ny >= rows) continue;
+        if (n >= 4 && (cost[cy * cols + nx] == BLOCKED || cost[ny * cols + cx] == BLOCKED)) continue;
+
+        float d = integration[ny * cols + nx];
+        if (d < best) {
+            best = d;
+            bestN = n;
+        }
+    }
+
+    if (bestN >= 0) {
+        float len = NEIGHBOR_LEN[bestN];
+        directions[index] = { NEIGHBOR_DX[bestN] / len, NEIGHBOR_DY[bestN] / len };
+    }
+}
+
+void FlowField::BuildDirections() {
+    for (int i = 0; i < cols * rows; ++i) {
+        ComputeDirection(i);
+    }
+}
+
+int FlowField::CellIndex(float worldX, float worldY) const {
+    int cx = std::clamp((int)std::floor(worldX / CELL_SIZE), 0, cols - 1);
+    int cy = std::clamp((int)std::floor(worldY / CELL_SIZE), 0, rows - 1);
+    return cy * cols + cx;
+}
+
+SDL_FPoint FlowField::GetDirection(float worldX, float worldY) const {
+    if (!IsReady()) return { 0.0f, 0.0f };
+    return directions[CellIndex(worldX, worldY)];
+}
+
+void FlowField::TracePath(float worldX, float worldY, std::vector<SDL_FPoint>& outPath, int maxSteps) const {
+    outPath.clear();
+    if (!IsReady()) return;
+
+    int index = CellIndex(worldX, worldY);
+    if (integration[index] == INF_DISTANCE) return;
+
+    // 親ポインタを拠点セルまでたどる
+    outPath.push_back({ worldX, worldY });
+    for (int step = 0; step < maxSteps && index >= 0; ++step) {
+        outPath.push_back({ (index % cols + 0.5f) * CELL_SIZE, (index / cols + 0.5f) * CELL_SIZE });
+        if (goal[index]) break;
+        index = parent[index];
+    }
+}
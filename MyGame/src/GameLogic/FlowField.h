@@ -0,0 +1,113 @@
+﻿#pragma once
+#include <SDL.h>
+#include <vector>
+#include <memory>
+
+class GameObject;
+
+/**
+ * @brief 拠点（Base Gate）へ向かう流れ場（Flow Field）
+ * レベル全体をグリッドに分割し、拠点からのダイクストラ法で各セルの経路距離と進行方向を求めます。
+ * 敵は自分のいるセルを引くだけで進む方向が分かるため、敵の数が増えても1体あたりのコストは一定です。
+ * 地形やタレットが変わった時は、変更範囲のセルだけコストを再計算し、
+ * 経路距離もコストが変わったセルに依存する部分だけを局所的に修復します。
+ */
+class FlowField {
+public:
+    // 1セルの一辺（ワールド座標のピクセル数）
+    static constexpr int CELL_SIZE = 32;
+    // タレット周辺を「危険」とみなすセル半径
+    static constexpr int DANGER_RADIUS = 3;
+
+    FlowField() = default;
+
+    /**
+     * @brief グリッドを作成する（マップサイズが決まった時に呼ぶ）
+     */
+    void Init(int worldWidth, int worldHeight);
+
+    /**
+     * @brief 指定範囲（ワールド座標）のセルを再計算対象にする
+     */
+    void MarkDirty(const SDL_Rect& worldRect);
+
+    /**
+     * @brief 変更があればコストと流れ場を更新する（変更がなければ何もしない）
+     */
+    void Update(const std::vector<std::unique_ptr<GameObject>>& objects);
+
+    /**
+     * @brief ワールド座標での進行方向（正規化済み）を O(1) で取得する
+     * 到達不能・拠点内のセルでは {0, 0} を返します。
+     */
+    SDL_FPoint GetDirection(float worldX, float worldY) const;
+
+    /**
+     * @brief 指定位置から流れ場に沿って拠点までの経路（セル中心のワールド座標）を求める
+     * エディタでの敵ルートのプレビュー用です。到達不能な場合は空になります。
+     */
+    void TracePath(float worldX, float worldY, std::vector<SDL_FPoint>& outPath, int maxSteps = 4096) const;
+
+    // 流れ場が更新されるたびに増えるカウンタ（プレビューのキャッシュ判定用）
+    unsigned int GetVersion() const { return version; }
+
+    bool IsReady() const { return cols > 0 && rows > 0 && goalCount > 0; }
+
+    int GetCols() const { return cols; }
+    int GetRows() const { return rows; }
+
+private:
+    static constexpr unsigned char BLOCKED = 255;
+    static constexpr unsigned char DANGER_COST = 4;
+
+    int CellIndex(float worldX, float worldY) const;
+
+    // セル (cx, cy) から方向 n へ移動できるか（範囲外・通行不可・角のすり抜けを除外）
+    bool CanStep(int cx, int cy, int n, int& outIndex) const;
+
+    // 指定セル範囲のコストをオブジェクトから再ラスタライズする
+    void RasterizeCells(int minCX, int minCY, int maxCX, int maxCY,
+        const std::vector<std::unique_ptr<GameObject>>& objects);
+
+    // 拠点セルからの統合場（経路距離）をすべて計算し直す
+    void BuildIntegrationField();
+
+    /**
+     * @brief コストが変わったセルに依存する部分だけ統合場を修復する
+     * 変化したセルを経由していた経路（親ポインタの部分木）を無効化し、
+     * その境界から再びダイクストラ法で距離を伝播させます。
+     */
+    void RepairIntegrationField(const std::vector<int>& changedCells);
+
+    // 部分木の無効化（親ポインタをたどって子孫のセルを未到達に戻す）
+    void InvalidateSubtree(int root, std::vector<int>& outInvalidated);
+    void NextStamp();
+
+    // 優先度付きキューから距離を伝播させる（修復と全体計算で共通）
+    void PropagateDistances(std::vector<std::pair<float, int>>& heap, std::vector<int>* outTouched);
+
+    void ComputeDirection(int index);
+    void BuildDirections();
+
+    int cols = 0;
+    int rows = 0;
+    int goalCount = 0;
+    bool needsFullRebuild = true;
+    unsigned int version = 0;
+
+    std::vector<unsigned char> cost;     // セルを通過するコスト（BLOCKED は通行不可）
+    std::vector<unsigned char> goal;     // 拠点が重なっているセル
+    std::vector<float> integration;      // 拠点までの経路コスト
+    std::vector<int> parent;             // 最短経路で次に進むセル（拠点セル・未到達は -1）
+    std::vector<SDL_FPoint> directions;  // 各セルの進行方向
+
+    // 修復処理で使い回す作業領域（毎回の確保を避ける）
+    std::vector<unsigned char> prevCost;
+    std::vector<unsigned char> prevGoal;
+    std::vector<unsigned int> visitStamp;
+    unsigned int currentStamp = 0;
+
+    // 再計算が必要なセル範囲
+    bool dirty = false;
+    int dirtyMinCX = 0, dirtyMinCY = 0, dirtyMaxCX = -1, dirtyMaxCY = -1;
+};
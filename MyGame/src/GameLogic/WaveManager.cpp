@@ -4,14 +4,20 @@
 #include "../Core/GameParams.h"
 #include "../Objects/Enemy.h"
 #include "../TextureManager.h"
+#include "../Core/Logger.h"
+#include "../Core/EventBus.h"
+#include "../Core/GameEvents.h"
 #include <SDL.h>
-#include <iostream>
 #include <vector>
 #include <random>
+#include <algorithm>
 
 WaveManager::WaveManager() {
 }
 
+// Enemy の定義が必要なため、プールを持つクラスのデストラクタはここで定義する
+WaveManager::~WaveManager() = default;
+
 void WaveManager::Init(int levelID) {
     currentLevelID = levelID;
     currentWaveIndex = -1;
@@ -22,34 +28,101 @@ void WaveManager::Init(int levelID) {
     }
     else {
         totalWaves = 0;
-        std::cerr << "Warning: Level ID " << levelID << " not found in GameParams." << std::endl;
+        LOG_WARN(LogCategory::Wave, "Level ID " << levelID << " not found in GameParams.");
     }
 
     NextWave();
 }
 
+void WaveManager::CompileWave(const WaveParams& wave, const std::map<std::string, EnemyParams>& presets,
+    std::vector<SpawnEvent>& outEvents, std::vector<StringId>& outPresetNames) {
+    outEvents.clear();
+    outPresetNames.clear();
+
+    // 開始時刻が負のエントリは、前のエントリが出し終わった時刻から始める（従来の順番出現と同じ）
+    float sequentialTime = 0.0f;
+
+    for (const auto& entry : wave.spawns) {
+        if (entry.count <= 0) continue;
+
+        // 同じプリセットの重複は番号で判定し、表の検索はプリセットごとに1回だけにする
+        int presetIndex = -1;
+        for (size_t i = 0; i < outPresetNames.size(); ++i) {
+            if (outPresetNames[i] == entry.enemyPresetName) {
+                presetIndex = (int)i;
+                break;
+            }
+        }
+        if (presetIndex < 0 && presets.find(entry.enemyPresetName.str()) == presets.end()) {
+            LOG_ERROR(LogCategory::Wave, "Enemy preset '" << entry.enemyPresetName << "' not found.");
+            continue;
+        }
+        if (presetIndex < 0) {
+            presetIndex = (int)outPresetNames.size();
+            outPresetNames.push_back(entry.enemyPresetName);
+        }
+
+        int burst = std::max(1, entry.burstSize);
+        float interval = std::max(0.0f, entry.interval);
+        float time = (entry.startDelay >= 0.0f) ? entry.startDelay : sequentialTime;
+
+        int remaining = entry.count;
+        while (remaining > 0) {
+            int count = std::min(burst, remaining);
+            outEvents.push_back({ time, presetIndex, entry.lane, count });
+            remaining -= count;
+            time += interval;
+        }
+        sequentialTime = time;
+    }
+
+    // 同時刻のイベントは設定の順序を保つ
+    std::stable_sort(outEvents.begin(), outEvents.end(),
+        [](const SpawnEvent& a, const SpawnEvent& b) { return a.time < b.time; });
+}
+
+void WaveManager::SetState(State newState) {
+    currentState = newState;
+    EventBus::GetInstance().Publish(WaveStateChangedEvent{ currentWaveIndex, newState });
+}
+
 void WaveManager::NextWave() {
     currentWaveIndex++;
 
     if (currentWaveIndex >= totalWaves) {
-        currentState = State::LEVEL_COMPLETED;
+        SetState(State::LEVEL_COMPLETED);
         return;
     }
 
-    while (!spawnQueue.empty()) spawnQueue.pop();
-
     auto& params = GameParams::GetInstance();
-    const auto& waveData = params.levelConfigs[currentLevelID].waves[currentWaveIndex];
+    const LevelParams& level = params.levelConfigs[currentLevelID];
+    const auto& waveData = level.waves[currentWaveIndex];
 
-    for (const auto& entry : waveData.spawns) {
-        for (int i = 0; i < entry.count; ++i) {
-            spawnQueue.push(entry.enemyPresetName);
-        }
+    // プリセット名の解決はここで一度だけ行う
+    CompileWave(waveData, params.enemyPresets, timeline, presetNames);
+
+    // 前のウェーブで使わなかった敵は捨て、種類ごとの必要数を数える（作るのは準備期間中）
+    archetypes.clear();
+    archetypesReady = false;
+    enemyPools.clear();
+    enemyPools.resize(presetNames.size());
+    poolTargets.assign(presetNames.size(), 0);
+    for (const SpawnEvent& spawnEvent : timeline) {
+        poolTargets[spawnEvent.presetIndex] += spawnEvent.count;
     }
+    worstSpawnMs = 0.0f;
+    spawnedFromPool = 0;
+    spawnedTotal = 0;
 
-    currentState = State::PREPARING;
+    lanes = level.lanes;
+    if (lanes.empty()) lanes.push_back(SpawnLane());
+
+    nextEventIndex = 0;
+    waveTime = 0.0f;
+
+    SetState(State::PREPARING);
     prepareTimer = PREPARE_DURATION;
-    std::cout << "Wave " << (currentWaveIndex + 1) << " Preparing..." << std::endl;
+    LOG_INFO(LogCategory::Wave, "Wave " << (currentWaveIndex + 1) << " Preparing...");
 }
 
 void WaveManager::Update(Game* game) {
@@ -59,28 +132,39 @@ void WaveManager::Update(Game* game) {
 
     switch (currentState) {
     case State::PREPARING:
+        // 待ち時間の間に、出現させる敵を少しずつ作っておく
+        if (!archetypesReady) BuildArchetypes(game->GetRenderer());
+        PrewarmEnemies(PREWARM_PER_FRAME);
+
         prepareTimer -= dt;
         if (prepareTimer <= 0) {
-            currentState = State::SPAWNING;
-            spawnTimer = 0;
-            std::cout << "Wave " << (currentWaveIndex + 1) << " Start!" << std::endl;
+            SetState(State::SPAWNING);
+            waveTime = 0.0f;
+            LOG_INFO(LogCategory::Wave, "Wave " << (currentWaveIndex + 1) << " Start!");
         }
         break;
 
     case State::SPAWNING:
-        spawnTimer -= dt;
-        if (spawnTimer <= 0) {
-            if (!spawnQueue.empty()) {
-                std::string preset = spawnQueue.front();
-                spawnQueue.pop();
-                SpawnEnemy(preset, game);
-                spawnTimer = spawnInterval;
-            }
-            else {
-                currentState = State::BATTLE;
-            }
+    {
+        if (!archetypesReady) BuildArchetypes(game->GetRenderer());
+
+        // 時刻が来たイベントを1回の走査でまとめて処理する
+        Uint64 spawnStart = SDL_GetPerformanceCounter();
+        while (nextEventIndex < timeline.size() && timeline[nextEventIndex].time <= waveTime) {
+            SpawnEnemy(timeline[nextEventIndex], game);
+            ++nextEventIndex;
         }
-        break;
+        float spawnMs = (SDL_GetPerformanceCounter() - spawnStart) * 1000.0f / (float)SDL_GetPerformanceFrequency();
+        worstSpawnMs = std::max(worstSpawnMs, spawnMs);
+        waveTime += dt;
+
+        if (nextEventIndex >= timeline.size()) {
+            SetState(State::BATTLE);
+            LOG_INFO(LogCategory::Wave, "Wave " << (currentWaveIndex + 1) << " spawned " << spawnedTotal << " enemies ("
+                << spawnedFromPool << " prewarmed), worst spawn frame " << worstSpawnMs << " ms");
+        }
+    }
+    break;
 
     case State::BATTLE:
     {
@@ -94,8 +178,8 @@ void WaveManager::Update(Game* game) {
         }
 
         if (!enemyExists) {
-            currentState = State::WAVE_CLEAR;
-            std::cout << "Wave " << (currentWaveIndex + 1) << " Clear!" << std::endl;
+            SetState(State::WAVE_CLEAR);
+            LOG_INFO(LogCategory::Wave, "Wave " << (currentWaveIndex + 1) << " Clear!");
         }
     }
     break;
@@ -109,30 +193,99 @@ void WaveManager::Update(Game* game) {
     }
 }
 
-void WaveManager::SpawnEnemy(const std::string& presetName, Game* game) {
+const EnemyParams& WaveManager::ResolvePreset(StringId name) {
     auto& params = GameParams::GetInstance();
+    if (name.str() == params.activeEnemyPresetName) return params.enemy;
+    auto it = params.enemyPresets.find(name.str());
+    return (it != params.enemyPresets.end()) ? it->second : params.enemy;
+}
+
+void WaveManager::BuildArchetypes(SDL_Renderer* renderer) {
+    archetypes.clear();
+    for (StringId name : presetNames) {
+        // プリセットは CompileWave で存在を確認済み。テクスチャの読み込みはここで種類ごとに1回だけ
+        archetypes.push_back(EnemyArchetype::Create(ResolvePreset(name), renderer));
+    }
+    archetypesReady = true;
+}
 
-    if (params.enemyPresets.count(presetName)) {
-        params.enemy = params.enemyPresets[presetName];
-        params.activeEnemyPresetName = presetName;
+void WaveManager::ApplyConfigChange(unsigned int changedSections, SDL_Renderer* renderer,
+    std::vector<std::unique_ptr<GameObject>>& objects) {
+    if (!(changedSections & ConfigSection::Enemy) || !archetypesReady) return;
 
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
+    // 値が変わった種類だけ作り直す（All はテクスチャの作り直しを含むので全種類）
+    std::vector<std::pair<std::shared_ptr<const EnemyArchetype>, int>> replaced;
+    for (size_t i = 0; i < archetypes.size(); ++i) {
+        const EnemyParams& preset = ResolvePreset(presetNames[i]);
+        if (changedSections != ConfigSection::All && archetypes[i]->params == preset) continue;
 
-        // スポーン位置の決定（画面右端の外側）
-        std::uniform_real_distribution<float> disY(50.0f, 400.0f);
-        float startX = 1300.0f;
-        float startY = disY(gen);
+        replaced.push_back({ archetypes[i], (int)i });
+        archetypes[i] = EnemyArchetype::Create(preset, renderer);
+        for (auto& enemy : enemyPools[i]) {
+            enemy->ApplyArchetype(archetypes[i]);
+        }
+    }
+    if (replaced.empty()) return;
 
+    // 出現済みの敵は古い種類のデータで見分ける
+    for (auto& obj : objects) {
+        if (!obj || obj->isDead) continue;
+        Enemy* enemy = dynamic_cast<Enemy*>(obj.get());
+        if (!enemy || !enemy->GetArchetype()) continue;
+        for (const auto& entry : replaced) {
+            if (enemy->GetArchetype() == entry.first.get()) {
+                enemy->ApplyArchetype(archetypes[entry.second]);
+                break;
+            }
+        }
+    }
+    LOG_INFO(LogCategory::Wave, "Rebuilt " << replaced.size() << " enemy archetype(s) after a config change");
+}
 
-        std::vector<SDL_FPoint> dummyPath;
-        auto newEnemy = std::make_unique<Enemy>(startX, startY, 64, 64, nullptr, dummyPath);
-        newEnemy->RefreshConfig(game->GetRenderer());
-        newEnemy->name = "Enemy";
+std::unique_ptr<Enemy> WaveManager::CreatePooledEnemy(int presetIndex) {
+    std::vector<SDL_FPoint> dummyPath;
+    auto enemy = std::make_unique<Enemy>(0.0f, 0.0f, 64, 64, nullptr, dummyPath);
+    enemy->ApplyArchetype(archetypes[presetIndex]);
+    enemy->name = ObjectNames::Enemy;
+    return enemy;
+}
 
-        game->Instantiate(std::move(newEnemy));
+void WaveManager::PrewarmEnemies(int budget) {
+    if (!archetypesReady) return;
+    for (size_t i = 0; i < enemyPools.size() && budget > 0; ++i) {
+        auto& pool = enemyPools[i];
+        while ((int)pool.size() < poolTargets[i] && budget > 0) {
+            pool.push_back(CreatePooledEnemy((int)i));
+            --budget;
+        }
     }
-    else {
-        std::cerr << "Error: Enemy preset '" << presetName << "' not found." << std::endl;
+}
+
+void WaveManager::SpawnEnemy(const SpawnEvent& spawnEvent, Game* game) {
+    auto& pool = enemyPools[spawnEvent.presetIndex];
+
+    for (int i = 0; i < spawnEvent.count; ++i) {
+        // レーンの指定がなければランダムに選ぶ
+        int laneIndex = spawnEvent.lane;
+        if (laneIndex < 0 || laneIndex >= (int)lanes.size()) {
+            laneIndex = std::uniform_int_distribution<int>(0, (int)lanes.size() - 1)(rng);
+        }
+        const SpawnLane& lane = lanes[laneIndex];
+        std::uniform_real_distribution<float> disY(std::min(lane.minY, lane.maxY), std::max(lane.minY, lane.maxY));
+
+        // 準備が間に合わなかった分だけその場で作る
+        std::unique_ptr<Enemy> enemy;
+        if (!pool.empty()) {
+            enemy = std::move(pool.back());
+            pool.pop_back();
+            ++spawnedFromPool;
+        }
+        else {
+            enemy = CreatePooledEnemy(spawnEvent.presetIndex);
+        }
+        ++spawnedTotal;
+
+        enemy->Activate(lane.x, disY(rng));
+        game->Instantiate(std::move(enemy));
     }
-}
\ No newline at end of file
+}
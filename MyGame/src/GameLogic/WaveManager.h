@@ -1,13 +1,35 @@
 ﻿#pragma once
 #include <vector>
 #include <string>
-#include <queue>
+#include <random>
+#include <memory>
 #include "../Core/GameParams.h"
+#include "../Core/StringId.h"
 
 // 前方宣言
 class Game;
+class Enemy;
+class GameObject;
+struct EnemyArchetype;
 struct SDL_Renderer;
 
+/**
+ * @brief コンパイル済みの出現イベント（ウェーブ開始からの時刻順に並ぶ）
+ */
+struct SpawnEvent {
+    float time;       // ウェーブ開始からの時刻（秒）
+    int presetIndex;  // WaveManager のプリセット表のインデックス
+    int lane;         // 出現レーン（負の値ならランダム）
+    int count;        // 同時に出す数
+};
+
+/**
+ * @brief ウェーブの進行と敵の出現を管理する
+ * ウェーブ開始時に設定を出現イベントの時系列（タイムライン）にコンパイルしておき、
+ * 毎フレームは時刻が来たイベントをまとめて処理するだけにします（出現ごとの文字列処理はありません）。
+ * 敵のインスタンスは準備期間（PREPARING）中に種類ごとのプールへ前もって作っておき、
+ * 出現は取り出して位置を設定するだけの O(1) の処理にしています。
+ */
 class WaveManager {
 public:
     enum class State {
@@ -19,7 +41,7 @@ public:
     };
 
     WaveManager();
-    ~WaveManager() = default;
+    ~WaveManager();
 
     void Init(int levelID);
 
@@ -30,9 +52,39 @@ public:
     int GetCurrentWaveNumber() const { return currentWaveIndex + 1; }
     int GetTotalWaves() const { return totalWaves; }
 
+    /**
+     * @brief ウェーブの設定を出現イベントのタイムラインにコンパイルする
+     * プリセット名はここで一度だけ解決し、見つからないものは警告を出して除外します。
+     * @param outPresetNames イベントの presetIndex が指すプリセット名（出現時はインデックスだけを使う）
+     */
+    static void CompileWave(const WaveParams& wave, const std::map<std::string, EnemyParams>& presets,
+        std::vector<SpawnEvent>& outEvents, std::vector<StringId>& outPresetNames);
+
+    /**
+     * @brief 敵の設定の変更を、値が変わった種類にだけ反映する
+     * 種類のデータを作り直し、プールで待機中の敵と objects 内の出現済みの敵に割り当て直します。
+     * 値が変わっていない種類の敵には触れません。
+     */
+    void ApplyConfigChange(unsigned int changedSections, SDL_Renderer* renderer,
+        std::vector<std::unique_ptr<GameObject>>& objects);
+
+    // 種類の元になる値（エディタで選択中のプリセットは、保存前の編集中の値を使う）
+    static const EnemyParams& ResolvePreset(StringId name);
+
+    // 1フレームで作る敵インスタンスの上限（準備期間中に分散させる）
+    static constexpr int PREWARM_PER_FRAME = 64;
+
 private:
+    // 状態を変えて WaveStateChangedEvent を発行する
+    void SetState(State newState);
     void NextWave();
-    void SpawnEnemy(const std::string& presetName, Game* game);
+    void SpawnEnemy(const SpawnEvent& spawnEvent, Game* game);
+
+    // 種類のデータ（テクスチャ・画像サイズ）を解決する。ウェーブごとに1回
+    void BuildArchetypes(SDL_Renderer* renderer);
+    // プールが必要数に満たなければ最大 budget 体まで作る
+    void PrewarmEnemies(int budget);
+    std::unique_ptr<Enemy> CreatePooledEnemy(int presetIndex);
 
     // 進行状態
     int currentLevelID = 1;
@@ -41,9 +93,23 @@ private:
     State currentState = State::PREPARING;
 
     // 出現管理
-    std::queue<std::string> spawnQueue; // 今回のウェーブで出す敵プリセット名の列
-    float spawnTimer = 0.0f;
-    float spawnInterval = 1.0f;         // 敵が出る間隔（秒）
+    std::vector<SpawnEvent> timeline;          // 今回のウェーブの出現イベント（時刻順）
+    std::vector<StringId> presetNames;
+    std::vector<std::shared_ptr<const EnemyArchetype>> archetypes; // presetNames と同じ順序
+    bool archetypesReady = false;
+
+    // 種類ごとの待機中の敵と、ウェーブ全体で必要な数
+    std::vector<std::vector<std::unique_ptr<Enemy>>> enemyPools;
+    std::vector<int> poolTargets;
+
+    // ウェーブ開始時の負荷の計測（出現処理にかかった最悪の時間）
+    float worstSpawnMs = 0.0f;
+    int spawnedFromPool = 0;
+    int spawnedTotal = 0;
+    std::vector<SpawnLane> lanes;
+    size_t nextEventIndex = 0;
+    float waveTime = 0.0f;                     // ウェーブ開始からの経過時間
+    std::mt19937 rng{ std::random_device{}() };
 
     float prepareTimer = 0.0f;
     const float PREPARE_DURATION = 3.0f; // ウェーブ間の待機時間
@@ -1,16 +1,27 @@
 ﻿#include "Base.h"
 #include "../Core/Game.h"
+#include "../Core/DrawList.h"
 #include "../Core/GameParams.h"
 #include "../Core/GameSession.h"
+#include "../Core/Time.h"
 #include "../TextureManager.h"
 #include <iostream>
 
 Base::Base(float x, float y, int w, int h, SDL_Texture* tex)
-    : GameObject(x, y, w, h, tex), damageFlashTimer(0.0f)
+    : GameObject(x, y, w, h, tex), damageFlashTimer(0.0f), lastKnownHP(-1)
 {
     name = "Base";
     isTrigger = false;
     useGravity = false;
+    affectsNavigation = true; // 流れ場の目的地になる
+}
+
+unsigned int Base::GetConfigDependencies() const {
+    return ConfigSection::Base;
+}
+
+void Base::OnConfigChanged(unsigned int changedSections, SDL_Renderer* renderer) {
+    RefreshConfig(renderer);
 }
 
 void Base::RefreshConfig(SDL_Renderer* renderer) {
@@ -26,29 +37,37 @@ void Base::RefreshConfig(SDL_Renderer* renderer) {
 }
 
 void Base::Update(Game* game) {
+    GameSession& session = GameSession::GetInstance();
+
+    // HPが減っていたら被弾フラッシュを開始する
+    if (lastKnownHP >= 0 && session.currentBaseHP < lastKnownHP) {
+        damageFlashTimer = 0.15f;
+    }
+    lastKnownHP = session.currentBaseHP;
+
     if (damageFlashTimer > 0) {
-        damageFlashTimer -= 0.1f; // 簡易的な被弾演出タイマー
+        damageFlashTimer -= Time::deltaTime; // フレームレートに依存しない秒単位のタイマー
     }
 }
 
-void Base::OnRender(SDL_Renderer* renderer, int drawX, int drawY) {
+void Base::OnRender(DrawList& drawList, int drawX, int drawY) {
     SDL_Rect destRect = { drawX, drawY, width, height };
 
     // ダメージを受けた時に少し赤くする演出（簡易版）
     if (damageFlashTimer > 0) {
-        SDL_SetTextureColorMod(texture, 255, 100, 100);
+        drawList.SetTextureColorMod(texture, 255, 100, 100);
     }
     else {
-        SDL_SetTextureColorMod(texture, 255, 255, 255);
+        drawList.SetTextureColorMod(texture, 255, 255, 255);
     }
 
     if (texture) {
-        SDL_RenderCopyEx(renderer, texture, NULL, &destRect, angle, NULL, SDL_FLIP_NONE);
+        drawList.CopyEx(texture, NULL, &destRect, angle, SDL_FLIP_NONE);
     }
     else {
         // テクスチャがない場合は頑丈そうな鉄扉色
-        SDL_SetRenderDrawColor(renderer, 80, 80, 90, 255);
-        SDL_RenderFillRect(renderer, &destRect);
+        drawList.SetDrawColor(80, 80, 90, 255);
+        drawList.FillRect(destRect);
     }
 
     // --- 拠点HPバーの描画 (マルフーシャ風に拠点直上に表示する場合) ---
@@ -60,13 +79,13 @@ void Base::OnRender(SDL_Renderer* renderer, int drawX, int drawY) {
     SDL_Rect bg = { drawX, drawY - 20, barW, barH };
     SDL_Rect fg = { drawX, drawY - 20, (int)(barW * hpRatio), barH };
 
-    SDL_SetRenderDrawColor(renderer, 30, 30, 30, 255);
-    SDL_RenderFillRect(renderer, &bg);
+    drawList.SetDrawColor(30, 30, 30, 255);
+    drawList.FillRect(bg);
 
     // HP量に応じて色を変える (緑 -> 黄 -> 赤)
-    if (hpRatio > 0.5f) SDL_SetRenderDrawColor(renderer, 0, 255, 120, 255);
-    else if (hpRatio > 0.2f) SDL_SetRenderDrawColor(renderer, 255, 200, 0, 255);
-    else SDL_SetRenderDrawColor(renderer, 255, 50, 50, 255);
+    if (hpRatio > 0.5f) drawList.SetDrawColor(0, 255, 120, 255);
+    else if (hpRatio > 0.2f) drawList.SetDrawColor(255, 200, 0, 255);
+    else drawList.SetDrawColor(255, 50, 50, 255);
 
-    SDL_RenderFillRect(renderer, &fg);
+    drawList.FillRect(fg);
 }
\ No newline at end of file
@@ -9,14 +9,26 @@ public:
     virtual ~Base() {}
 
     void Update(Game* game) override;
+    const char* GetTypeName() const override { return "Base"; }
+
+    // _̑ϋvl GameSession ߁AECS ɂ͐wco
+    void WriteComponents(Registry& registry) const override {
+        GameObject::WriteComponents(registry);
+        registry.Set(entity, Faction{ FactionType::Player });
+    }
 
     // ݒ̔fi摜̍ēǂݍ݂Ȃǁj
     void RefreshConfig(SDL_Renderer* renderer);
 
+    unsigned int GetConfigDependencies() const override;
+    void OnConfigChanged(unsigned int changedSections, SDL_Renderer* renderer) override;
+
 protected:
-    void OnRender(SDL_Renderer* renderer, int drawX, int drawY) override;
+    void OnRender(DrawList& drawList, int drawX, int drawY) override;
 
 private:
     // Iȉopi_[W󂯂̃tbVȂǁj
     float damageFlashTimer;
+    // Ot[̋_HPiĂeooj
+    int lastKnownHP;
 };
\ No newline at end of file
@@ -1,21 +1,26 @@
 ﻿#pragma once
 #include "GameObject.h"
+#include "../Core/DrawList.h"
 
 class Block : public GameObject {
 public:
     Block(float x, float y, int w, int h) : GameObject(x, y, w, h) {
         useGravity = false; // 地面は落ちない
+        isStatic = true;    // 静的レイヤーにキャッシュされる
+        affectsNavigation = true; // 敵は地形を通り抜けられない
         name = "Block";     
     }
 
+    const char* GetTypeName() const override { return "Block"; }
+
     void Update(Game* game) override {
     }
 
-    void OnRender(SDL_Renderer* renderer, int drawX, int drawY) override {
+    void OnRender(DrawList& drawList, int drawX, int drawY) override {
 
         SDL_Rect rect = { drawX, drawY, width, height };
 
-        SDL_SetRenderDrawColor(renderer, 100, 100, 100, 255);
-        SDL_RenderFillRect(renderer, &rect);
+        drawList.SetDrawColor(100, 100, 100, 255);
+        drawList.FillRect(rect);
     }
 };
\ No newline at end of file
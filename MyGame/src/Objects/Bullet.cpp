@@ -1,7 +1,10 @@
 ﻿#include "Bullet.h"
 #include "../Core/Game.h"
+#include "../Core/DrawList.h"
 #include "../Core/Physics.h"
 #include "../Core/GameSession.h"
+#include "../Core/EventBus.h"
+#include "../Core/GameEvents.h"
 #include "Enemy.h"
 #include "Player.h"
 #include "Base.h"
@@ -63,6 +66,11 @@ void Bullet::Update(Game* game) {
     }
 }
 
+void Bullet::WriteComponents(Registry& registry) const {
+    GameObject::WriteComponents(registry);
+    registry.Set(entity, Faction{ side == BulletSide::Player ? FactionType::Player : FactionType::Enemy });
+}
+
 void Bullet::OnTriggerEnter(GameObject* other) {
     if (isDead || other->isDead) return;
 
@@ -73,13 +81,15 @@ void Bullet::OnTriggerEnter(GameObject* other) {
         // 敵への判定
         Enemy* enemy = dynamic_cast<Enemy*>(other);
         if (enemy) {
+            // 火花は EnemyDamagedEvent 側で出すため、ここでは着弾イベントを出さない（二重に出さない）
             enemy->TakeDamage(damageValue);
             isDead = true;
             return;
         }
 
         // 地形に当たった
-        if (other->name == "Editor Ground" || other->name == "Block") {
+        if (other->name == ObjectNames::EditorGround || other->name == ObjectNames::Block) {
+            EmitImpact();
             isDead = true;
             return;
         }
@@ -90,6 +100,7 @@ void Bullet::OnTriggerEnter(GameObject* other) {
         // プレイヤーへの判定
         Player* player = dynamic_cast<Player*>(other);
         if (player) {
+            EmitImpact();
             player->TakeDamage(damageValue);
             isDead = true;
             return;
@@ -98,33 +109,40 @@ void Bullet::OnTriggerEnter(GameObject* other) {
         // 拠点への判定
         Base* baseObj = dynamic_cast<Base*>(other);
         if (baseObj) {
-            // 拠点へのダメージは GameSession 経由で行う
-            GameSession::GetInstance().DamageBase(damageValue);
+            // 拠点へのダメージは GameSession 経由で行う（着弾位置に破片を出す）
+            GameSession::GetInstance().DamageBase(damageValue, x + width / 2.0f, y + height / 2.0f);
             isDead = true;
             return;
         }
 
         // 地形に当たった
-        if (other->name == "Editor Ground" || other->name == "Block") {
+        if (other->name == ObjectNames::EditorGround || other->name == ObjectNames::Block) {
+            EmitImpact();
             isDead = true;
             return;
         }
     }
 }
 
-void Bullet::OnRender(SDL_Renderer* renderer, int drawX, int drawY) {
+void Bullet::EmitImpact() {
+    // 火花は進行方向と逆向きに散らす
+    double backAngle = std::atan2(-velY, -velX) * 180.0 / M_PI;
+    EventBus::GetInstance().Publish(BulletImpactEvent{ x + width / 2.0f, y + height / 2.0f, (float)backAngle });
+}
+
+void Bullet::OnRender(DrawList& drawList, int drawX, int drawY) {
     SDL_Rect destRect = { drawX, drawY, width, height };
 
     if (texture) {
-        SDL_RenderCopyEx(renderer, texture, NULL, &destRect, angle, NULL, SDL_FLIP_NONE);
+        drawList.CopyEx(texture, NULL, &destRect, angle, SDL_FLIP_NONE);
     }
     else {
         // 画像がない場合の色分け（陣営で分ける）
         if (side == BulletSide::Enemy)
-            SDL_SetRenderDrawColor(renderer, 255, 100, 0, 255); // エネミー：オレンジ
+            drawList.SetDrawColor(255, 100, 0, 255); // エネミー：オレンジ
         else
-            SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255); // プレイヤー：黄色
+            drawList.SetDrawColor(255, 255, 0, 255); // プレイヤー：黄色
 
-        SDL_RenderFillRect(renderer, &destRect);
+        drawList.FillRect(destRect);
     }
 }
\ No newline at end of file
@@ -26,13 +26,21 @@ public:
     virtual ~Bullet() {}
 
     void Update(Game* game) override;
+    const char* GetTypeName() const override { return "Bullet"; }
+
+    // 移動の積分は ECS の MovementSystem が行う
+    bool UsesEcsMovement() const override { return true; }
+    void WriteComponents(Registry& registry) const override;
     void OnTriggerEnter(GameObject* other) override;
-    void OnRender(SDL_Renderer* renderer, int drawX, int drawY) override;
+    void OnRender(DrawList& drawList, int drawX, int drawY) override;
 
     int GetDamage() const { return damageValue; }
     BulletSide GetSide() const { return side; }
 
 private:
+    // 着弾を通知する（火花などの演出は購読側で行う）
+    void EmitImpact();
+
     int damageValue;
     BulletSide side; 
 };
\ No newline at end of file
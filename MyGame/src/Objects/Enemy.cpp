@@ -1,16 +1,25 @@
 ﻿#include "Enemy.h"
 #include "../Core/Game.h"
+#include "../Core/DrawList.h"
 #include "../Core/Time.h"
 #include "../Core/Physics.h"
 #include "../Core/GameParams.h" 
 #include "../Core/GameSession.h" 
 #include "../TextureManager.h"
+#include "../GameLogic/FlowField.h"
+#include "../Core/EventBus.h"
+#include "../Core/GameEvents.h"
 #include "Bullet.h"
 #include "Block.h" 
 #include <cmath>
 #include <iostream>
 #include <algorithm> 
 
+namespace {
+    // 拠点（Base Gate）の正面のX座標（敵が目指す位置・近接攻撃の着弾位置）
+    constexpr float BASE_TARGET_X = 150.0f;
+}
+
 Enemy::Enemy(float x, float y, int w, int h, SDL_Texture* tex,
     const std::vector<SDL_FPoint>& path)
     : GameObject(x, y, w, h, tex),
@@ -19,11 +28,81 @@ Enemy::Enemy(float x, float y, int w, int h, SDL_Texture* tex,
 {
     // 初期化時は仮のサイズ（w, h）が入るが、RefreshConfig で画像サイズに上書きされる
     RefreshConfig(nullptr);
-    this->name = "Enemy";
+    this->name = ObjectNames::Enemy;
     this->isTrigger = true;
 }
 
+unsigned int Enemy::GetConfigDependencies() const {
+    return ConfigSection::Enemy;
+}
+
+void Enemy::OnConfigChanged(unsigned int changedSections, SDL_Renderer* renderer) {
+    // ウェーブで出現した敵は、WaveManager が種類ごとに作り直して割り当て直す
+    if (archetype) return;
+    RefreshConfig(renderer);
+}
+
+std::shared_ptr<const EnemyArchetype> EnemyArchetype::Create(const EnemyParams& params, SDL_Renderer* renderer) {
+    auto archetype = std::make_shared<EnemyArchetype>();
+    archetype->params = params;
+
+    if (renderer) {
+        if (!params.texturePath.empty()) {
+            archetype->texture = TextureManager::LoadTexture(params.texturePath, renderer);
+            int realW, realH;
+            if (archetype->texture && SDL_QueryTexture(archetype->texture.get(), NULL, NULL, &realW, &realH) == 0) {
+                archetype->width = realW;
+                archetype->height = realH;
+            }
+        }
+        if (!params.bulletTexturePath.empty()) {
+            archetype->bulletTexture = TextureManager::LoadTexture(params.bulletTexturePath, renderer);
+        }
+    }
+    return archetype;
+}
+
+void Enemy::ApplyArchetype(std::shared_ptr<const EnemyArchetype> newArchetype) {
+    archetype = std::move(newArchetype);
+    if (!archetype) return;
+
+    const EnemyParams& stats = archetype->params;
+    hp = stats.baseHealth;
+    maxHp = stats.baseHealth;
+    moveSpeed = stats.baseSpeed;
+    attackPower = stats.attackPower;
+    attackRange = stats.attackRange;
+    attackInterval = stats.attackInterval;
+    useGravity = (stats.locomotionStyle != LocomotionType::Flying);
+    if (!useGravity) velY = 0.0f;
+
+    texture = archetype->texture.get();
+    bulletTexture = archetype->bulletTexture;
+    width = archetype->width;
+    height = archetype->height;
+}
+
+void Enemy::Activate(float spawnX, float spawnY) {
+    x = spawnX;
+    y = spawnY;
+    velX = 0.0f;
+    velY = 0.0f;
+    hp = maxHp;
+    isDead = false;
+    isGrounded = false;
+    isAttacking = false;
+    attackTimer = 0.0f;
+    jumpTimer = 0.0f;
+    Wake();
+}
+
+const EnemyParams& Enemy::GetParams() const {
+    return archetype ? archetype->params : GameParams::GetInstance().enemy;
+}
+
 void Enemy::RefreshConfig(SDL_Renderer* renderer) {
+    // 現在の敵設定に従う（種類の割り当ては解除する）
+    archetype.reset();
     GameParams& params = GameParams::GetInstance();
     hp = params.enemy.baseHealth;
     maxHp = params.enemy.baseHealth;
@@ -65,10 +144,18 @@ void Enemy::RefreshConfig(SDL_Renderer* renderer) {
 void Enemy::Update(Game* game) {
     if (isDead) return;
 
+    // PathFollow の場合はシーンの流れ場を参照する
+    const FlowField* field = nullptr;
+    if (GetParams().moveMethod == MovementType::PathFollow) {
+        field = game->GetFlowField();
+        if (field && !field->IsReady()) field = nullptr;
+    }
+
     // 拠点（Base Gate）のX座標
-    float targetX = 150.0f;
+    float targetX = BASE_TARGET_X;
 
-    // 拠点までの距離（X軸のみで判定）
+    // 拠点までの距離（X軸のみで判定）。流れ場は進む方向にだけ使う
+    // （流れ場の経路コストは危険度の重み付きでセル単位に丸められており、ピクセルの距離ではないため）
     float distToTarget = std::abs((x + width / 2.0f) - targetX);
 
     // 射程内に入ったら攻撃、そうでなければ移動
@@ -83,23 +170,30 @@ void Enemy::Update(Game* game) {
     }
     else {
         isAttacking = false;
-        MoveLogic();
+        MoveLogic(field);
     }
 }
 
-void Enemy::MoveLogic() {
-    GameParams& params = GameParams::GetInstance();
+void Enemy::MoveLogic(const FlowField* field) {
+    const EnemyParams& stats = GetParams();
     float dt = Time::deltaTime;
-    float targetX = 150.0f;
+    float targetX = BASE_TARGET_X;
     float targetY = 450.0f; // 飛行型が目指す高さ
 
-    if (params.enemy.locomotionStyle == LocomotionType::Jumping) {
+    // 流れ場の進行方向（到達不能なセルでは {0, 0} になり、直線移動に戻る）
+    SDL_FPoint flow = { 0.0f, 0.0f };
+    if (field) {
+        flow = field->GetDirection(x + width / 2.0f, y + height / 2.0f);
+    }
+    bool hasFlow = (flow.x != 0.0f || flow.y != 0.0f);
+
+    if (stats.locomotionStyle == LocomotionType::Jumping) {
         if (isGrounded) {
             jumpTimer += dt;
             if (jumpTimer >= jumpInterval) {
                 jumpTimer = 0;
                 velY = -350.0f; // 上に跳ねる
-                velX = -moveSpeed; // 左に進む
+                velX = (hasFlow && flow.x > 0.0f) ? moveSpeed : -moveSpeed; // 流れ場の向き（既定は左）に進む
                 isGrounded = false;
             }
             else {
@@ -109,7 +203,13 @@ void Enemy::MoveLogic() {
         return;
     }
 
-    if (params.enemy.locomotionStyle == LocomotionType::Flying) {
+    if (stats.locomotionStyle == LocomotionType::Flying) {
+        if (hasFlow) {
+            x += flow.x * moveSpeed * dt;
+            y += flow.y * moveSpeed * dt;
+            return;
+        }
+
         float dx = targetX - (x + width / 2.0f);
         float dy = targetY - (y + height / 2.0f);
         float dist = std::sqrt(dx * dx + dy * dy);
@@ -121,6 +221,12 @@ void Enemy::MoveLogic() {
         return;
     }
 
+    // 地上型は流れ場の水平方向だけを使う（縦方向は重力に任せる）
+    if (hasFlow && flow.x != 0.0f) {
+        x += (flow.x > 0.0f ? moveSpeed : -moveSpeed) * dt;
+        return;
+    }
+
     if (x > targetX) {
         x -= moveSpeed * dt;
         if (x < targetX) x = targetX;
@@ -131,12 +237,12 @@ void Enemy::AttackLogic(Game* game) {
     attackTimer += Time::deltaTime;
     if (attackTimer >= attackInterval) {
         attackTimer = 0.0f;
-        GameParams& params = GameParams::GetInstance();
         GameSession& session = GameSession::GetInstance();
 
-        switch (params.enemy.attackMethod) {
+        switch (GetParams().attackMethod) {
         case AttackType::Melee:
-            session.DamageBase(attackPower);
+            // 拠点の正面の、自分の高さに破片を出す
+            session.DamageBase(attackPower, BASE_TARGET_X, y + height / 2.0f);
             break;
         case AttackType::Ranged:
         {
@@ -148,21 +254,21 @@ void Enemy::AttackLogic(Game* game) {
         }
         break;
         case AttackType::Kamikaze:
-            session.DamageBase(attackPower * 5);
+            session.DamageBase(attackPower * 5, BASE_TARGET_X, y + height / 2.0f);
             isDead = true;
             break;
         }
     }
 }
 
-void Enemy::OnRender(SDL_Renderer* renderer, int drawX, int drawY) {
+void Enemy::OnRender(DrawList& drawList, int drawX, int drawY) {
     SDL_Rect destRect = { drawX, drawY, width, height };
     if (texture) {
-        SDL_RenderCopyEx(renderer, texture, NULL, &destRect, angle, NULL, SDL_FLIP_NONE);
+        drawList.CopyEx(texture, NULL, &destRect, angle, SDL_FLIP_NONE);
     }
     else {
-        SDL_SetRenderDrawColor(renderer, 220, 50, 50, 255);
-        SDL_RenderFillRect(renderer, &destRect);
+        drawList.SetDrawColor(220, 50, 50, 255);
+        drawList.FillRect(destRect);
     }
 
     // HPバーの表示
@@ -170,26 +276,35 @@ void Enemy::OnRender(SDL_Renderer* renderer, int drawX, int drawY) {
     float hpRatio = (maxHp > 0) ? (float)hp / maxHp : 0;
     SDL_Rect bg = { drawX, drawY - 10, width, barH };
     SDL_Rect fg = { drawX, drawY - 10, (int)(width * hpRatio), barH };
-    SDL_SetRenderDrawColor(renderer, 30, 30, 30, 255);
-    SDL_RenderFillRect(renderer, &bg);
-    SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
-    SDL_RenderFillRect(renderer, &fg);
+    drawList.SetDrawColor(30, 30, 30, 255);
+    drawList.FillRect(bg);
+    drawList.SetDrawColor(255, 0, 0, 255);
+    drawList.FillRect(fg);
 }
 
 void Enemy::OnTriggerEnter(GameObject* other) {
     if (isDead || other->isDead) return;
 
-    if (other->name == "Block" || other->name == "Editor Ground") {
+    if (other->name == ObjectNames::Block || other->name == ObjectNames::EditorGround) {
         isGrounded = true;
         velY = 0;
     }
 }
 
+void Enemy::WriteComponents(Registry& registry) const {
+    GameObject::WriteComponents(registry);
+    registry.Set(entity, Health{ hp, maxHp });
+    registry.Set(entity, Faction{ FactionType::Enemy });
+}
+
 void Enemy::TakeDamage(int damage) {
     if (isDead) return;
     hp -= damage;
+
     if (hp <= 0) {
         hp = 0;
         isDead = true;
     }
+
+    EventBus::GetInstance().Publish(EnemyDamagedEvent{ id, x + width / 2.0f, y + height / 2.0f, damage, isDead });
 }
\ No newline at end of file
@@ -1,14 +1,30 @@
 ﻿#pragma once
 #include "GameObject.h"
-#include "../Core/Animator.h"
 #include "../TextureManager.h"
+#include "../Core/GameParams.h"
 #include <vector>
 #include <memory> 
 #include <SDL.h>
 
 class Game;
+class FlowField;
 struct SDL_FPoint;
 
+/**
+ * @brief 敵の種類ごとに前もって解決しておくデータ（プリセットの値・テクスチャ・画像サイズ）
+ * ウェーブの準備中に1種類につき1回だけ作り、同じ種類の敵はこれを共有します。
+ */
+struct EnemyArchetype {
+    EnemyParams params;
+    SharedTexturePtr texture;
+    SharedTexturePtr bulletTexture;
+    int width = 64;
+    int height = 64;
+
+    // テクスチャの読み込みと画像サイズの取得をまとめて行う（renderer が nullptr なら値だけ）
+    static std::shared_ptr<const EnemyArchetype> Create(const EnemyParams& params, SDL_Renderer* renderer);
+};
+
 class Enemy : public GameObject {
 public:
     Enemy(float x, float y, int w, int h, SDL_Texture* tex,
@@ -16,13 +32,27 @@ public:
 
     virtual ~Enemy() {}
     void Update(Game* game) override;
-    void OnRender(SDL_Renderer* renderer, int drawX, int drawY) override;
+    const char* GetTypeName() const override { return "Enemy"; }
+    void WriteComponents(Registry& registry) const override;
+    void OnRender(DrawList& drawList, int drawX, int drawY) override;
     void RefreshConfig(SDL_Renderer* renderer);
+
+    // 種類のデータを割り当てる（テクスチャの読み込みやサイズの問い合わせは行わない）
+    void ApplyArchetype(std::shared_ptr<const EnemyArchetype> newArchetype);
+
+    // プールで待機していた敵を指定位置で出現させる（状態を出現直後に戻す）
+    void Activate(float spawnX, float spawnY);
+
+    unsigned int GetConfigDependencies() const override;
+    void OnConfigChanged(unsigned int changedSections, SDL_Renderer* renderer) override;
     void TakeDamage(int damage);
     void OnTriggerEnter(GameObject* other) override;
 
     float GetCurrentHP() const { return (float)hp; }
 
+    // 割り当てられている種類（エディタで生成した敵は nullptr）
+    const EnemyArchetype* GetArchetype() const { return archetype.get(); }
+
 private:
     int hp;
     int maxHp;
@@ -42,8 +72,11 @@ private:
     // リソース
     SharedTexturePtr bulletTexture;
 
-    void MoveLogic();
+    // 種類が割り当てられていればその値、なければ現在の敵設定（エディタで生成した敵）
+    const EnemyParams& GetParams() const;
+
+    void MoveLogic(const FlowField* field);
     void AttackLogic(Game* game);
 
-    std::unique_ptr<Animator> animator;
+    std::shared_ptr<const EnemyArchetype> archetype;
 };
\ No newline at end of file
@@ -2,8 +2,22 @@
 #include <SDL.h>
 #include <string>
 #include "../Core/Camera.h"
+#include "../Core/ECS.h"
+#include "../Core/Components.h"
+#include "../Core/StringId.h"
 
 class Game;
+class DrawList;
+
+// 判定に使う決まった名前（起動時に一度だけ登録し、比較は番号で行う）
+namespace ObjectNames {
+    inline const StringId Player{ "Player" };
+    inline const StringId TestPlayer{ "TestPlayer" };
+    inline const StringId Enemy{ "Enemy" };
+    inline const StringId TestEnemy{ "Test Enemy" };
+    inline const StringId Block{ "Block" };
+    inline const StringId EditorGround{ "Editor Ground" };
+}
 
 class GameObject {
 public:
@@ -12,15 +26,18 @@ public:
         velX(0), velY(0), accX(0), accY(0),
         useGravity(false), isGrounded(false),
         isTrigger(false),
+        isStatic(false),
+        affectsNavigation(false),
         isDead(false),
-        name("Object")
+        name("Object"),
+        id(NextId())
     {
     }
 
     virtual ~GameObject() {}
     virtual void Update(Game* game) = 0;
 
-    void RenderWithCamera(SDL_Renderer* renderer, Camera* camera) {
+    void RenderWithCamera(DrawList& drawList, Camera* camera) {
         int drawX = (int)x;
         int drawY = (int)y;
 
@@ -28,7 +45,7 @@ public:
             drawX -= (int)camera->x;
             drawY -= (int)camera->y;
         }
-        OnRender(renderer, drawX, drawY);
+        OnRender(drawList, drawX, drawY);
     }
 
     // 衝突時のコールバック
@@ -36,14 +53,50 @@ public:
 
     }
 
+    // エディタの階層ビューでまとめて表示するための種類名
+    virtual const char* GetTypeName() const { return "Object"; }
+
+    // 依存している設定セクション（ConfigSection のビットの組み合わせ）
+    virtual unsigned int GetConfigDependencies() const { return 0; }
+
+    // 依存している設定セクションが変更された時に呼ばれる
+    virtual void OnConfigChanged(unsigned int changedSections, SDL_Renderer* renderer) {}
+
+    // --- ECS への移行用（EcsBridge から呼ばれる） ---
+
+    // 重力・速度の積分を ECS の MovementSystem に任せる種類は true を返す
+    virtual bool UsesEcsMovement() const { return false; }
+
+    // 現在の状態を構成要素として書き出す（種類ごとの要素は派生クラスで足す）
+    virtual void WriteComponents(Registry& registry) const {
+        registry.Set(entity, Transform{ x, y, angle });
+        registry.Set(entity, Velocity{ velX, velY, accX, accY, useGravity });
+        registry.Set(entity, Collider{ width, height, isTrigger, isStatic });
+        registry.Set(entity, Sprite{ texture });
+    }
+
+    // システムが更新した構成要素を取り込む
+    virtual void ReadComponents(const Registry& registry) {
+        if (const Transform* t = registry.TryGet<Transform>(entity)) {
+            x = t->x;
+            y = t->y;
+        }
+        if (const Velocity* v = registry.TryGet<Velocity>(entity)) {
+            velX = v->x;
+            velY = v->y;
+            accX = v->accX;
+            accY = v->accY;
+        }
+    }
+
     void SetPos(float newX, float newY) {
         x = newX;
         y = newY;
     }
 
 protected:
-    // 子クラスで具体的な描画処理を書く
-    virtual void OnRender(SDL_Renderer* renderer, int drawX, int drawY) = 0;
+    // 子クラスで具体的な描画処理を書く（描画命令は drawList に記録する）
+    virtual void OnRender(DrawList& drawList, int drawX, int drawY) = 0;
 
 public:
     // 座標・サイズ
@@ -62,8 +115,32 @@ public:
 
     // フラグ関連
     bool isTrigger;
+    bool isStatic;   // 一切動かない（静的レイヤーキャッシュに焼き込まれる）
+    bool affectsNavigation; // 敵の経路（流れ場）に影響する（地形・拠点・タレット）
     bool isDead;
 
-    // GUI表示用の名前
-    std::string name;
+    // GUI表示用の名前（種類の判定にも使うため、比較は番号で済む StringId で持つ）
+    StringId name;
+
+    // オブジェクトごとの一意な番号（エディタの取り消し操作で対象を指し直すのに使う）
+    unsigned int id;
+
+    // ECS 側の対応するエンティティ（移行していない種類は NullEntity）
+    Entity entity = NullEntity;
+
+    // 接地したまましばらく動かなかった体は眠らせ、積分と押し戻しを省く（Scene が管理する）
+    bool isSleeping = false;
+    int restTicks = 0;   // 続けて静止していたフレーム数
+
+    // 眠っている状態から起こす（外から動かした時などに呼ぶ）
+    void Wake() {
+        isSleeping = false;
+        restTicks = 0;
+    }
+
+private:
+    static unsigned int NextId() {
+        static unsigned int counter = 0;
+        return ++counter;
+    }
 };
\ No newline at end of file
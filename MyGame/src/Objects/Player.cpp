@@ -1,13 +1,16 @@
 ﻿#include "Player.h"
 #include "../Core/Game.h"
+#include "../Core/DrawList.h"
 #include "../Core/InputHandler.h"
 #include "../Core/Camera.h"
 #include "../Core/Time.h"
 #include "../Core/GameParams.h" 
+#include "../Core/EventBus.h"
+#include "../Core/GameEvents.h"
 #include "Bullet.h"
+#include "../Core/Logger.h"
 #include <cmath>
 #include <memory>
-#include <iostream>
 #include <random>
 #include <algorithm> // 追加：std::clamp用
 
@@ -15,6 +18,7 @@
 #define M_PI 3.14159265358979323846
 #endif
 
+
 Player::Player(float x, float y, SDL_Texture* tex, SDL_Texture* bulletTex, Camera* cam)
     : GameObject(x, y, 46, 128, tex),
     currentHealth(GameParams::GetInstance().player.maxHealth),
@@ -25,7 +29,7 @@ Player::Player(float x, float y, SDL_Texture* tex, SDL_Texture* bulletTex, Camer
     angle = 0;
     useGravity = true;
 
-    this->name = "Player";
+    this->name = ObjectNames::Player;
     this->isTrigger = true;
 
     this->bulletTexture = bulletTex;
@@ -35,15 +39,16 @@ Player::Player(float x, float y, SDL_Texture* tex, SDL_Texture* bulletTex, Camer
     // 初期弾数を設定
     currentAmmo = GameParams::GetInstance().gun.magazineSize;
 
-    animator = std::make_unique<Animator>();
-    animator->LoadFromJson("assets/data/player.json");
+    animator.SetClips(AnimationClipSet::Load("assets/data/player.json"));
+    runAnim = animator.Find(StringId("Run"));
+    idleAnim = animator.Find(StringId("Idle"));
 }
 
 void Player::Update(Game* game) {
     InputHandler* input = game->GetInput();
     GameParams& params = GameParams::GetInstance();
 
-    animator->Update();
+    animator.Update();
 
     // 移動ロジック
     float moveSpeed = params.player.moveSpeed;
@@ -58,10 +63,10 @@ void Player::Update(Game* game) {
     }
 
     if (velX != 0) {
-        animator->Play("Run");
+        animator.Play(runAnim);
     }
     else {
-        animator->Play("Idle");
+        animator.Play(idleAnim);
     }
 
     // ジャンプロジック
@@ -82,7 +87,7 @@ void Player::Update(Game* game) {
     if ((wantsReload || currentAmmo <= 0) && !isReloading && currentAmmo < params.gun.magazineSize) {
         isReloading = true;
         reloadTimer = params.gun.reloadTime;
-        std::cout << "Player Reloading..." << std::endl;
+        LOG_DEBUG(LogCategory::Combat, "Player Reloading...");
     }
 
     if (isReloading) {
@@ -90,7 +95,7 @@ void Player::Update(Game* game) {
         if (reloadTimer <= 0) {
             currentAmmo = params.gun.magazineSize;
             isReloading = false;
-            std::cout << "Player Reload Complete!" << std::endl;
+            LOG_DEBUG(LogCategory::Combat, "Player Reload Complete!");
         }
     }
 
@@ -113,6 +118,12 @@ void Player::Update(Game* game) {
             }
         }
         fireCooldown = params.gun.fireRate;
+
+        // 銃口の位置と向き（発砲炎などの演出用）
+        float muzzleX = x + (width / 2.0f) + params.gun.offsetX;
+        float muzzleY = y + (height / 2.0f) + params.gun.offsetY;
+        float aimDegrees = (float)(atan2(worldMouse.y - muzzleY, worldMouse.x - muzzleX) * 180.0 / M_PI);
+        EventBus::GetInstance().Publish(ShotFiredEvent{ muzzleX, muzzleY, aimDegrees });
     }
 
     // --- マップ境界内へのクランプ処理 ---
@@ -129,13 +140,13 @@ void Player::Update(Game* game) {
     if (this->y > maxY) this->y = maxY;
 }
 
-void Player::OnRender(SDL_Renderer* renderer, int drawX, int drawY) {
+void Player::OnRender(DrawList& drawList, int drawX, int drawY) {
     SDL_Rect destRect = { drawX, drawY, width, height };
-    SDL_Rect srcRect = animator->GetSrcRect(width, height);
+    SDL_Rect srcRect = animator.GetSrcRect(width, height);
     SDL_RendererFlip flip = isFlipLeft ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
 
     if (texture) {
-        SDL_RenderCopyEx(renderer, texture, &srcRect, &destRect, angle, NULL, flip);
+        drawList.CopyEx(texture, &srcRect, &destRect, angle, flip);
     }
 
     if (gunTexture) {
@@ -155,13 +166,13 @@ void Player::OnRender(SDL_Renderer* renderer, int drawX, int drawY) {
         SDL_RendererFlip gunFlip = (gunAngle > 90 || gunAngle < -90) ? SDL_FLIP_VERTICAL : SDL_FLIP_NONE;
 
         if (isReloading) {
-            SDL_SetTextureAlphaMod(gunTexture.get(), 128);
+            drawList.SetTextureAlphaMod(gunTexture.get(), 128);
         }
         else {
-            SDL_SetTextureAlphaMod(gunTexture.get(), 255);
+            drawList.SetTextureAlphaMod(gunTexture.get(), 255);
         }
 
-        SDL_RenderCopyEx(renderer, gunTexture.get(), NULL, &gunDest, gunAngle, NULL, gunFlip);
+        drawList.CopyEx(gunTexture.get(), NULL, &gunDest, gunAngle, gunFlip);
     }
 }
 
@@ -198,6 +209,12 @@ std::unique_ptr<Bullet> Player::Shoot(float targetX, float targetY, SDL_Texture*
     );
 }
 
+void Player::WriteComponents(Registry& registry) const {
+    GameObject::WriteComponents(registry);
+    registry.Set(entity, Health{ GetHP(), GetMaxHP() });
+    registry.Set(entity, Faction{ FactionType::Player });
+}
+
 void Player::TakeDamage(int damage) {
     currentHealth -= (float)damage;
     float maxHp = GameParams::GetInstance().player.maxHealth;
@@ -209,6 +226,14 @@ int Player::GetMaxHP() const {
     return (int)GameParams::GetInstance().player.maxHealth;
 }
 
+unsigned int Player::GetConfigDependencies() const {
+    return ConfigSection::Gun;
+}
+
+void Player::OnConfigChanged(unsigned int changedSections, SDL_Renderer* renderer) {
+    RefreshGunConfig(renderer);
+}
+
 void Player::RefreshGunConfig(SDL_Renderer* renderer) {
     std::string path = GameParams::GetInstance().gun.texturePath;
     if (!path.empty()) {
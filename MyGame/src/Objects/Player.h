@@ -26,7 +26,9 @@ public:
     Player(float x, float y, SDL_Texture* tex, SDL_Texture* bulletTex, Camera* cam);
 
     void Update(Game* game) override;
-    void OnRender(SDL_Renderer* renderer, int drawX, int drawY) override;
+    const char* GetTypeName() const override { return "Player"; }
+    void WriteComponents(Registry& registry) const override;
+    void OnRender(DrawList& drawList, int drawX, int drawY) override;
 
     void TakeDamage(int damage);
     int GetHP() const { return (int)currentHealth; }
@@ -34,6 +36,9 @@ public:
 
     // エディタで画像が変更された際などに呼び出してテクスチャを再ロードする
     void RefreshGunConfig(SDL_Renderer* renderer);
+
+    unsigned int GetConfigDependencies() const override;
+    void OnConfigChanged(unsigned int changedSections, SDL_Renderer* renderer) override;
     int GetCurrentAmmo() const { return currentAmmo; }
     bool GetIsReloading() const { return isReloading; }
 
@@ -57,7 +62,10 @@ private:
     float reloadTimer;
     bool isReloading;
 
-    std::unique_ptr<Animator> animator;
+    // クリップの定義は同じファイルを使う全員で共有し、ここには再生状態だけを持つ
+    Animator animator;
+    AnimationHandle runAnim = InvalidAnimation;    // 読み込み時に名前から求めておく
+    AnimationHandle idleAnim = InvalidAnimation;
 
     bool isFlipLeft = false;
 };
\ No newline at end of file
@@ -1,15 +1,16 @@
 ﻿#define _USE_MATH_DEFINES
 #include "Turret.h"
 #include "../Core/Game.h"
+#include "../Core/DrawList.h"
 #include "../Core/Time.h"
 #include "../Core/Physics.h"
 #include "../Objects/Enemy.h"
 #include "../Objects/Bullet.h"
+#include "../Core/Logger.h"
 #include <cmath>
 #include <random>
 #include <algorithm> 
 #include <limits> 
-#include <iostream>
 
 const int TURRET_DEFAULT_SIZE = 32;
 
@@ -25,6 +26,7 @@ Turret::Turret(float x, float y, const WeaponConfig& config, SDL_Texture* tex)
     name = "Turret (" + config.name + ")";
     useGravity = false;
     isTrigger = false;
+    affectsNavigation = true; // 敵はタレット周辺を避けて進む
 
     // 残弾初期化
     currentAmmo = config.magazineSize;
@@ -43,7 +45,7 @@ void Turret::Update(Game* game) {
         if (reloadTimer <= 0) {
             currentAmmo = weaponConfig.magazineSize;
             isReloading = false;
-            std::cout << name << " Reload Complete!" << std::endl;
+            LOG_DEBUG(LogCategory::Combat, name << " Reload Complete!");
         }
         return; // リロード中は索敵・射撃を行わない
     }
@@ -68,12 +70,17 @@ void Turret::Update(Game* game) {
             else {
                 isReloading = true;
                 reloadTimer = weaponConfig.reloadTime;
-                std::cout << name << " Out of ammo! Reloading..." << std::endl;
+                LOG_DEBUG(LogCategory::Combat, name << " Out of ammo! Reloading...");
             }
         }
     }
 }
 
+void Turret::WriteComponents(Registry& registry) const {
+    GameObject::WriteComponents(registry);
+    registry.Set(entity, Faction{ FactionType::Player });
+}
+
 void Turret::FindTarget(const std::vector<std::unique_ptr<GameObject>>& gameObjects) {
     currentTarget = nullptr;
     float rangeSq = weaponConfig.range * weaponConfig.range;
@@ -151,24 +158,24 @@ void Turret::SpawnBullet(Game* game, float initialAngle) {
     game->Instantiate(std::move(bullet));
 }
 
-void Turret::OnRender(SDL_Renderer* renderer, int drawX, int drawY) {
+void Turret::OnRender(DrawList& drawList, int drawX, int drawY) {
     SDL_Rect destRect = { drawX, drawY, width, height };
 
     // リロード中は色を変えるなどの視覚効果
     if (isReloading) {
-        SDL_SetRenderDrawColor(renderer, 100, 100, 100, 255);
+        drawList.SetDrawColor(100, 100, 100, 255);
     }
     else {
-        SDL_SetRenderDrawColor(renderer, 50, 50, 150, 255);
+        drawList.SetDrawColor(50, 50, 150, 255);
     }
 
-    SDL_RenderFillRect(renderer, &destRect);
+    drawList.FillRect(destRect);
 
     int turretCenterX = drawX + width / 2;
     int turretCenterY = drawY + height / 2;
-    SDL_SetRenderDrawColor(renderer, 200, 200, 200, 255);
+    drawList.SetDrawColor(200, 200, 200, 255);
     float angleRad = rotationAngle * ((float)M_PI / 180.0f);
     int lineEndX = turretCenterX + (int)(width * 1.5 * cos(angleRad));
     int lineEndY = turretCenterY + (int)(width * 1.5 * sin(angleRad));
-    SDL_RenderDrawLine(renderer, turretCenterX, turretCenterY, lineEndX, lineEndY);
+    drawList.DrawLine(turretCenterX, turretCenterY, lineEndX, lineEndY);
 }
\ No newline at end of file
@@ -28,7 +28,9 @@ public:
     virtual ~Turret() {}
 
     void Update(Game* game) override;
-    void OnRender(SDL_Renderer* renderer, int drawX, int drawY) override;
+    const char* GetTypeName() const override { return "Turret"; }
+    void WriteComponents(Registry& registry) const override;
+    void OnRender(DrawList& drawList, int drawX, int drawY) override;
     void OnTriggerEnter(GameObject* other) override {}
 
 private:
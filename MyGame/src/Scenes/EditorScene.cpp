@@ -10,15 +10,18 @@
 #include "../TextureManager.h"
 #include "../Core/GameParams.h"
 #include "../Core/GameSession.h" 
-#include "../UI/TextRenderer.h"
+#include "../Core/ParticleSystem.h"
+#include "../Core/EventBus.h"
+#include "../Core/GameEvents.h"
+#include "../Core/DrawList.h"
 #include "TitleScene.h" 
 #include "imgui.h" 
-#include <iostream>
+#include "../Core/Logger.h"
 #include <algorithm>
 #include <string>
 
 EditorScene::EditorScene()
-    : selectedObject(nullptr), testPlayer(nullptr), isSimulating(false)
+    : testPlayer(nullptr), isSimulating(false)
 {
     camera = std::make_unique<Camera>(800, 600);
 
@@ -32,17 +35,26 @@ EditorScene::EditorScene()
     gameObjects.push_back(std::move(baseObj));
 
     auto ground = std::make_unique<Block>(0, 550, 5000, 50);
-    ground->name = "Editor Ground";
+    ground->name = ObjectNames::EditorGround;
     gameObjects.push_back(std::move(ground));
 }
 
 void EditorScene::OnEnter(Game* game) {
-    std::cout << "Entering Editor Scene." << std::endl;
+    LOG_INFO(LogCategory::Scene, "Entering Editor Scene.");
     EditorGUI::SetMode(EditorGUI::Mode::EDITOR);
     EditorGUI::isTestMode = false;
     EditorGUI::isWaveSimMode = false;
     isSimulating = false;
 
+    // シミュレーションの集計は被弾・攻撃のイベントから行う
+    EventBus& bus = EventBus::GetInstance();
+    killSubscription = bus.Subscribe<EnemyDamagedEvent>([this](const EnemyDamagedEvent& e) {
+        if (isSimulating && e.killed) ++simStats.enemiesKilled;
+    });
+    baseDamageSubscription = bus.Subscribe<BaseDamagedEvent>([this](const BaseDamagedEvent& e) {
+        if (isSimulating) simStats.baseDamageTaken += e.damage;
+    });
+
     playerTexture = TextureManager::LoadTexture("assets/images/player.png", game->GetRenderer());
     bulletTexture = TextureManager::LoadTexture("assets/images/bullet.png", game->GetRenderer());
 
@@ -51,41 +63,170 @@ void EditorScene::OnEnter(Game* game) {
         if (b) b->RefreshConfig(game->GetRenderer());
     }
 
+    // 流れ場はカメラのマップ範囲（設定の Map Limit）で作成する
+    camera->SyncWithParams();
+    SyncFlowFieldToMap();
+
     GameSession::GetInstance().ResetSession();
 }
 
+void EditorScene::SyncFlowFieldToMap() {
+    if (camera->limitX == flowFieldWidth && camera->limitY == flowFieldHeight) return;
+    flowFieldWidth = camera->limitX;
+    flowFieldHeight = camera->limitY;
+    flowField.Init(flowFieldWidth, flowFieldHeight);
+}
+
 void EditorScene::OnExit(Game* game) {
+    ParticleSystem::GetInstance().Clear();
+    EventBus& bus = EventBus::GetInstance();
+    bus.ClearPending();
+    bus.Unsubscribe(killSubscription);
+    bus.Unsubscribe(baseDamageSubscription);
+    killSubscription = 0;
+    baseDamageSubscription = 0;
     EditorGUI::SetMode(EditorGUI::Mode::GAME);
-    EditorGUI::selectedObject = nullptr;
+    EditorGUI::ClearSelection();
     testPlayer = nullptr;
     gameObjects.clear();
+    registry.Clear();
+    enemyCount = 0;
+    MarkStructureChanged();
 }
 
 void EditorScene::HandleEvents(Game* game, SDL_Event* event) {
     EditorGUI::HandleEvents(event);
+
+    // デバイスが作り直されると文字列のテクスチャも失われるため描き直させる
+    if (event->type == SDL_RENDER_DEVICE_RESET) {
+        gateLabel.Invalidate();
+        ammoLabel.Invalidate();
+        simLabel.Invalidate();
+    }
+
+    // ドラッグ中にボタンが ImGui のウィンドウ上で離されても選択は終わらせる
+    if (event->type == SDL_MOUSEBUTTONUP && event->button.button == SDL_BUTTON_LEFT && isMouseDown) {
+        isMouseDown = false;
+        bool additive = (SDL_GetModState() & (KMOD_SHIFT | KMOD_CTRL)) != 0;
+        if (isBoxSelecting) {
+            isBoxSelecting = false;
+            SDL_FRect worldRect = {
+                std::min(dragStart.x, dragCurrent.x) + camera->x,
+                std::min(dragStart.y, dragCurrent.y) + camera->y,
+                (float)std::abs(dragCurrent.x - dragStart.x),
+                (float)std::abs(dragCurrent.y - dragStart.y)
+            };
+            BoxSelect(worldRect, additive);
+        }
+        else {
+            PickAt((float)event->button.x + camera->x, (float)event->button.y + camera->y, additive);
+        }
+        return;
+    }
+
     ImGuiIO& io = ImGui::GetIO();
     if (io.WantCaptureMouse || io.WantCaptureKeyboard) return;
 
-    if (event->type == SDL_MOUSEBUTTONDOWN) {
-        if (event->button.button == SDL_BUTTON_LEFT) {
-            float mouseX = (float)event->button.x + camera->x;
-            float mouseY = (float)event->button.y + camera->y;
-            bool found = false;
-            for (auto& obj : gameObjects) {
-                if (mouseX >= obj->x && mouseX <= obj->x + obj->width &&
-                    mouseY >= obj->y && mouseY <= obj->y + obj->height) {
-                    EditorGUI::selectedObject = obj.get();
-                    selectedObject = obj.get();
-                    found = true;
-                    break;
-                }
-            }
-            if (!found) {
-                EditorGUI::selectedObject = nullptr;
-                selectedObject = nullptr;
-            }
+    if (event->type == SDL_MOUSEBUTTONDOWN && event->button.button == SDL_BUTTON_LEFT) {
+        isMouseDown = true;
+        isBoxSelecting = false;
+        dragStart = { event->button.x, event->button.y };
+        dragCurrent = dragStart;
+    }
+    else if (event->type == SDL_MOUSEMOTION && isMouseDown) {
+        dragCurrent = { event->motion.x, event->motion.y };
+        // 少し動かしただけのクリックは矩形選択にしない
+        const int DRAG_THRESHOLD = 4;
+        if (std::abs(dragCurrent.x - dragStart.x) > DRAG_THRESHOLD || std::abs(dragCurrent.y - dragStart.y) > DRAG_THRESHOLD) {
+            isBoxSelecting = true;
+        }
+    }
+}
+
+void EditorScene::OnObjectAdded(GameObject* obj) {
+    if (dynamic_cast<Enemy*>(obj)) ++enemyCount;
+    EditorGUI::OnObjectAdded(obj);
+}
+
+void EditorScene::OnObjectRemoved(GameObject* obj) {
+    if (dynamic_cast<Enemy*>(obj)) --enemyCount;
+    EditorGUI::OnObjectRemoved(obj);
+}
+
+void EditorScene::OnConfigChanged(unsigned int changedSections, SDL_Renderer* renderer) {
+    // シミュレーション中のウェーブの敵（待機中のプールを含む）にも反映する
+    waveManager.ApplyConfigChange(changedSections, renderer, gameObjects);
+}
+
+void EditorScene::CollectObjectsAt(float worldX, float worldY, std::vector<GameObject*>& outObjects) {
+    outObjects.clear();
+    GetSpatialIndex().QueryPoint(worldX, worldY, queryIndices);
+
+    // 静的オブジェクトはキャッシュとして先に描かれるため一番奥。それ以外は配列の後ろほど手前
+    for (auto it = queryIndices.rbegin(); it != queryIndices.rend(); ++it) {
+        GameObject* obj = gameObjects[*it].get();
+        if (!obj->isStatic) outObjects.push_back(obj);
+    }
+    for (auto it = queryIndices.rbegin(); it != queryIndices.rend(); ++it) {
+        GameObject* obj = gameObjects[*it].get();
+        if (obj->isStatic) outObjects.push_back(obj);
+    }
+}
+
+void EditorScene::PickAt(float worldX, float worldY, bool additive) {
+    std::vector<GameObject*> hits;
+    CollectObjectsAt(worldX, worldY, hits);
+
+    if (hits.empty()) {
+        if (!additive) EditorGUI::ClearSelection();
+        lastPickPos = { -1.0f, -1.0f };
+        return;
+    }
+
+    // 前回とほぼ同じ位置のクリックなら、今選択しているものの1つ奥を選ぶ
+    GameObject* target = hits.front();
+    const float CYCLE_RADIUS = 4.0f;
+    bool samePlace = std::abs(worldX - lastPickPos.x) <= CYCLE_RADIUS && std::abs(worldY - lastPickPos.y) <= CYCLE_RADIUS;
+    if (samePlace && !additive && EditorGUI::selectedObject) {
+        auto current = std::find(hits.begin(), hits.end(), EditorGUI::selectedObject);
+        if (current != hits.end()) {
+            ++current;
+            target = (current != hits.end()) ? *current : hits.front();
         }
     }
+    lastPickPos = { worldX, worldY };
+
+    EditorGUI::SelectObject(target, additive);
+}
+
+void EditorScene::BoxSelect(const SDL_FRect& worldRect, bool additive) {
+    GetSpatialIndex().QueryRect(worldRect, queryIndices);
+
+    std::vector<GameObject*> hits;
+    hits.reserve(queryIndices.size());
+    for (int index : queryIndices) {
+        hits.push_back(gameObjects[index].get());
+    }
+    EditorGUI::SelectObjects(hits, additive);
+    lastPickPos = { -1.0f, -1.0f };
+}
+
+void EditorScene::RenderSelection(DrawList& drawList) {
+    for (GameObject* obj : EditorGUI::selectedObjects) {
+        SDL_Rect rect = { (int)(obj->x - camera->x), (int)(obj->y - camera->y), obj->width, obj->height };
+        if (obj == EditorGUI::selectedObject) drawList.SetDrawColor(255, 255, 0, 255);
+        else drawList.SetDrawColor(255, 200, 80, 160);
+        drawList.DrawRect(rect);
+    }
+
+    if (isBoxSelecting) {
+        SDL_Rect box = {
+            std::min(dragStart.x, dragCurrent.x), std::min(dragStart.y, dragCurrent.y),
+            std::abs(dragCurrent.x - dragStart.x), std::abs(dragCurrent.y - dragStart.y)
+        };
+        drawList.SetDrawColor(120, 200, 255, 255);
+        drawList.DrawRect(box);
+    }
 }
 
 void EditorScene::SpawnTestEnemy(SDL_Renderer* renderer, Game* game) {
@@ -94,25 +235,116 @@ void EditorScene::SpawnTestEnemy(SDL_Renderer* renderer, Game* game) {
 
     // 64, 64 はプレースホルダー。RefreshConfig で画像サイズに補正される。
     auto enemy = std::make_unique<Enemy>(spawnX, spawnY, 64, 64, nullptr, enemyPath);
-    enemy->name = "Enemy";
+    enemy->name = ObjectNames::Enemy;
     enemy->RefreshConfig(renderer);
 
     game->Instantiate(std::move(enemy));
 }
 
-void EditorScene::OnUpdate(Game* game) {
+bool EditorScene::HandleFrameInput(Game* game) {
     if (game->GetInput()->IsJustPressed(GameAction::Pause)) {
         game->ChangeScene(new TitleScene());
+        return false;
+    }
+
+    // 文字入力中は ImGui 側のテキストの取り消しに任せる
+    if (!ImGui::GetIO().WantTextInput) {
+        if (game->GetInput()->IsJustPressed(GameAction::Undo)) EditorGUI::Undo();
+        else if (game->GetInput()->IsJustPressed(GameAction::Redo)) EditorGUI::Redo();
+    }
+    return true;
+}
+
+void EditorScene::Advance(Game* game) {
+    if (!HandleFrameInput(game)) {
+        Update(game);
+        return;
+    }
+
+    bool fastForward = EditorGUI::isWaveSimMode && (EditorGUI::simTimeScale > 1 || EditorGUI::runToWaveEnd);
+    if (!fastForward) {
+        simAccumulator = 0.0f;
+        runToEndWave = -1;
+        EditorGUI::runToWaveEnd = false;
+        Update(game);
+        if (isSimulating) UpdateSimStats(1, Time::deltaTime);
         return;
     }
 
+    // 描画は1回のまま、倍率分の固定ステップを進める（描画フレームあたりの実時間には上限を設ける）
+    const float realDelta = Time::deltaTime;
+    simAccumulator += realDelta * (float)EditorGUI::simTimeScale;
+    if (EditorGUI::runToWaveEnd) simAccumulator = 1.0e9f;
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    Uint64 budget = (Uint64)(SDL_GetPerformanceFrequency() * SIM_FRAME_BUDGET);
+    int ticks = 0;
+    bool overBudget = false;
+
+    {
+        // ティックの間だけ固定ステップにする（ループをどこで抜けても描画フレームの値に戻る）
+        Time::ScopedDeltaTime fixedStep(SIM_TICK);
+        while (simAccumulator >= SIM_TICK) {
+            if (SDL_GetPerformanceCounter() - start > budget) {
+                overBudget = true;
+                break;
+            }
+            Update(game);
+            simAccumulator -= SIM_TICK;
+            ++ticks;
+
+            if (EditorGUI::runToWaveEnd && isSimulating) {
+                if (runToEndWave < 0) runToEndWave = waveManager.GetCurrentWaveNumber();
+                bool finished = waveManager.GetState() == WaveManager::State::LEVEL_COMPLETED ||
+                    waveManager.GetCurrentWaveNumber() != runToEndWave;
+                if (finished) {
+                    EditorGUI::runToWaveEnd = false;
+                    runToEndWave = -1;
+                    simAccumulator = 0.0f;
+                    break;
+                }
+            }
+        }
+    }
+
+    // 追いつけなかった分は持ち越さない（持ち越すと処理落ちが続いてしまう）
+    if (overBudget || EditorGUI::runToWaveEnd) simAccumulator = 0.0f;
+
+    float wallSeconds = (float)(SDL_GetPerformanceCounter() - start) / (float)SDL_GetPerformanceFrequency();
+    simStats.cpuBound = overBudget;
+    UpdateSimStats(ticks, std::max(wallSeconds, realDelta));
+}
+
+void EditorScene::UpdateSimStats(int ticks, float wallSeconds) {
+    simStats.ticksLastFrame = ticks;
+    simStats.targetTicksPerSecond = EditorGUI::runToWaveEnd ? 0.0f : EditorGUI::simTimeScale / SIM_TICK;
+
+    // ティック/秒は 0.5 秒ごとにまとめて更新する（毎フレームだと値が揺れて読めない）
+    statTicks += ticks;
+    statWallSeconds += wallSeconds;
+    if (statWallSeconds >= 0.5f) {
+        simStats.ticksPerSecond = statTicks / statWallSeconds;
+        statTicks = 0;
+        statWallSeconds = 0.0f;
+    }
+}
+
+void EditorScene::OnUpdate(Game* game) {
     if (EditorGUI::isWaveSimMode) {
         if (!isSimulating) {
             GameSession::GetInstance().ResetSession();
             waveManager.Init(EditorGUI::simLevelID);
             isSimulating = true;
+            simStats = WaveSimStats();
+            simStats.lowestBaseHP = GameSession::GetInstance().currentBaseHP;
         }
         waveManager.Update(game);
+
+        // HUD 用の集計（早送り中も全ティック分を集計する。敵の数は追加・削除の通知で数えておいたもの）
+        simStats.simulatedSeconds += Time::deltaTime;
+        simStats.enemiesAlive = enemyCount;
+        simStats.peakEnemies = std::max(simStats.peakEnemies, enemyCount);
+        simStats.lowestBaseHP = std::min(simStats.lowestBaseHP, GameSession::GetInstance().currentBaseHP);
     }
     else {
         if (isSimulating) {
@@ -128,7 +360,7 @@ void EditorScene::OnUpdate(Game* game) {
     if (EditorGUI::isTestMode) {
         if (!testPlayer) {
             auto pPtr = std::make_unique<Player>(400, 100, playerTexture.get(), bulletTexture.get(), camera.get());
-            pPtr->name = "TestPlayer";
+            pPtr->name = ObjectNames::TestPlayer;
             testPlayer = pPtr.get();
             game->Instantiate(std::move(pPtr));
         }
@@ -141,54 +373,101 @@ void EditorScene::OnUpdate(Game* game) {
         camera->Follow(nullptr);
     }
 
-    if (selectedObject && selectedObject->isDead) {
-        selectedObject = nullptr;
-        EditorGUI::selectedObject = nullptr;
-    }
+    // エディタでマップの広さを変えた場合は流れ場を作り直す
+    SyncFlowFieldToMap();
+
     if (testPlayer && testPlayer->isDead) {
         testPlayer = nullptr;
     }
 }
 
+void EditorScene::RenderRoutePreview(DrawList& drawList) {
+    if (!flowField.IsReady()) return;
+
+    // ウェーブの出現位置（画面右端の外側）から数本のルートを引く
+    if (routePreview.empty() || routePreviewVersion != flowField.GetVersion()) {
+        static const float SAMPLE_Y[] = { 50.0f, 166.0f, 283.0f, 400.0f };
+        routePreview.resize(sizeof(SAMPLE_Y) / sizeof(SAMPLE_Y[0]));
+        for (size_t i = 0; i < routePreview.size(); ++i) {
+            flowField.TracePath(1300.0f, SAMPLE_Y[i], routePreview[i]);
+        }
+        routePreviewVersion = flowField.GetVersion();
+    }
+
+    std::vector<SDL_FPoint> screenPoints;
+    drawList.SetDrawColor(255, 140, 0, 255);
+    for (const auto& route : routePreview) {
+        if (route.size() < 2) continue;
+        screenPoints.resize(route.size());
+        for (size_t i = 0; i < route.size(); ++i) {
+            screenPoints[i] = { route[i].x - camera->x, route[i].y - camera->y };
+        }
+        drawList.DrawLinesF(screenPoints.data(), (int)screenPoints.size());
+    }
+}
+
 void EditorScene::Render(Game* game) {
-    SDL_Renderer* renderer = game->GetRenderer();
-    SDL_SetRenderDrawColor(renderer, 50, 50, 50, 255);
-    SDL_RenderClear(renderer);
+    DrawList& drawList = game->GetDrawList();
+    drawList.SetDrawColor(50, 50, 50, 255);
+    drawList.Clear();
 
+    staticLayer.Render(drawList, camera.get(), gameObjects);
     for (const auto& obj : gameObjects) {
-        if (obj) obj->RenderWithCamera(renderer, camera.get());
+        if (obj && !obj->isStatic) obj->RenderWithCamera(drawList, camera.get());
     }
+    ParticleSystem::GetInstance().Render(drawList, camera.get());
+
+    if (EditorGUI::showEnemyRoutes) {
+        RenderRoutePreview(drawList);
+    }
+    RenderSelection(drawList);
 
     GameSession& session = GameSession::GetInstance();
     float hpRatio = (session.maxBaseHP > 0) ? (float)session.currentBaseHP / session.maxBaseHP : 0;
     SDL_Rect barBG = { 200, 20, 400, 20 };
     SDL_Rect barFG = { 200, 20, (int)(400 * hpRatio), 20 };
-    SDL_SetRenderDrawColor(renderer, 20, 20, 20, 255);
-    SDL_RenderFillRect(renderer, &barBG);
-    if (hpRatio > 0.5f) SDL_SetRenderDrawColor(renderer, 0, 200, 50, 255);
-    else if (hpRatio > 0.2f) SDL_SetRenderDrawColor(renderer, 255, 200, 0, 255);
-    else SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
-    SDL_RenderFillRect(renderer, &barFG);
-    TextRenderer::Draw(renderer, "GATE STATUS", barBG.x, barBG.y - 15, { 255, 255, 255, 255 });
-
-    std::string ammoText = "Ammo: 0 / 0";
-    SDL_Color textColor = { 200, 200, 200, 255 };
-    if (testPlayer && !testPlayer->isDead) {
-        int current = testPlayer->GetCurrentAmmo();
-        int max = GameParams::GetInstance().gun.magazineSize;
-        ammoText = "Ammo: " + std::to_string(current) + " / " + std::to_string(max);
-        textColor = { 255, 255, 255, 255 };
-        if (testPlayer->GetIsReloading()) {
-            ammoText += " (RELOADING...)";
-            textColor = { 255, 255, 0, 255 };
+    drawList.SetDrawColor(20, 20, 20, 255);
+    drawList.FillRect(barBG);
+    if (hpRatio > 0.5f) drawList.SetDrawColor(0, 200, 50, 255);
+    else if (hpRatio > 0.2f) drawList.SetDrawColor(255, 200, 0, 255);
+    else drawList.SetDrawColor(255, 0, 0, 255);
+    drawList.FillRect(barFG);
+    if (gateLabel.Bind(0)) {
+        gateLabel.SetText("GATE STATUS", { 255, 255, 255, 255 });
+    }
+    gateLabel.SetPosition(barBG.x, barBG.y - 15);
+    gateLabel.Render(drawList);
+
+    // 文字列は値が変わった時だけ作り直す（-1 はテストプレイヤーがいない状態）
+    bool hasPlayer = testPlayer && !testPlayer->isDead;
+    int current = hasPlayer ? testPlayer->GetCurrentAmmo() : -1;
+    int max = hasPlayer ? GameParams::GetInstance().gun.magazineSize : -1;
+    bool reloading = hasPlayer && testPlayer->GetIsReloading();
+    if (ammoLabel.Bind(current, max, reloading ? 1 : 0)) {
+        std::string ammoText = "Ammo: 0 / 0";
+        SDL_Color textColor = { 200, 200, 200, 255 };
+        if (hasPlayer) {
+            ammoText = "Ammo: " + std::to_string(current) + " / " + std::to_string(max);
+            textColor = { 255, 255, 255, 255 };
+            if (reloading) {
+                ammoText += " (RELOADING...)";
+                textColor = { 255, 255, 0, 255 };
+            }
         }
+        ammoLabel.SetText(ammoText, textColor);
     }
-    TextRenderer::Draw(renderer, ammoText, 20, 550, textColor);
+    ammoLabel.Render(drawList);
 
     if (isSimulating) {
-        std::string simInfo = "SIMULATING LEVEL " + std::to_string(EditorGUI::simLevelID) + " - WAVE " + std::to_string(waveManager.GetCurrentWaveNumber());
-        TextRenderer::Draw(renderer, simInfo, 20, 20, { 255, 100, 100, 255 });
+        int waveNumber = waveManager.GetCurrentWaveNumber();
+        if (simLabel.Bind(EditorGUI::simLevelID, waveNumber, EditorGUI::runToWaveEnd ? 1 : 0, EditorGUI::simTimeScale)) {
+            std::string simInfo = "SIMULATING LEVEL " + std::to_string(EditorGUI::simLevelID) + " - WAVE " + std::to_string(waveNumber);
+            if (EditorGUI::runToWaveEnd) simInfo += " (RUN TO END)";
+            else if (EditorGUI::simTimeScale > 1) simInfo += " (x" + std::to_string(EditorGUI::simTimeScale) + ")";
+            simLabel.SetText(simInfo, { 255, 100, 100, 255 });
+        }
+        simLabel.Render(drawList);
     }
 
-    EditorGUI::Render(renderer, this, game);
+    EditorGUI::Render(drawList, this, game);
 }
\ No newline at end of file
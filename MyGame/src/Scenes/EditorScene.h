@@ -9,8 +9,27 @@
 #include "../Core/Camera.h"
 #include "../TextureManager.h"
 #include "../GameLogic/WaveManager.h" 
+#include "../Core/EventBus.h"
+#include "../UI/HudText.h"
 
 class Game;
+class DrawList;
+
+/**
+ * @brief ウェーブのシミュレーションの集計（早送り中は複数ティック分をまとめて表示する）
+ */
+struct WaveSimStats {
+    float simulatedSeconds = 0.0f;     // シミュレーション開始からのゲーム内時間
+    int ticksLastFrame = 0;            // 直前の描画フレームで処理したティック数
+    float ticksPerSecond = 0.0f;       // 実際に処理できた1秒あたりのティック数
+    float targetTicksPerSecond = 0.0f; // 倍率から求めた目標のティック数
+    bool cpuBound = false;             // 処理が追いつかず目標の倍率を出せていない
+    int enemiesAlive = 0;
+    int peakEnemies = 0;               // シミュレーション中の最大同時出現数
+    int lowestBaseHP = 0;
+    int enemiesKilled = 0;             // イベントの購読で集計する
+    int baseDamageTaken = 0;
+};
 
 class EditorScene : public Scene {
 public:
@@ -25,6 +44,12 @@ public:
 
     void OnUpdate(Game* game) override;
 
+    // ウェーブのシミュレーション中は、倍率に応じて固定ステップの Update を複数回行う
+    void Advance(Game* game) override;
+
+    const WaveSimStats& GetSimStats() const { return simStats; }
+    const WaveManager& GetWaveManager() const { return waveManager; }
+
     bool ShowImGui() const override { return true; };
 
     std::vector<std::unique_ptr<GameObject>>& GetObjects() override { return gameObjects; }
@@ -43,6 +68,23 @@ private:
     WaveManager waveManager;
     bool isSimulating = false;
 
+    // --- 早送り ---
+    static constexpr float SIM_TICK = 1.0f / 60.0f;     // 早送り時の固定ステップ（秒）
+    static constexpr float SIM_FRAME_BUDGET = 0.030f;  // 1描画フレームでシミュレーションに使う実時間の上限（秒）
+
+    // 描画フレームごとの入力処理（ティックごとに繰り返すと1回の入力が何度も効いてしまう）
+    bool HandleFrameInput(Game* game);
+    void UpdateSimStats(int ticks, float wallSeconds);
+
+    float simAccumulator = 0.0f;
+    int runToEndWave = -1;          // 「ウェーブ終了まで実行」の対象ウェーブ（-1 なら未使用）
+    WaveSimStats simStats;
+    EventBus::SubscriptionId killSubscription = 0;
+    EventBus::SubscriptionId baseDamageSubscription = 0;
+    int enemyCount = 0;             // シーン内の敵の数（追加・削除の通知で数える。ティックごとに一覧を走査しない）
+    int statTicks = 0;              // ティック/秒を計測するための積算
+    float statWallSeconds = 0.0f;
+
     // テストプレイ用のポインタ
     Player* testPlayer = nullptr;
 
@@ -50,5 +92,39 @@ private:
     SharedTexturePtr playerTexture;
     SharedTexturePtr bulletTexture;
 
-    GameObject* selectedObject = nullptr;
+    // 流れ場をカメラのマップ範囲に合わせる（範囲が変わった時だけ作り直す）
+    void SyncFlowFieldToMap();
+    int flowFieldWidth = 0;
+    int flowFieldHeight = 0;
+
+    // 画面上の文字列（値が変わった時だけラスタライズし直す）
+    HudText gateLabel{ 200, 5 };
+    HudText ammoLabel{ 20, 550 };
+    HudText simLabel{ 20, 20 };
+
+    void OnConfigChanged(unsigned int changedSections, SDL_Renderer* renderer) override;
+
+    // --- マウスでの選択 ---
+    void OnObjectAdded(GameObject* obj) override;
+    void OnObjectRemoved(GameObject* obj) override;
+
+    // 指定位置のオブジェクトを手前（後から描画されるもの）から順に集める
+    void CollectObjectsAt(float worldX, float worldY, std::vector<GameObject*>& outObjects);
+    // クリックでの選択。同じ位置を続けてクリックすると重なっている奥のオブジェクトへ順に切り替える
+    void PickAt(float worldX, float worldY, bool additive);
+    // ドラッグした矩形に重なるオブジェクトをまとめて選択する
+    void BoxSelect(const SDL_FRect& worldRect, bool additive);
+    void RenderSelection(DrawList& drawList);
+
+    bool isMouseDown = false;
+    bool isBoxSelecting = false;
+    SDL_Point dragStart = { 0, 0 };    // 画面座標
+    SDL_Point dragCurrent = { 0, 0 };
+    SDL_FPoint lastPickPos = { -1.0f, -1.0f };
+    std::vector<int> queryIndices;      // 空間インデックスの検索結果（使い回す）
+
+    // 敵ルートのプレビュー（流れ場が更新された時だけ引き直す）
+    void RenderRoutePreview(DrawList& drawList);
+    std::vector<std::vector<SDL_FPoint>> routePreview;
+    unsigned int routePreviewVersion = 0;
 };
\ No newline at end of file
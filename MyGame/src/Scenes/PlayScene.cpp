@@ -5,18 +5,20 @@
 #include "../Core/Physics.h"
 #include "../Core/GameParams.h"
 #include "../Core/GameSession.h"
+#include "../Core/ParticleSystem.h"
+#include "../Core/EventBus.h"
 #include "../Objects/Block.h"
 #include "../Objects/Enemy.h"
 #include "../Objects/Base.h"
 #include "../TextureManager.h"
-#include "../UI/TextRenderer.h"
+#include "../Core/DrawList.h"
 #include "TitleScene.h"
-#include <iostream>
+#include "../Core/Logger.h"
 #include <string>
 #include <algorithm>
 
 void PlayScene::OnEnter(Game* game) {
-    std::cout << "Entering PlayScene... Start Defense." << std::endl;
+    LOG_INFO(LogCategory::Scene, "Entering PlayScene... Start Defense.");
 
     // 1. セッションの初期化
     GameSession::GetInstance().ResetSession();
@@ -39,13 +41,13 @@ void PlayScene::OnEnter(Game* game) {
 
     // 5. 地面の生成
     auto ground = std::make_unique<Block>(0, 550, 5000, 50);
-    ground->name = "Block"; // 物理演算対象にするための固定名
+    ground->name = ObjectNames::Block; // 物理演算対象にするための固定名
     ground->useGravity = false; // 地面自体は落下させない
     gameObjects.push_back(std::move(ground));
 
     // 6. プレイヤーの生成
     auto pPtr = std::make_unique<Player>(400, 100, playerTexture.get(), bulletTexture.get(), camera.get());
-    pPtr->name = "Player";
+    pPtr->name = ObjectNames::Player;
 
     // プレイヤーの画像サイズを自動取得して当たり判定を補正
     if (playerTexture) {
@@ -59,19 +61,33 @@ void PlayScene::OnEnter(Game* game) {
     player = pPtr.get();
     gameObjects.push_back(std::move(pPtr));
 
-    // 7. ウェーブマネージャーの開始（レベル1から）
+    // 7. 拠点へ向かう流れ場の作成（マップ全体）
+    flowField.Init(camera->limitX, camera->limitY);
+
+    // 8. ウェーブマネージャーの開始（レベル1から）
     waveManager.Init(1);
 }
 
 void PlayScene::OnExit(Game* game) {
+    ParticleSystem::GetInstance().Clear();
+    EventBus::GetInstance().ClearPending();
     player = nullptr;
     gameObjects.clear();
+    registry.Clear();
 }
 
 void PlayScene::HandleEvents(Game* game, SDL_Event* event) {
     if (event->type == SDL_QUIT) {
         game->Quit();
     }
+
+    // デバイスが作り直されると HUD のテクスチャも失われるため描き直させる
+    if (event->type == SDL_RENDER_DEVICE_RESET) {
+        gateLabel.Invalidate();
+        dayLabel.Invalidate();
+        statusLabel.Invalidate();
+        ammoLabel.Invalidate();
+    }
 }
 
 void PlayScene::OnUpdate(Game* game) {
@@ -83,7 +99,7 @@ void PlayScene::OnUpdate(Game* game) {
 
     // --- ゲームオーバー判定 ---
     if (GameSession::GetInstance().currentBaseHP <= 0) {
-        std::cout << "GATE DESTROYED... GAME OVER" << std::endl;
+        LOG_INFO(LogCategory::Scene, "GATE DESTROYED... GAME OVER");
         game->ChangeScene(new TitleScene());
         return;
     }
@@ -101,18 +117,29 @@ void PlayScene::OnUpdate(Game* game) {
     }
 }
 
+void PlayScene::OnConfigChanged(unsigned int changedSections, SDL_Renderer* renderer) {
+    // 出現済みの敵と待機中のプールの敵に、作り直した種類のデータを割り当てる
+    waveManager.ApplyConfigChange(changedSections, renderer, gameObjects);
+}
+
 void PlayScene::Render(Game* game) {
-    SDL_Renderer* renderer = game->GetRenderer();
+    DrawList& drawList = game->GetDrawList();
 
     // 背景色（サバイバル感のある暗い紺色）
-    SDL_SetRenderDrawColor(renderer, 30, 35, 50, 255);
-    SDL_RenderClear(renderer);
+    drawList.SetDrawColor(30, 35, 50, 255);
+    drawList.Clear();
+
+    // 地面などの静的オブジェクトはチャンクキャッシュから転送する
+    staticLayer.Render(drawList, camera.get(), gameObjects);
 
-    // 全オブジェクトの描画（カメラ位置を考慮）
+    // 動的オブジェクトの描画（カメラ位置を考慮）
     for (const auto& obj : gameObjects) {
-        if (obj) obj->RenderWithCamera(renderer, camera.get());
+        if (obj && !obj->isStatic) obj->RenderWithCamera(drawList, camera.get());
     }
 
+    // パーティクル（エフェクトごとに1回の描画命令にまとめる）
+    ParticleSystem::GetInstance().Render(drawList, camera.get());
+
     // --- UI 描画エリア ---
 
     // 拠点HPバー（中央上部）
@@ -122,47 +149,63 @@ void PlayScene::Render(Game* game) {
     SDL_Rect barBG = { 200, 30, 400, 15 };
     SDL_Rect barFG = { 200, 30, (int)(400 * hpRatio), 15 };
 
-    SDL_SetRenderDrawColor(renderer, 20, 20, 20, 255); // バーの背景
-    SDL_RenderFillRect(renderer, &barBG);
+    drawList.SetDrawColor(20, 20, 20, 255); // バーの背景
+    drawList.FillRect(barBG);
 
     // HP残量に応じた色変化
-    if (hpRatio > 0.5f) SDL_SetRenderDrawColor(renderer, 0, 255, 100, 255); // 安全：緑
-    else if (hpRatio > 0.2f) SDL_SetRenderDrawColor(renderer, 255, 200, 0, 255); // 警告：黄
-    else SDL_SetRenderDrawColor(renderer, 255, 50, 50, 255); // 危険：赤
+    if (hpRatio > 0.5f) drawList.SetDrawColor(0, 255, 100, 255); // 安全：緑
+    else if (hpRatio > 0.2f) drawList.SetDrawColor(255, 200, 0, 255); // 警告：黄
+    else drawList.SetDrawColor(255, 50, 50, 255); // 危険：赤
 
-    SDL_RenderFillRect(renderer, &barFG);
-    TextRenderer::Draw(renderer, "GATE INTEGRITY", 200, 12, { 255, 255, 255, 255 });
+    drawList.FillRect(barFG);
+
+    // 文字列は値が変わった時だけ作り直し、普段はキャッシュしたテクスチャを貼るだけにする
+    if (gateLabel.Bind(0)) {
+        gateLabel.SetText("GATE INTEGRITY", { 255, 255, 255, 255 });
+    }
+    gateLabel.Render(drawList);
 
     // ウェーブ（生存日数）表示（左上）
-    std::string dayText = "SURVIVAL DAY: " + std::to_string(waveManager.GetCurrentWaveNumber());
-    TextRenderer::Draw(renderer, dayText, 20, 20, { 255, 255, 0, 255 });
+    int waveNumber = waveManager.GetCurrentWaveNumber();
+    if (dayLabel.Bind(waveNumber)) {
+        dayLabel.SetText("SURVIVAL DAY: " + std::to_string(waveNumber), { 255, 255, 0, 255 });
+    }
+    dayLabel.Render(drawList);
 
     // 状況説明テキスト
-    std::string statusText = "";
-    switch (waveManager.GetState()) {
-    case WaveManager::State::PREPARING: statusText = "NEXT WAVE APPROACHING..."; break;
-    case WaveManager::State::SPAWNING:  statusText = "ENEMY DETECTED!"; break;
-    case WaveManager::State::BATTLE:    statusText = "ELIMINATE REMAINING HOSTILES"; break;
-    case WaveManager::State::LEVEL_COMPLETED: statusText = "MISSION ACCOMPLISHED!"; break;
+    WaveManager::State waveState = waveManager.GetState();
+    if (statusLabel.Bind((int)waveState)) {
+        std::string statusText = "";
+        switch (waveState) {
+        case WaveManager::State::PREPARING: statusText = "NEXT WAVE APPROACHING..."; break;
+        case WaveManager::State::SPAWNING:  statusText = "ENEMY DETECTED!"; break;
+        case WaveManager::State::BATTLE:    statusText = "ELIMINATE REMAINING HOSTILES"; break;
+        case WaveManager::State::LEVEL_COMPLETED: statusText = "MISSION ACCOMPLISHED!"; break;
+        }
+        statusLabel.SetText(statusText, { 200, 200, 200, 255 });
     }
-    TextRenderer::Draw(renderer, statusText, 20, 50, { 200, 200, 200, 255 });
+    statusLabel.Render(drawList);
 
     // プレイヤーUI (体力バーの下に弾数を表示)
     if (player && !player->isDead) {
         int currentAmmo = player->GetCurrentAmmo();
         int maxAmmo = GameParams::GetInstance().gun.magazineSize;
-        std::string ammoStr = "AMMO: " + std::to_string(currentAmmo) + " / " + std::to_string(maxAmmo);
-
-        SDL_Color ammoCol = { 255, 255, 255, 255 };
-        if (player->GetIsReloading()) {
-            ammoStr = "RELOADING...";
-            ammoCol = { 255, 100, 0, 255 };
-        }
-        else if (currentAmmo == 0) {
-            ammoCol = { 255, 50, 50, 255 };
+        bool reloading = player->GetIsReloading();
+
+        if (ammoLabel.Bind(currentAmmo, maxAmmo, reloading ? 1 : 0)) {
+            std::string ammoStr = "AMMO: " + std::to_string(currentAmmo) + " / " + std::to_string(maxAmmo);
+            SDL_Color ammoCol = { 255, 255, 255, 255 };
+            if (reloading) {
+                ammoStr = "RELOADING...";
+                ammoCol = { 255, 100, 0, 255 };
+            }
+            else if (currentAmmo == 0) {
+                ammoCol = { 255, 50, 50, 255 };
+            }
+            ammoLabel.SetText(ammoStr, ammoCol);
         }
 
         // 中央の体力バー(y=30, h=15)のすぐ下、y=52に配置
-        TextRenderer::Draw(renderer, ammoStr, 200, 52, ammoCol);
+        ammoLabel.Render(drawList);
     }
 }
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include "../Core/Camera.h"
 #include "../TextureManager.h"
 #include "../GameLogic/WaveManager.h"
+#include "../UI/HudText.h"
 
 class Game;
 
@@ -31,6 +32,9 @@ public:
 
     SDL_Texture* GetBulletTexturePtr() const { return bulletTexture.get(); }
 
+protected:
+    void OnConfigChanged(unsigned int changedSections, SDL_Renderer* renderer) override;
+
 private:
     std::vector<std::unique_ptr<GameObject>> gameObjects;
     std::unique_ptr<Camera> camera;
@@ -44,4 +48,10 @@ private:
     // リソース保持
     SharedTexturePtr playerTexture;
     SharedTexturePtr bulletTexture;
+
+    // HUD の文字列（値が変わった時だけラスタライズし直す）
+    HudText gateLabel{ 200, 12 };
+    HudText dayLabel{ 20, 20 };
+    HudText statusLabel{ 20, 50 };
+    HudText ammoLabel{ 200, 52 };
 };
\ No newline at end of file
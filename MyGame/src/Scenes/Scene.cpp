@@ -3,6 +3,11 @@
 #include "../Core/Game.h"
 #include "../Core/Physics.h"
 #include "../Core/Time.h"
+#include "../Core/ParticleSystem.h"
+#include "../Core/EventBus.h"
+#include "../Core/EcsBridge.h"
+#include "../Core/GameParams.h"
+#include "../Core/ContactCache.h"
 #include <algorithm>
 #include <cmath>
 
@@ -12,61 +17,220 @@ void Scene::Update(Game* game) {
     std::vector<std::unique_ptr<GameObject>>& newObjs = game->GetPendingObjects();
     if (!newObjs.empty()) {
         for (auto& obj : newObjs) {
+            MarkObjectRegionDirty(obj.get(), { (int)obj->x, (int)obj->y, obj->width, obj->height });
+            if (obj->UsesEcsMovement()) EcsBridge::Link(registry, *obj);
             objects.push_back(std::move(obj));
+            OnObjectAdded(objects.back().get());
         }
         game->ClearPendingObjects();
+        spatialIndexDirty = true;
     }
 
     OnUpdate(game);
 
+    // 地形などが変わっていれば流れ場を更新（変更がなければ何もしない）
+    flowField.Update(objects);
+
+    // Update の中で位置を直接書き換える体（地上を歩く敵など）も動いたと判定できるよう、呼ぶ前の位置を控える
+    frameStartX.resize(objects.size());
+    frameStartY.resize(objects.size());
+    for (size_t i = 0; i < objects.size(); ++i) {
+        frameStartX[i] = objects[i]->x;
+        frameStartY[i] = objects[i]->y;
+    }
+
     for (auto& obj : objects) {
         if (obj->isDead) continue;
         obj->Update(game);
     }
 
+    // 演出用パーティクルの更新
+    ParticleSystem::GetInstance().Update(dt);
+
+    // ECS に移行済みの種類は MovementSystem がまとめて積分する
+    if (registry.GetAliveCount() > 0) {
+        EcsBridge::Push(registry, objects);
+        MovementSystem::Update(registry, dt);
+        EcsBridge::Pull(registry, objects);
+    }
+
+    // 物理・衝突判定が読む値を連続した配列に集める（ここから先の判定はオブジェクトを直接たどらない）
+    hotData.Gather(objects);
+
+    // 眠っている体を起こす（地形が変わった時は全部、速度や加速度を与えられたもの・Update で動いたものはそれぞれ）
+    for (size_t i = 0; i < hotData.Size(); ++i) {
+        if (!hotData.Has(i, ObjectHotData::SLEEPING)) continue;
+        if (wakeSleepers || hotData.velX[i] != 0.0f || hotData.velY[i] != 0.0f ||
+            hotData.accX[i] != 0.0f || hotData.accY[i] != 0.0f ||
+            hotData.x[i] != frameStartX[i] || hotData.y[i] != frameStartY[i]) {
+            objects[i]->Wake();
+            hotData.flags[i] &= ~ObjectHotData::SLEEPING;
+        }
+    }
+    wakeSleepers = false;
+
     // 物理演算の適用
-    for (auto& obj : objects) {
-        if (obj->isDead) continue;
-        if (obj->useGravity || std::abs(obj->velX) > 0 || std::abs(obj->velY) > 0) {
-            Physics::ApplyPhysics(obj.get(), dt);
+    Physics::IntegrateHot(hotData, dt);
+    hotData.ScatterMotion(objects);
+    for (size_t i = 0; i < hotData.Size(); ++i) {
+        // 静的オブジェクトや地形が動かされた場合は移動前後のキャッシュを無効化する
+        if (!hotData.Has(i, ObjectHotData::STATIC) && !hotData.Has(i, ObjectHotData::AFFECTS_NAV)) continue;
+        if ((int)hotData.prevX[i] != (int)hotData.x[i] || (int)hotData.prevY[i] != (int)hotData.y[i]) {
+            GameObject* obj = objects[i].get();
+            NotifyObjectChanged(obj, { (int)hotData.prevX[i], (int)hotData.prevY[i], obj->width, obj->height });
         }
     }
 
-    // 衝突判定と解決
-    for (size_t i = 0; i < objects.size(); ++i) {
-        auto& a = objects[i];
-        if (a->isDead) continue;
-
-        // 接地判定などの物理衝突（対象を絞る）
-        if (a->name == "Player" || a->name == "TestPlayer" || a->name == "Enemy" || a->name == "Test Enemy") {
-            a->isGrounded = false;
-            for (auto& b : objects) {
-                if (a == b || b->isTrigger) continue;
-                // 地面(Block/Editor Ground)との衝突を Physics::ResolveCollision で解決
-                if (Physics::ResolveCollision(a.get(), b.get())) {
-                    a->isGrounded = true;
-                }
+    // 衝突判定と解決（重なりの判定は配列で行い、重なった組だけオブジェクトに触れる）
+    // 接地判定などの物理衝突（プレイヤーと敵だけ）
+    auto collideBody = [&](size_t i, size_t j) {
+        if (i == j || hotData.Has(j, ObjectHotData::TRIGGER)) return;
+        if (!hotData.Overlaps(i, j)) return;
+
+        GameObject* a = objects[i].get();
+        GameObject* b = objects[j].get();
+        // 押し戻す組か（地面(Block/Editor Ground)との組など）は最初に重なった時にだけ判定する
+        bool created = false;
+        Contact& contact = contacts.Touch(a->id, b->id, created);
+        if (created) contact.solid = Physics::IsSolidPair(a, b);
+        if (!contact.solid) return;
+
+        if (Physics::ResolveContact(a, b, contact, hotData.prevY[i] + hotData.height[i])) {
+            a->isGrounded = true;
+        }
+        hotData.Refresh(i, *a);
+    };
+    // トリガー判定（重なりチェック：攻撃判定など）
+    auto collideTrigger = [&](size_t i, size_t j) {
+        if (hotData.Has(j, ObjectHotData::DEAD)) return;
+        // 眠っている体同士（止まっている敵の群れなど）は調べない（SweepAndPrune の候補にも含まれない）
+        if (hotData.Has(i, ObjectHotData::SLEEPING) && hotData.Has(j, ObjectHotData::SLEEPING)) return;
+        if (!hotData.Has(i, ObjectHotData::TRIGGER) && !hotData.Has(j, ObjectHotData::TRIGGER)) return;
+        if (!hotData.Overlaps(i, j)) return;
+
+        GameObject* a = objects[i].get();
+        GameObject* b = objects[j].get();
+        a->OnTriggerEnter(b);
+        b->OnTriggerEnter(a);
+        // コールバックで位置や状態が変わることがあるので取り直す
+        hotData.Refresh(i, *a);
+        hotData.Refresh(j, *b);
+    };
+
+    const size_t count = objects.size();
+    contacts.BeginFrame();
+    if (GameParams::GetInstance().physics.sweepAndPrune) {
+        // X 方向の区間が重なる組だけを、総当たりと同じ順で調べる
+        // （押し戻しやコールバックで動いた結果新しく重なった組は、次のフレームで扱われる）
+        broadphase.Update(objects, hotData);
+        for (size_t i = 0; i < count; ++i) {
+            if (hotData.Has(i, ObjectHotData::DEAD)) continue;
+            if (hotData.Has(i, ObjectHotData::BODY) && !hotData.Has(i, ObjectHotData::SLEEPING)) {
+                objects[i]->isGrounded = false;
+                for (std::uint32_t j : broadphase.Candidates(i)) collideBody(i, j);
+            }
+            for (std::uint32_t j : broadphase.Candidates(i)) {
+                if (j > i) collideTrigger(i, j);
             }
         }
-        // トリガー判定（重なりチェック：攻撃判定など）
-        for (size_t j = i + 1; j < objects.size(); ++j) {
-            auto& b = objects[j];
-            if (b->isDead) continue;
-
-            if (a->isTrigger || b->isTrigger) {
-                if (CheckOverlap(a.get(), b.get())) {
-                    a->OnTriggerEnter(b.get());
-                    b->OnTriggerEnter(a.get());
-                }
+    }
+    else {
+        // 総当たり（比較用）
+        broadphase.Reset();
+        for (size_t i = 0; i < count; ++i) {
+            if (hotData.Has(i, ObjectHotData::DEAD)) continue;
+            if (hotData.Has(i, ObjectHotData::BODY) && !hotData.Has(i, ObjectHotData::SLEEPING)) {
+                objects[i]->isGrounded = false;
+                for (size_t j = 0; j < count; ++j) collideBody(i, j);
             }
+            for (size_t j = i + 1; j < count; ++j) collideTrigger(i, j);
+        }
+    }
+    contacts.EndFrame();
+
+    // 接地したまま動かなかった体は SLEEP_TICKS フレーム続いたら眠らせる。移動量は Update の前から測るため、
+    // Update で位置を書き換えて歩く体は眠らない。眠っている体がトリガーのコールバックなどで動かされていたら起こす
+    for (size_t i = 0; i < count; ++i) {
+        const std::uint8_t flags = hotData.flags[i];
+        if ((flags & (ObjectHotData::BODY | ObjectHotData::GRAVITY)) != (ObjectHotData::BODY | ObjectHotData::GRAVITY)) continue;
+        if (flags & (ObjectHotData::DEAD | ObjectHotData::ECS)) continue;
+
+        GameObject* obj = objects[i].get();
+        bool still = obj->isGrounded && hotData.velX[i] == 0.0f && hotData.velY[i] == 0.0f &&
+            std::abs(hotData.x[i] - frameStartX[i]) < REST_EPSILON &&
+            std::abs(hotData.y[i] - frameStartY[i]) < REST_EPSILON;
+        if (!still) {
+            obj->Wake();
+        }
+        else if (!obj->isSleeping && ++obj->restTicks >= SLEEP_TICKS) {
+            obj->isSleeping = true;
         }
     }
-    auto it = std::remove_if(objects.begin(), objects.end(),
-        [](const std::unique_ptr<GameObject>& obj) { return obj->isDead; });
-    objects.erase(it, objects.end());
+
+    // このフレームに発行されたイベントをまとめて配信する（削除前なので購読側はまだオブジェクトを参照できる）
+    EventBus::GetInstance().Dispatch();
+
+    // 取り除く前に後始末と通知をまとめて行う（remove_if の判定には副作用を持たせない）
+    bool anyDead = false;
+    for (auto& obj : objects) {
+        if (!obj->isDead) continue;
+        anyDead = true;
+        MarkObjectRegionDirty(obj.get(), { (int)obj->x, (int)obj->y, obj->width, obj->height });
+        OnObjectRemoved(obj.get());
+        if (obj->entity != NullEntity) EcsBridge::Unlink(registry, *obj);
+    }
+    if (anyDead) {
+        objects.erase(std::remove_if(objects.begin(), objects.end(),
+            [](const std::unique_ptr<GameObject>& obj) { return obj->isDead; }), objects.end());
+        spatialIndexDirty = true;
+    }
 }
 
 bool Scene::CheckOverlap(GameObject* a, GameObject* b) {
     return (a->x < b->x + b->width && a->x + a->width > b->x &&
         a->y < b->y + b->height && a->y + a->height > b->y);
+}
+
+void Scene::NotifyObjectChanged(GameObject* obj, const SDL_Rect& before) {
+    if (!obj) return;
+    obj->Wake();
+    MarkObjectRegionDirty(obj, before);
+    MarkObjectRegionDirty(obj, { (int)obj->x, (int)obj->y, obj->width, obj->height });
+}
+
+void Scene::ApplyConfigChange(unsigned int changedSections, SDL_Renderer* renderer) {
+    // 重力やサイズが変わることがあるので、眠っている体はすべて起こす
+    wakeSleepers = true;
+    for (auto& obj : GetObjects()) {
+        if (!obj || obj->isDead) continue;
+        if (obj->GetConfigDependencies() & changedSections) {
+            obj->OnConfigChanged(changedSections, renderer);
+        }
+    }
+    OnConfigChanged(changedSections, renderer);
+}
+
+const SpatialHash& Scene::GetSpatialIndex() {
+    if (spatialIndexDirty) {
+        spatialIndex.Build(GetObjects());
+        spatialIndexDirty = false;
+    }
+    else {
+        spatialIndex.Refresh();
+    }
+    return spatialIndex;
+}
+
+GameObject* Scene::FindObjectById(unsigned int id) {
+    for (auto& obj : GetObjects()) {
+        if (obj && !obj->isDead && obj->id == id) return obj.get();
+    }
+    return nullptr;
+}
+
+void Scene::MarkObjectRegionDirty(GameObject* obj, const SDL_Rect& rect) {
+    if (obj->isStatic) staticLayer.MarkDirty(rect);
+    if (obj->affectsNavigation) flowField.MarkDirty(rect);
+    // 足場が置かれた・動いた・消えた可能性があるので、次のフレームで眠っている体を起こす
+    if (obj->isStatic || obj->affectsNavigation) wakeSleepers = true;
 }
\ No newline at end of file
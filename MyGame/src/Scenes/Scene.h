@@ -2,6 +2,13 @@
 #include <vector>
 #include <memory>
 #include <SDL.h>
+#include "../Core/StaticLayerCache.h"
+#include "../Core/SpatialHash.h"
+#include "../Core/ECS.h"
+#include "../Core/ObjectHotData.h"
+#include "../Core/SweepAndPrune.h"
+#include "../Core/ContactCache.h"
+#include "../GameLogic/FlowField.h"
 
 class Game;
 class GameObject;
@@ -17,14 +24,101 @@ public:
 
     void Update(Game* game);
 
+    // 1描画フレーム分シーンを進める（既定では Update を1回。早送りするシーンは複数回呼ぶ）
+    virtual void Advance(Game* game) { Update(game); }
+
     virtual bool ShowImGui() const { return false; }
     virtual std::vector<std::unique_ptr<GameObject>>& GetObjects() = 0;
 
+    // 静的レイヤー（地面など）のキャッシュ
+    StaticLayerCache& GetStaticLayer() { return staticLayer; }
+
+    // 拠点へ向かう流れ場（PathFollow の敵が参照する）
+    FlowField& GetFlowField() { return flowField; }
+
+    /**
+     * @brief オブジェクトの位置・サイズが外部から変更されたことを通知する（エディタでの移動など）
+     * 変更前の範囲と現在の範囲について、静的レイヤーと流れ場を再計算対象にします。
+     */
+    void NotifyObjectChanged(GameObject* obj, const SDL_Rect& before);
+
+    /**
+     * @brief 設定の変更を、そのセクションに依存しているオブジェクトだけに通知する
+     * @param changedSections 変更されたセクション（ConfigSection のビット）
+     */
+    void ApplyConfigChange(unsigned int changedSections, SDL_Renderer* renderer);
+
+    // id からオブジェクトを探す（見つからない・削除済みなら nullptr）
+    GameObject* FindObjectById(unsigned int id);
+
+    // オブジェクトの一覧が OnObjectAdded / OnObjectRemoved を通さずに変わるたびに変わる番号
+    // （エディタの表示キャッシュを作り直すかの判定用。Update 内の追加・削除では変わらない）
+    // 番号は全シーンで重複しないため、シーンが入れ替わった場合も別物として判定できます
+    unsigned int GetStructureVersion() const { return structureVersion; }
+
+    /**
+     * @brief エディタでの選択などに使う空間インデックスを取得する
+     * 一覧の追加・削除の後に初めて参照された時は作り直し、それ以外は動いたオブジェクトのセルだけを移し替えます
+     * （毎フレームは何もしないので、参照されないシーンでは費用がかかりません）。
+     * 返されるインデックスは GetObjects() の配列の位置で、次の Update まで有効です。
+     */
+    const SpatialHash& GetSpatialIndex();
+
 protected:
     // 各シーン固有のロジック
     virtual void OnUpdate(Game* game) = 0;
 
+    StaticLayerCache staticLayer;
+    FlowField flowField;
+
+    // ECS に移行済みの種類のエンティティ（オブジェクトの一覧をまとめて消す時は Clear() も呼ぶ）
+    Registry registry;
+
+    // オブジェクトの一覧を直接変更した時に呼ぶ（Update 内の追加・削除はフックで通知されるので不要）
+    void MarkStructureChanged() {
+        structureVersion = NextStructureVersion();
+        spatialIndexDirty = true;
+    }
+
+    // Update で保留中のオブジェクトが配列に加わった直後に呼ばれる
+    virtual void OnObjectAdded(GameObject*) {}
+    // 削除されたオブジェクトが配列から取り除かれる直前に呼ばれる（選択の解除など）
+    virtual void OnObjectRemoved(GameObject*) {}
+    // ApplyConfigChange でオブジェクトへの通知を終えた後に呼ばれる（一覧の外にある敵のプールなど）
+    virtual void OnConfigChanged(unsigned int, SDL_Renderer*) {}
+
 private:
+    static unsigned int NextStructureVersion() {
+        static unsigned int counter = 0;
+        return ++counter;
+    }
+    unsigned int structureVersion = NextStructureVersion();
+
+    SpatialHash spatialIndex;
+    bool spatialIndexDirty = true;  // 一覧の並びが変わった（配列のインデックスがずれた）
+
+    // 物理・衝突判定用にオブジェクトの値を集めた配列（毎フレーム集め直す）
+    ObjectHotData hotData;
+
+    // 各オブジェクトの Update を呼ぶ前の位置（静止の判定に使う。配列は使い回す）
+    std::vector<float> frameStartX, frameStartY;
+
+    // 当たり判定の候補の絞り込み（並び順をフレームをまたいで使い回す）
+    SweepAndPrune broadphase;
+
+    // プレイヤー・敵と地面などの接触（押し戻しの向きを次のフレームへ引き継ぐ）
+    ContactCache contacts;
+
+    // この数のフレームのあいだ接地したまま動かなかった体を眠らせる
+    static constexpr int SLEEP_TICKS = 30;
+    // 静止とみなす1フレームの移動量（押し戻しの計算誤差を吸収する）
+    static constexpr float REST_EPSILON = 0.01f;
+    // 次の Update の始めに眠っている体をすべて起こす（地形の変更や設定の再読み込み）
+    bool wakeSleepers = false;
+
     // AABBによる重なり判定
     bool CheckOverlap(GameObject* a, GameObject* b);
+
+    // オブジェクトの範囲を静的レイヤー・流れ場の再計算対象にする
+    void MarkObjectRegionDirty(GameObject* obj, const SDL_Rect& rect);
 };
\ No newline at end of file
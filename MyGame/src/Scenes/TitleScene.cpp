@@ -2,10 +2,10 @@
 #include "../Core/Game.h"
 #include "PlayScene.h"
 #include "EditorScene.h" 
-#include "../UI/TextRenderer.h"
+#include "../Core/DrawList.h"
 #include "../UI/Button.h" 
 #include "../Editor/EditorGUI.h"
-#include <iostream>
+#include "../Core/Logger.h"
 
 TitleScene::TitleScene() {
 }
@@ -15,7 +15,7 @@ TitleScene::~TitleScene() {
 }
 
 void TitleScene::OnEnter(Game* game) {
-    std::cout << "Entering TitleScene..." << std::endl;
+    LOG_INFO(LogCategory::Scene, "Entering TitleScene...");
 
     // --- ボタンの生成と配置 ---
     startButton = std::make_unique<Button>(300, 300, 200, 50, "GAME START");
@@ -41,7 +41,7 @@ void TitleScene::OnEnter(Game* game) {
 }
 
 void TitleScene::OnExit(Game* game) {
-    std::cout << "Exiting TitleScene..." << std::endl;
+    LOG_INFO(LogCategory::Scene, "Exiting TitleScene...");
     gameObjects.clear();
 }
 
@@ -62,18 +62,18 @@ void TitleScene::OnUpdate(Game* game) {
 }
 
 void TitleScene::Render(Game* game) {
-    SDL_Renderer* renderer = game->GetRenderer();
+    DrawList& drawList = game->GetDrawList();
 
     // 背景の塗りつぶし（暗い紺色）
-    SDL_SetRenderDrawColor(renderer, 20, 20, 40, 255);
-    SDL_RenderClear(renderer);
+    drawList.SetDrawColor(20, 20, 40, 255);
+    drawList.Clear();
 
     // タイトルロゴの描画
     SDL_Color white = { 255, 255, 255, 255 };
-    TextRenderer::Draw(renderer, "MELTED DEFENSE", 280, 150, white);
+    drawList.Text("MELTED DEFENSE", 280, 150, white);
 
     // ボタンの描画
-    if (startButton) startButton->Render(renderer);
-    if (exitButton) exitButton->Render(renderer);
-    if (debugButton) debugButton->Render(renderer);
+    if (startButton) startButton->Render(drawList);
+    if (exitButton) exitButton->Render(drawList);
+    if (debugButton) debugButton->Render(drawList);
 }
\ No newline at end of file
@@ -1,26 +1,28 @@
 ﻿#include "TextureManager.h"
-#include <iostream>
+#include "Core/Logger.h"
 
-std::map<std::string, SharedTexturePtr> TextureManager::textureCache;
+std::unordered_map<StringId, SharedTexturePtr> TextureManager::textureCache;
+std::vector<SharedTexturePtr> TextureManager::retiredTextures;
 
-SharedTexturePtr TextureManager::LoadTexture(const std::string& fileName, SDL_Renderer* renderer) {
+SharedTexturePtr TextureManager::LoadTexture(StringId fileName, SDL_Renderer* renderer) {
     auto it = textureCache.find(fileName);
 
     if (it != textureCache.end()) {
-        std::cout << "[Cache Hit] Use existing texture: " << fileName << std::endl;
+        LOG_DEBUG(LogCategory::Asset, "[Cache Hit] Use existing texture: " << fileName);
         return it->second;
     }
 
     //キャッシュになかったので、新しくロードする
-    std::cout << "[Load New] Loading texture from disk: " << fileName << std::endl;
+    LOG_INFO(LogCategory::Asset, "[Load New] Loading texture from disk: " << fileName);
 
     SDL_Surface* tempSurface = IMG_Load(fileName.c_str());
     if (!tempSurface) {
-        std::cout << "Failed to load image: " << fileName << std::endl;
+        LOG_ERROR(LogCategory::Asset, "Failed to load image: " << fileName);
         return nullptr; 
     }
 
-    SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, tempSurface);
+    SDL_Texture* tex = nullptr;
+    RenderThread::Invoke([&]() { tex = SDL_CreateTextureFromSurface(renderer, tempSurface); });
     SDL_FreeSurface(tempSurface);
 
     if (tex) {
@@ -33,8 +35,50 @@ SharedTexturePtr TextureManager::LoadTexture(const std::string& fileName, SDL_Re
     return nullptr;
 }
 
+TextureReloadResult TextureManager::ReloadTexture(const std::string& fileName, SDL_Surface* surface, SDL_Renderer* renderer) {
+    // 変更された任意のファイルが届くため、表に登録せずに引く（未登録なら読み込まれていない）
+    auto it = textureCache.find(StringId::Find(fileName));
+    if (it == textureCache.end() || !it->second) {
+        if (surface) SDL_FreeSurface(surface);
+        return TextureReloadResult::NotCached;
+    }
+    if (!surface) return TextureReloadResult::Failed;
+
+    SDL_Texture* current = it->second.get();
+    Uint32 format;
+    int access, w, h;
+    if (SDL_QueryTexture(current, &format, &access, &w, &h) == 0 && w == surface->w && h == surface->h) {
+        // テクスチャと同じピクセル形式に変換してから書き込む
+        SDL_Surface* converted = SDL_ConvertSurfaceFormat(surface, format, 0);
+        if (converted) {
+            int result = -1;
+            RenderThread::Invoke([&]() { result = SDL_UpdateTexture(current, NULL, converted->pixels, converted->pitch); });
+            SDL_FreeSurface(converted);
+            if (result == 0) {
+                SDL_FreeSurface(surface);
+                LOG_INFO(LogCategory::Asset, "[Hot Reload] Updated texture in place: " << fileName);
+                return TextureReloadResult::UpdatedInPlace;
+            }
+        }
+    }
+
+    SDL_Texture* tex = nullptr;
+    RenderThread::Invoke([&]() { tex = SDL_CreateTextureFromSurface(renderer, surface); });
+    SDL_FreeSurface(surface);
+    if (!tex) {
+        LOG_ERROR(LogCategory::Asset, "Failed to recreate texture: " << fileName);
+        return TextureReloadResult::Failed;
+    }
+
+    retiredTextures.push_back(it->second);
+    it->second = SharedTexturePtr(tex, TextureDestroyer());
+    LOG_INFO(LogCategory::Asset, "[Hot Reload] Recreated texture (size changed): " << fileName);
+    return TextureReloadResult::Recreated;
+}
+
 void TextureManager::Clean() {
-    std::cout << "Clearing texture cache..." << std::endl;
+    LOG_INFO(LogCategory::Asset, "Clearing texture cache...");
     // キャッシュを空にする
     textureCache.clear();
+    retiredTextures.clear();
 }
\ No newline at end of file
@@ -3,25 +3,50 @@
 #include <SDL_image.h>
 #include <memory>
 #include <string>
-#include <map>
+#include <unordered_map>
+#include <vector>
+#include "Core/RenderThread.h"
+#include "Core/StringId.h"
 
-// テクスチャ削除用の関数オブジェクト（これはそのまま）
+// テクスチャ削除用の関数オブジェクト（描画中のフレームが参照している可能性があるため、破棄は描画スレッドに任せる）
 struct TextureDestroyer {
     void operator()(SDL_Texture* t) const {
-        if (t) SDL_DestroyTexture(t);
+        if (t) RenderThread::DestroyTexture(t);
     }
 };
 
 
 using SharedTexturePtr = std::shared_ptr<SDL_Texture>;
 
+// ReloadTexture の結果
+enum class TextureReloadResult {
+    NotCached,       // 読み込まれていない画像なので何もしなかった
+    UpdatedInPlace,  // 同じサイズなので既存のテクスチャに画素を書き込んだ
+    Recreated,       // サイズが変わったので作り直した（参照側の再取得が必要）
+    Failed
+};
+
 class TextureManager {
 public:
-    static SharedTexturePtr LoadTexture(const std::string& fileName, SDL_Renderer* renderer);
+    // 画像のデコードは呼び出したスレッドで行い、テクスチャの作成だけを描画スレッドに頼む
+    // キャッシュはパスの StringId で引く（文字列を渡した場合はその場で登録する）
+    static SharedTexturePtr LoadTexture(StringId fileName, SDL_Renderer* renderer);
+
+    /**
+     * @brief 読み込み済みのテクスチャを、別スレッドでデコードした画像で差し替える（メインスレッドで呼ぶ）
+     * サイズが同じ場合は SDL_UpdateTexture で中身だけを書き換えるため、各オブジェクトが持つポインタはそのまま使えます。
+     * 書き換えはフレームの間に描画スレッドで行います。
+     * サイズが変わった場合は作り直し、古いテクスチャは Clean まで保持します（生ポインタの参照切れを防ぐため）。
+     * surface の所有権はこの関数が引き取ります。
+     */
+    static TextureReloadResult ReloadTexture(const std::string& fileName, SDL_Surface* surface, SDL_Renderer* renderer);
 
     // ゲーム終了時にキャッシュを空にする関数
     static void Clean();
 
 private:
-    static std::map<std::string, SharedTexturePtr> textureCache;
+    static std::unordered_map<StringId, SharedTexturePtr> textureCache;
+
+    // 作り直しで置き換えられたテクスチャ（参照が残っている可能性があるため終了時まで保持）
+    static std::vector<SharedTexturePtr> retiredTextures;
 };
\ No newline at end of file
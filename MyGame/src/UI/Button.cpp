@@ -1,5 +1,6 @@
 ﻿#include "Button.h"
 #include "TextRenderer.h"
+#include "../Core/DrawList.h"
 #include "imgui.h"
 
 // コンストラクタ
@@ -35,19 +36,19 @@ bool Button::HandleEvents(SDL_Event* event) {
 }
 
 // 描画処理
-void Button::Render(SDL_Renderer* renderer) {
+void Button::Render(DrawList& drawList) {
     if (isHovered) {
-        SDL_SetRenderDrawColor(renderer, 100, 100, 255, 255);
+        drawList.SetDrawColor(100, 100, 255, 255);
     }
     else {
-        SDL_SetRenderDrawColor(renderer, 50, 50, 150, 255);
+        drawList.SetDrawColor(50, 50, 150, 255);
     }
 
-    SDL_RenderFillRect(renderer, &rect);
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
-    SDL_RenderDrawRect(renderer, &rect);
+    drawList.FillRect(rect);
+    drawList.SetDrawColor(255, 255, 255, 255);
+    drawList.DrawRect(rect);
 
     SDL_Color white = { 255, 255, 255, 255 };
 
-    TextRenderer::Draw(renderer, text.c_str(), rect.x + 20, rect.y + 15, white);
+    drawList.Text(text.c_str(), rect.x + 20, rect.y + 15, white);
 }
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include <string>
 #include <functional>
 
+class DrawList;
+
 class Button {
 public:
     // コンストラクタ
@@ -12,7 +14,7 @@ public:
     bool HandleEvents(SDL_Event* event);
 
     // 描画
-    void Render(SDL_Renderer* renderer);
+    void Render(DrawList& drawList);
 
     std::function<void()> OnClick;
 
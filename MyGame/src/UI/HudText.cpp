@@ -0,0 +1,47 @@
+﻿#include "HudText.h"
+#include "TextRenderer.h"
+#include "../Core/DrawList.h"
+#include "../Core/RenderThread.h"
+
+HudText::HudText(int x, int y)
+    : x(x), y(y), cache(new TextTexture())
+{
+}
+
+HudText::~HudText() {
+    // 描画中のフレームがまだ cache を参照しているかもしれないので、終わってから破棄する
+    TextTexture* released = cache;
+    RenderThread::Defer([released]() {
+        TextRenderer::Release(*released);
+        delete released;
+    });
+}
+
+bool HudText::Bind(int a, int b, int c, int d) {
+    if (bound && boundValues[0] == a && boundValues[1] == b && boundValues[2] == c && boundValues[3] == d) {
+        return false;
+    }
+    bound = true;
+    boundValues[0] = a;
+    boundValues[1] = b;
+    boundValues[2] = c;
+    boundValues[3] = d;
+    return true;
+}
+
+void HudText::SetText(const std::string& newText, SDL_Color newColor) {
+    if (newText == text && newColor.r == color.r && newColor.g == color.g && newColor.b == color.b && newColor.a == color.a) {
+        return;
+    }
+    text = newText;
+    color = newColor;
+    dirty = true;
+}
+
+void HudText::Render(DrawList& drawList) {
+    if (dirty) {
+        drawList.UpdateText(*cache, text, color);
+        dirty = false;
+    }
+    drawList.DrawCachedText(*cache, x, y);
+}
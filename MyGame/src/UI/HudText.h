@@ -0,0 +1,47 @@
+﻿#pragma once
+#include <SDL.h>
+#include <string>
+
+class DrawList;
+struct TextTexture;
+
+/**
+ * @brief 値が変わった時だけ描き直す HUD の文字列
+ * ラスタライズしたテクスチャを持ち続け、毎フレームはそれを貼るだけにします。
+ * 表示する値を Bind に渡し、true が返った時（前回から変わった時）だけ文字列を作って SetText してください。
+ * ラスタライズとテクスチャの破棄は描画スレッドで行われるため、メインスレッドは待ちません。
+ */
+class HudText {
+public:
+    HudText(int x, int y);
+    ~HudText();
+    HudText(const HudText&) = delete;
+    HudText& operator=(const HudText&) = delete;
+
+    // 表示に使う値を渡す。初回か、前回と違う値なら true
+    bool Bind(int a, int b = 0, int c = 0, int d = 0);
+
+    // 文字列か色が変わった時だけ描き直しの印を付ける
+    void SetText(const std::string& newText, SDL_Color newColor);
+
+    void SetPosition(int newX, int newY) { x = newX; y = newY; }
+
+    // テクスチャを作り直させる（レンダラーのデバイスがリセットされた時など）
+    void Invalidate() { dirty = true; }
+
+    // 変わっていればラスタライズを積み、キャッシュを貼る命令を積む
+    void Render(DrawList& drawList);
+
+private:
+    std::string text;
+    SDL_Color color = { 255, 255, 255, 255 };
+    int x;
+    int y;
+    bool dirty = false;
+
+    bool bound = false;
+    int boundValues[4] = { 0, 0, 0, 0 };
+
+    // 描画スレッドが読み書きするので、破棄も描画スレッドに任せる
+    TextTexture* cache;
+};
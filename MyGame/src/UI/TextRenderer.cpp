@@ -1,11 +1,12 @@
 ﻿#include "TextRenderer.h"
+#include "../Core/Logger.h"
 
 TTF_Font* TextRenderer::font = nullptr;
 
 bool TextRenderer::Init(const char* fontPath, int fontSize) {
     // 文字システムの初期化
     if (TTF_Init() == -1) {
-        std::cout << "TTF_Init Error: " << TTF_GetError() << std::endl;
+        LOG_ERROR(LogCategory::Asset, "TTF_Init Error: " << TTF_GetError());
         return false;
     }
 
@@ -13,7 +14,7 @@ bool TextRenderer::Init(const char* fontPath, int fontSize) {
     font = TTF_OpenFont(fontPath, fontSize);
 
     if (!font) {
-        std::cout << "Failed to load font: " << fontPath << std::endl;
+        LOG_ERROR(LogCategory::Asset, "Failed to load font: " << fontPath);
         return false;
     }
 
@@ -46,4 +47,26 @@ void TextRenderer::Draw(SDL_Renderer* renderer, std::string text, int x, int y,
     // メモリ解放
     SDL_DestroyTexture(texture);
     SDL_FreeSurface(surface);
+}
+
+void TextRenderer::Rasterize(SDL_Renderer* renderer, const std::string& text, SDL_Color color, TextTexture& target) {
+    Release(target);
+    if (!font || !renderer || text.empty()) return;
+
+    SDL_Surface* surface = TTF_RenderText_Solid(font, text.c_str(), color);
+    if (!surface) return;
+
+    target.texture = SDL_CreateTextureFromSurface(renderer, surface);
+    if (target.texture) {
+        target.width = surface->w;
+        target.height = surface->h;
+    }
+    SDL_FreeSurface(surface);
+}
+
+void TextRenderer::Release(TextTexture& target) {
+    if (target.texture) {
+        SDL_DestroyTexture(target.texture);
+    }
+    target = TextTexture();
 }
\ No newline at end of file
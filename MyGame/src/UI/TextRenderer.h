@@ -4,6 +4,13 @@
 #include <string>
 #include <iostream>
 
+// ラスタライズ済みの文字列（描画スレッドだけが読み書きする。HudText が持つ）
+struct TextTexture {
+    SDL_Texture* texture = nullptr;
+    int width = 0;
+    int height = 0;
+};
+
 class TextRenderer {
 public:
     // フォントの読み込みを行う初期化関数
@@ -13,10 +20,16 @@ public:
     // 終了処理（フォントを閉じる）
     static void Clean();
 
-    // 文字を描画する関数
+    // 文字を描画する関数（描画スレッドで DrawList::Text の命令から呼ばれる）
     // 引数: レンダラー, 表示する文字, X座標, Y座標, 文字色
     static void Draw(SDL_Renderer* renderer, std::string text, int x, int y, SDL_Color color);
 
+    // 文字列をテクスチャにして target に持たせる（前のテクスチャは破棄する）。描画スレッドで呼ぶ
+    static void Rasterize(SDL_Renderer* renderer, const std::string& text, SDL_Color color, TextTexture& target);
+
+    // target のテクスチャを破棄する。描画スレッドで呼ぶ
+    static void Release(TextTexture& target);
+
 private:
     static TTF_Font* font;
 };
\ No newline at end of file
@@ -0,0 +1,22 @@
+﻿// Game の代わり（Game.cpp はウィンドウ・エディタ・全シーンに依存するためリンクしない）
+// テストでは Init を呼ばずに生成し、保留中のオブジェクトの受け渡しにだけ使う。参照されるものは空を返す
+#include "Core/Game.h"
+#include "Core/InputHandler.h"
+#include "Core/ConfigHotReloader.h"
+#include "Scenes/Scene.h"
+#include "Objects/GameObject.h"
+
+Game::Game() : isRunning(false) {}
+
+Game::~Game() {}
+
+SDL_Renderer* Game::GetRenderer() const { return nullptr; }
+
+std::vector<std::unique_ptr<GameObject>>& Game::GetCurrentSceneObjects() {
+    static std::vector<std::unique_ptr<GameObject>> empty;
+    return empty;
+}
+
+SDL_Texture* Game::GetBulletTexture() { return nullptr; }
+
+FlowField* Game::GetFlowField() { return nullptr; }
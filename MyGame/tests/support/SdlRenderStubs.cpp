@@ -0,0 +1,42 @@
+﻿// テスト用の SDL の描画関数の代わり（何もせず成功を返す。テクスチャは作れなかったことにする）
+#include <SDL.h>
+#include "imgui.h"
+
+// imgui の SDL_Renderer バックエンドの代わり（DrawList が ImGui の描画を中継する先）
+void ImGui_ImplSDLRenderer2_RenderDrawData(ImDrawData*, SDL_Renderer*) {}
+void ImGui_ImplSDLRenderer2_UpdateTexture(ImTextureData*) {}
+
+extern "C" {
+
+SDL_Texture* SDL_CreateTexture(SDL_Renderer*, Uint32, int, int, int) { return nullptr; }
+void SDL_DestroyTexture(SDL_Texture*) {}
+int SDL_GetRenderDrawBlendMode(SDL_Renderer*, SDL_BlendMode*) { return 0; }
+SDL_Texture* SDL_GetRenderTarget(SDL_Renderer*) { return nullptr; }
+int SDL_GetRendererOutputSize(SDL_Renderer*, int*, int*) { return 0; }
+int SDL_RenderClear(SDL_Renderer*) { return 0; }
+int SDL_RenderCopy(SDL_Renderer*, SDL_Texture*, const SDL_Rect*, const SDL_Rect*) { return 0; }
+int SDL_RenderCopyEx(SDL_Renderer*, SDL_Texture*, const SDL_Rect*, const SDL_Rect*, const double, const SDL_Point*, const SDL_RendererFlip) { return 0; }
+int SDL_RenderFillRect(SDL_Renderer*, const SDL_Rect*) { return 0; }
+int SDL_RenderDrawRect(SDL_Renderer*, const SDL_Rect*) { return 0; }
+int SDL_RenderDrawLine(SDL_Renderer*, int, int, int, int) { return 0; }
+int SDL_RenderGeometry(SDL_Renderer*, SDL_Texture*, const SDL_Vertex*, int, const int*, int) { return 0; }
+void SDL_RenderPresent(SDL_Renderer*) {}
+SDL_bool SDL_RenderTargetSupported(SDL_Renderer*) { return SDL_FALSE; }
+int SDL_SetRenderDrawBlendMode(SDL_Renderer*, SDL_BlendMode) { return 0; }
+int SDL_SetRenderDrawColor(SDL_Renderer*, Uint8, Uint8, Uint8, Uint8) { return 0; }
+int SDL_SetRenderTarget(SDL_Renderer*, SDL_Texture*) { return 0; }
+int SDL_RenderDrawLinesF(SDL_Renderer*, const SDL_FPoint*, int) { return 0; }
+int SDL_UpdateTexture(SDL_Texture*, const SDL_Rect*, const void*, int) { return 0; }
+SDL_Texture* SDL_CreateTextureFromSurface(SDL_Renderer*, SDL_Surface*) { return nullptr; }
+SDL_Renderer* SDL_CreateRenderer(SDL_Window*, int, Uint32) { return nullptr; }
+void SDL_DestroyRenderer(SDL_Renderer*) {}
+int SDL_SetTextureBlendMode(SDL_Texture*, SDL_BlendMode) { return 0; }
+int SDL_SetTextureColorMod(SDL_Texture*, Uint8, Uint8, Uint8) { return 0; }
+int SDL_SetTextureAlphaMod(SDL_Texture*, Uint8) { return 0; }
+int SDL_QueryTexture(SDL_Texture*, Uint32*, int*, int* w, int* h) {
+    if (w) *w = 0;
+    if (h) *h = 0;
+    return 0;
+}
+
+}
@@ -0,0 +1,61 @@
+﻿// テスト用の SDL / SDL_image / SDL_ttf の代わり（時刻・CPU 情報・入力・画像・フォント。描画は SdlRenderStubs.cpp）
+#include <SDL.h>
+#include <SDL_image.h>
+#include <SDL_ttf.h>
+#include <chrono>
+#include <cstring>
+
+extern "C" {
+
+Uint32 SDL_GetTicks(void) {
+    static const auto start = std::chrono::steady_clock::now();
+    return (Uint32)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+Uint64 SDL_GetPerformanceCounter(void) {
+    return (Uint64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+Uint64 SDL_GetPerformanceFrequency(void) { return 1000000000ull; }
+
+// 実行中の CPU の対応状況をそのまま返す（IntegrateHot の分岐を実機どおりに選ばせる）
+SDL_bool SDL_HasSSE2(void) { return __builtin_cpu_supports("sse2") ? SDL_TRUE : SDL_FALSE; }
+SDL_bool SDL_HasAVX2(void) { return __builtin_cpu_supports("avx2") ? SDL_TRUE : SDL_FALSE; }
+
+SDL_bool SDL_HasIntersection(const SDL_Rect* a, const SDL_Rect* b) {
+    return (a->x < b->x + b->w && b->x < a->x + a->w && a->y < b->y + b->h && b->y < a->y + a->h) ? SDL_TRUE : SDL_FALSE;
+}
+
+const char* SDL_GetError(void) { return "stub"; }
+
+void SDL_DestroyWindow(SDL_Window*) {}
+
+SDL_Keymod SDL_GetModState(void) { return KMOD_NONE; }
+
+Uint32 SDL_GetMouseState(int* x, int* y) {
+    if (x) *x = 0;
+    if (y) *y = 0;
+    return 0;
+}
+
+// 画像は読み込めなかったことにする（呼び出し側は nullptr を扱える）
+SDL_Surface* IMG_Load(const char*) { return nullptr; }
+SDL_Surface* SDL_ConvertSurfaceFormat(SDL_Surface*, Uint32, Uint32) { return nullptr; }
+void SDL_FreeSurface(SDL_Surface* surface) { delete surface; }
+
+// フォントは中身のない仮のもので、文字列は1文字 8x16 の大きさのサーフェス（画素なし）になる
+int TTF_Init(void) { return 0; }
+void TTF_Quit(void) {}
+TTF_Font* TTF_OpenFont(const char*, int) {
+    static int fakeFont;
+    return reinterpret_cast<TTF_Font*>(&fakeFont);
+}
+void TTF_CloseFont(TTF_Font*) {}
+SDL_Surface* TTF_RenderText_Solid(TTF_Font*, const char* text, SDL_Color) {
+    SDL_Surface* surface = new SDL_Surface();
+    surface->w = 8 * (int)std::strlen(text);
+    surface->h = 16;
+    return surface;
+}
+
+}
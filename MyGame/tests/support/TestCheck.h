@@ -0,0 +1,26 @@
+﻿#pragma once
+#include <cstdio>
+
+// 失敗した条件の数（main は TestResult() を返す）
+inline int& TestFailureCount() {
+    static int count = 0;
+    return count;
+}
+
+// 条件が偽なら場所と式を表示して失敗を数える（続きのチェックも実行する）
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::printf("%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+            ++TestFailureCount(); \
+        } \
+    } while (0)
+
+inline int TestResult(const char* name) {
+    if (TestFailureCount() == 0) {
+        std::printf("[%s] ok\n", name);
+        return 0;
+    }
+    std::printf("[%s] %d failure(s)\n", name, TestFailureCount());
+    return 1;
+}
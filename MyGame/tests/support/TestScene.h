@@ -0,0 +1,40 @@
+﻿#pragma once
+#include "Scenes/Scene.h"
+#include "Objects/GameObject.h"
+#include <vector>
+#include <memory>
+
+// 何もしないオブジェクト（Scene の物理・衝突判定だけを働かせる）
+class TestObject : public GameObject {
+public:
+    using GameObject::GameObject;
+    void Update(Game*) override {}
+    void OnRender(DrawList&, int, int) override {}
+};
+
+// オブジェクトの一覧と追加・削除の通知だけを持つシーン
+class TestScene : public Scene {
+public:
+    std::vector<std::unique_ptr<GameObject>> objects;
+    std::vector<GameObject*> added;
+    std::vector<GameObject*> removed;
+
+    void OnEnter(Game*) override {}
+    void OnExit(Game*) override {}
+    void HandleEvents(Game*, SDL_Event*) override {}
+    void Render(Game*) override {}
+    std::vector<std::unique_ptr<GameObject>>& GetObjects() override { return objects; }
+
+    template <typename T, typename... Args>
+    T* Add(Args&&... args) {
+        auto obj = std::make_unique<T>(std::forward<Args>(args)...);
+        T* raw = obj.get();
+        objects.push_back(std::move(obj));
+        return raw;
+    }
+
+protected:
+    void OnUpdate(Game*) override {}
+    void OnObjectAdded(GameObject* obj) override { added.push_back(obj); }
+    void OnObjectRemoved(GameObject* obj) override { removed.push_back(obj); }
+};
@@ -0,0 +1,97 @@
+﻿// Animator のコマ送り・切り替えと、AnimationClipSet の読み込み・共有を確かめる
+#include "TestCheck.h"
+#include "Core/Animator.h"
+#include "Core/Time.h"
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+namespace {
+
+    std::shared_ptr<const AnimationClipSet> MakeClips() {
+        return AnimationClipSet::Create({
+            { StringId("Idle"), 0, 4, 0.2f, true },
+            { StringId("Run"), 1, 6, 0.1f, true },
+            { StringId("Jump"), 2, 3, 0.1f, false },
+        });
+    }
+
+    // speed 秒ごとに1コマ進み、ループするものは先頭へ、しないものは最後のコマで止まる
+    void TestPlayback() {
+        Time::deltaTime = 0.1f;
+        Animator animator;
+        animator.SetClips(MakeClips());
+        const AnimationHandle idle = animator.Find(StringId("Idle"));
+        const AnimationHandle run = animator.Find(StringId("Run"));
+        const AnimationHandle jump = animator.Find(StringId("Jump"));
+        CHECK(idle == 0 && run == 1 && jump == 2);
+        CHECK(animator.Find(StringId("Swim")) == InvalidAnimation);
+
+        // 最初のクリップ（Idle）から再生される
+        SDL_Rect src = animator.GetSrcRect(32, 48);
+        CHECK(src.x == 0 && src.y == 0 && src.w == 32 && src.h == 48);
+        animator.Update();
+        animator.Update();
+        CHECK(animator.GetSrcRect(32, 48).x == 32);
+
+        // 同じクリップの Play ではコマは戻らない。別のクリップなら先頭から
+        animator.Play(idle);
+        CHECK(animator.GetSrcRect(32, 48).x == 32);
+        animator.Play(run);
+        src = animator.GetSrcRect(32, 48);
+        CHECK(src.x == 0 && src.y == 48);
+        for (int i = 0; i < 6; ++i) animator.Update();
+        CHECK(animator.GetSrcRect(32, 48).x == 0);
+
+        animator.Play(jump);
+        for (int i = 0; i < 10; ++i) animator.Update();
+        src = animator.GetSrcRect(32, 48);
+        CHECK(src.x == 2 * 32 && src.y == 2 * 48);
+
+        // 無効な番号は無視される
+        animator.Play(InvalidAnimation);
+        animator.Play(42);
+        CHECK(animator.GetSrcRect(32, 48).y == 2 * 48);
+        Time::deltaTime = 1.0f / 60.0f;
+    }
+
+    // 同じファイルは使われている間は1つのセットを共有し、同じ名前は後の定義で上書きする
+    void TestLoadShared() {
+        const char* path = "test_animator_clips.json";
+        {
+            std::ofstream file(path);
+            file << R"({ "animations": [
+                { "name": "Idle", "row": 0, "frameCount": 4, "speed": 0.2 },
+                { "name": "Run", "row": 1, "frameCount": 6, "speed": 0.1 },
+                { "name": "Idle", "row": 3, "frameCount": 2, "speed": 0.5, "loop": false }
+            ] })";
+        }
+
+        std::vector<Animator> animators(100);
+        {
+            auto clipSet = AnimationClipSet::Load(path);
+            CHECK(clipSet->GetClipCount() == 2);
+            const AnimationClip* idle = clipSet->Get(clipSet->Find(StringId("Idle")));
+            CHECK(clipSet->Find(StringId("Idle")) == 0);
+            CHECK(idle && idle->row == 3 && idle->frameCount == 2 && !idle->loop);
+            for (Animator& animator : animators) animator.SetClips(AnimationClipSet::Load(path));
+            CHECK(clipSet.use_count() == 101);
+            CHECK(animators[0].GetClips() == clipSet.get());
+        }
+        const AnimationClipSet* shared = animators[0].GetClips();
+        CHECK(AnimationClipSet::Load(path).get() == shared);
+        std::remove(path);
+
+        CHECK(AnimationClipSet::Load("test_animator_missing.json")->GetClipCount() == 0);
+        Animator empty;
+        empty.SetClips(AnimationClipSet::Load("test_animator_missing.json"));
+        empty.Update();
+        CHECK(empty.Find(StringId("Idle")) == InvalidAnimation);
+    }
+}
+
+int main() {
+    TestPlayback();
+    TestLoadShared();
+    return TestResult("test_animator");
+}
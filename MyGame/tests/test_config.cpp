@@ -0,0 +1,148 @@
+﻿// ConfigManager のバイナリ版が JSON の編集を見落とさないこと、読み込みに失敗しても GameParams が変わらないこと、
+// 外部での編集を反映する時に変わったセクション以外の値（エディタで編集中の値）を上書きしないこと、
+// 保存に失敗した時にバックアップが減らないことを確かめる
+#include "TestCheck.h"
+#include "Core/ConfigManager.h"
+#include "Core/ConfigHotReloader.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+    void WriteText(const std::string& path, const std::string& text) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << text;
+    }
+
+    std::string ReadText(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    // 保存直後に JSON を書き換え、更新日時をバイナリと同じに戻しても JSON の値が読まれる
+    void TestEditedJsonWithSameTimestamp() {
+        GameParams& params = GameParams::GetInstance();
+        params.physics.gravity = 2.5f;
+        CHECK(ConfigManager::Save(params));
+        CHECK(fs::exists("assets/data/config.mdc"));
+
+        const std::string jsonPath = ConfigManager::GetConfigPath();
+        std::string text = ReadText(jsonPath);
+        size_t at = text.find("\"gravity\": 2.5");
+        CHECK(at != std::string::npos);
+        if (at == std::string::npos) return;
+        text.replace(at, 14, "\"gravity\": 4.5");
+        auto binaryTime = fs::last_write_time("assets/data/config.mdc");
+        WriteText(jsonPath, text);
+        fs::last_write_time(jsonPath, binaryTime);
+
+        params.physics.gravity = 0.0f;
+        CHECK(ConfigManager::Load(params));
+        CHECK(params.physics.gravity == 4.5f);
+
+        // 読み込み時に作り直したバイナリは、そのまま次の起動で使われる
+        params.physics.gravity = 0.0f;
+        CHECK(ConfigManager::Load(params));
+        CHECK(params.physics.gravity == 4.5f);
+    }
+
+    // 設定ファイルを書き換え、監視スレッドが読み込んだ変更を反映できるまで待つ（最大 5 秒）
+    template <typename Applied>
+    bool RewriteAndApply(ConfigHotReloader& reloader, const json& j, Applied applied) {
+        WriteText(ConfigManager::GetConfigPath(), j.dump(4));
+        for (int i = 0; i < 500; ++i) {
+            reloader.ApplyPending(nullptr, nullptr);
+            if (applied()) return true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return false;
+    }
+
+    // Levels だけの変更では、エディタで編集中の銃の値はプリセットの値に戻らない。
+    // トップレベルの Gun の変更はそのまま反映され、選択中のプリセットの変更はプリセットから反映される
+    void TestPartialReloadKeepsEditedValues() {
+        GameParams& params = GameParams::GetInstance();
+        params.gunPresets[params.activeGunPresetName].damage = 10;
+        params.gun.damage = 10;
+        params.levelConfigs.erase(2);
+        CHECK(ConfigManager::Save(params));
+        json saved = params;
+
+        ConfigHotReloader reloader;
+        CHECK(reloader.Start());
+        params.gun.damage = 77;
+
+        json edited = saved;
+        std::map<int, LevelParams> levels = params.levelConfigs;
+        levels[2] = LevelParams();
+        edited["Levels"] = levels;
+        CHECK(RewriteAndApply(reloader, edited, [&params]() { return params.levelConfigs.count(2) > 0; }));
+        CHECK(params.gun.damage == 77);
+
+        edited["Gun"]["fireRate"] = 0.05f;
+        CHECK(RewriteAndApply(reloader, edited, [&params]() { return params.gun.fireRate == 0.05f; }));
+        CHECK(params.gun.damage == 10);
+
+        edited["GunPresets"][params.activeGunPresetName]["damage"] = 33;
+        CHECK(RewriteAndApply(reloader, edited, [&params]() { return params.gun.damage == 33; }));
+        reloader.Stop();
+    }
+
+    // 一時ファイルを開けずに保存に失敗した時は、バックアップをずらさない
+    void TestFailedSaveKeepsBackups() {
+        GameParams& params = GameParams::GetInstance();
+        const std::string jsonPath = ConfigManager::GetConfigPath();
+        for (int i = 0; i < 4; ++i) {
+            params.physics.gravity = (float)i;
+            CHECK(ConfigManager::Save(params));
+        }
+        const std::string current = ReadText(jsonPath);
+        const std::string bak1 = ReadText(jsonPath + ".bak1");
+        const std::string bak3 = ReadText(jsonPath + ".bak3");
+        CHECK(!bak3.empty() && bak1 != current);
+
+        fs::create_directory(jsonPath + ".tmp");
+        params.physics.gravity = 100.0f;
+        CHECK(!ConfigManager::Save(params));
+        fs::remove(jsonPath + ".tmp");
+
+        CHECK(ReadText(jsonPath) == current);
+        CHECK(ReadText(jsonPath + ".bak1") == bak1);
+        CHECK(ReadText(jsonPath + ".bak3") == bak3);
+    }
+
+    // 後ろの項目の型が違う JSON は、前の項目も含めて一切反映しない
+    void TestFailedLoadLeavesParamsUntouched() {
+        GameParams& params = GameParams::GetInstance();
+        params.physics.gravity = 9.8f;
+        params.base.maxHealth = 1000;
+        WriteText(ConfigManager::GetConfigPath(), R"({ "Physics": { "gravity": 1.0 }, "Base": { "maxHealth": 5 }, "Levels": "broken" })");
+        fs::remove("assets/data/config.mdc");
+
+        CHECK(!ConfigManager::Load(params));
+        CHECK(params.physics.gravity == 9.8f);
+        CHECK(params.base.maxHealth == 1000);
+    }
+}
+
+int main() {
+    // 本物の assets を書き換えないよう、一時ディレクトリで実行する
+    fs::path dir = fs::temp_directory_path() / "mygame_test_config";
+    fs::remove_all(dir);
+    fs::create_directories(dir / "assets" / "data");
+    fs::current_path(dir);
+
+    TestEditedJsonWithSameTimestamp();
+    TestPartialReloadKeepsEditedValues();
+    TestFailedSaveKeepsBackups();
+    TestFailedLoadLeavesParamsUntouched();
+
+    ConfigManager::Shutdown();
+    fs::current_path(dir.parent_path());
+    fs::remove_all(dir);
+    return TestResult("test_config");
+}
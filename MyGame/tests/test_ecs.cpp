@@ -0,0 +1,93 @@
+﻿// Registry の追加・削除・世代による無効化と、MovementSystem が ApplyPhysics と同じ結果になることを確かめる
+#include "TestCheck.h"
+#include "TestScene.h"
+#include "Core/ECS.h"
+#include "Core/Components.h"
+#include "Core/EcsBridge.h"
+#include "Core/Physics.h"
+#include <cmath>
+
+namespace {
+
+    void TestRegistry() {
+        Registry registry;
+        Entity a = registry.Create();
+        Entity b = registry.Create();
+        Entity c = registry.Create();
+        registry.Set(a, Transform{ 1.0f, 2.0f, 0.0 });
+        registry.Set(b, Transform{ 3.0f, 4.0f, 0.0 });
+        registry.Set(c, Transform{ 5.0f, 6.0f, 0.0 });
+        registry.Set(b, Velocity{ 1.0f, 1.0f });
+        registry.Set(c, Velocity{ 2.0f, 2.0f });
+
+        int moving = 0;
+        registry.Each<Velocity, Transform>([&](Entity, Velocity&, Transform&) { ++moving; });
+        CHECK(moving == 2);
+
+        // 削除すると構成要素も消え、詰めた後も残りの値は変わらない
+        registry.Destroy(b);
+        CHECK(!registry.IsAlive(b));
+        CHECK(!registry.Has<Transform>(b));
+        CHECK(registry.TryGet<Transform>(c) && registry.TryGet<Transform>(c)->x == 5.0f);
+
+        // 同じ位置が再利用されても世代が違うので、古い番号は無効のまま
+        Entity d = registry.Create();
+        CHECK(EntityBits::Index(d) == EntityBits::Index(b));
+        CHECK(d != b);
+        CHECK(!registry.IsAlive(b));
+        CHECK(registry.IsAlive(d));
+
+        registry.Clear();
+        CHECK(!registry.IsAlive(c));
+        CHECK(registry.GetAliveCount() == 0);
+    }
+
+    // 同じ初期値の2組を、片方は ApplyPhysics、片方は ECS で 120 フレーム動かして比べる
+    void TestMovementMatchesApplyPhysics() {
+        const float DT = 1.0f / 60.0f;
+        std::vector<std::unique_ptr<GameObject>> objects;
+        std::vector<std::unique_ptr<GameObject>> reference;
+        for (int i = 0; i < 50; ++i) {
+            for (auto* list : { &objects, &reference }) {
+                auto obj = std::make_unique<TestObject>((float)i, (float)i * 2.0f, 10, 10);
+                obj->velX = (float)(i % 3) - 1.0f;
+                obj->velY = (i % 4) * 0.5f;
+                obj->useGravity = (i % 2) != 0;
+                obj->accX = i * 0.1f;
+                list->push_back(std::move(obj));
+            }
+        }
+
+        Registry registry;
+        for (auto& obj : objects) EcsBridge::Link(registry, *obj);
+
+        for (int frame = 0; frame < 120; ++frame) {
+            for (auto& obj : reference) {
+                if (obj->useGravity || std::abs(obj->velX) > 0.0f || std::abs(obj->velY) > 0.0f) {
+                    Physics::ApplyPhysics(obj.get(), DT);
+                }
+            }
+            EcsBridge::Push(registry, objects);
+            MovementSystem::Update(registry, DT);
+            EcsBridge::Pull(registry, objects);
+        }
+
+        int mismatches = 0;
+        for (size_t i = 0; i < objects.size(); ++i) {
+            if (objects[i]->x != reference[i]->x || objects[i]->y != reference[i]->y ||
+                objects[i]->velX != reference[i]->velX || objects[i]->velY != reference[i]->velY) {
+                ++mismatches;
+            }
+        }
+        CHECK(mismatches == 0);
+
+        for (auto& obj : objects) EcsBridge::Unlink(registry, *obj);
+        CHECK(registry.GetAliveCount() == 0);
+    }
+}
+
+int main() {
+    TestRegistry();
+    TestMovementMatchesApplyPhysics();
+    return TestResult("test_ecs");
+}
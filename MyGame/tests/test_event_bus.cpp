@@ -0,0 +1,92 @@
+﻿// EventBus の配信の順序と、配信中の購読・解除・発行、別スレッドからの発行を確かめる
+#include "TestCheck.h"
+#include "Core/EventBus.h"
+#include <thread>
+
+namespace {
+
+    struct EventA { int value = 0; };
+    struct EventB { int value = 0; };
+    struct EventC { int value = 0; };
+
+    // 配信中の購読は次の Dispatch から、配信中の発行は次の Dispatch で届く。解除した購読者には以後届かない
+    void TestChangesDuringDispatch() {
+        EventBus& bus = EventBus::GetInstance();
+        bus.Publish(EventA{ 1 });  // 購読者がいないので積まれない
+
+        int sumA = 0;
+        int sumB = 0;
+        int late = 0;
+        EventBus::SubscriptionId lateId = 0;
+        EventBus::SubscriptionId idB = 0;
+        EventBus::SubscriptionId idA = bus.Subscribe<EventA>([&](const EventA& event) {
+            sumA += event.value;
+            if (!lateId) lateId = bus.Subscribe<EventA>([&](const EventA& lateEvent) { late += lateEvent.value; });
+            bus.Publish(EventA{ 100 });
+        });
+        idB = bus.Subscribe<EventB>([&](const EventB& event) {
+            sumB += event.value;
+            bus.Unsubscribe(idB);
+        });
+
+        bus.Publish(EventA{ 2 });
+        bus.Publish(EventA{ 3 });
+        bus.Publish(EventB{ 5 });
+        bus.Publish(EventB{ 7 });
+        bus.Dispatch();
+        CHECK(sumA == 5);
+        CHECK(sumB == 5);
+        CHECK(late == 0);
+
+        // 配信中に発行された2件が、途中で加わった購読者にも届く
+        bus.Dispatch();
+        CHECK(sumA == 205);
+        CHECK(late == 200);
+
+        bus.Unsubscribe(idA);
+        bus.Unsubscribe(lateId);
+        bus.Dispatch();
+        bus.Publish(EventA{ 9 });
+        bus.Dispatch();
+        CHECK(sumA == 205);
+        CHECK(late == 200);
+    }
+
+    // 別スレッドから積んだイベントは次の Dispatch で届き、満杯になった分は false で捨てられる
+    void TestPublishAsync() {
+        EventBus& bus = EventBus::GetInstance();
+        int sum = 0;
+        EventBus::SubscriptionId id = bus.Subscribe<EventC>([&](const EventC& event) { sum += event.value; });
+
+        std::thread publisher([&bus]() {
+            for (int i = 0; i < 100; ++i) bus.PublishAsync(EventC{ 1 });
+        });
+        publisher.join();
+        bus.Dispatch();
+        CHECK(sum == 100);
+
+        int accepted = 0;
+        std::thread flooder([&bus, &accepted]() {
+            for (size_t i = 0; i < EventBus::ASYNC_QUEUE_CAPACITY + 10; ++i) {
+                if (bus.PublishAsync(EventC{ 1 })) ++accepted;
+            }
+        });
+        flooder.join();
+        CHECK(accepted == (int)EventBus::ASYNC_QUEUE_CAPACITY);
+        bus.Dispatch();
+        CHECK(sum == 100 + (int)EventBus::ASYNC_QUEUE_CAPACITY);
+
+        // シーン切り替えで捨てたイベントは届かない
+        bus.Publish(EventC{ 1000 });
+        bus.ClearPending();
+        bus.Dispatch();
+        CHECK(sum == 100 + (int)EventBus::ASYNC_QUEUE_CAPACITY);
+        bus.Unsubscribe(id);
+    }
+}
+
+int main() {
+    TestChangesDuringDispatch();
+    TestPublishAsync();
+    return TestResult("test_event_bus");
+}
@@ -0,0 +1,174 @@
+﻿// ObjectHotData を読む物理・衝突判定が、GameObject を直接読む従来の処理と同じ結果になることを確かめる
+// （位置・速度・接地・削除の状態と、トリガーのコールバックの呼ばれる順序を比べる）
+#include "TestCheck.h"
+#include "Core/ObjectHotData.h"
+#include "Core/Physics.h"
+#include "Objects/GameObject.h"
+#include <cmath>
+#include <random>
+#include <string>
+
+namespace {
+
+    std::string callbackLog;
+
+    const StringId BULLET_NAME{ "Bullet" };
+
+    // 弾は当たると消え、敵はブロックに乗ると止まる（コールバックで値が書き換わる場合も比べる）
+    class HotTestObject : public GameObject {
+    public:
+        using GameObject::GameObject;
+        int tag = 0;
+
+        void Update(Game*) override {}
+        void OnRender(DrawList&, int, int) override {}
+
+        void OnTriggerEnter(GameObject* other) override {
+            if (isDead || other->isDead) return;
+            callbackLog += std::to_string(tag) + ">" + std::to_string(static_cast<HotTestObject*>(other)->tag) + ";";
+            if (name == BULLET_NAME) isDead = true;
+            if (name == ObjectNames::Enemy && other->name == ObjectNames::Block) {
+                velY = 0.0f;
+                isGrounded = true;
+            }
+        }
+    };
+
+    using ObjectList = std::vector<std::unique_ptr<GameObject>>;
+
+    void MakeObjects(ObjectList& objects, unsigned int seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> position(0.0f, 400.0f);
+        const StringId NAMES[] = { ObjectNames::Enemy, ObjectNames::Block, BULLET_NAME, ObjectNames::Player, StringId("Object") };
+        for (int i = 0; i < 120; ++i) {
+            auto obj = std::make_unique<HotTestObject>(position(rng), position(rng) * 0.5f, 10 + i % 30, 10 + i % 20);
+            obj->name = NAMES[i % 5];
+            obj->tag = i;
+            obj->isTrigger = (obj->name == BULLET_NAME || obj->name == ObjectNames::Enemy);
+            obj->useGravity = (obj->name == ObjectNames::Enemy || obj->name == ObjectNames::Player);
+            obj->velX = (float)(i % 3) - 1.0f;
+            objects.push_back(std::move(obj));
+        }
+    }
+
+    // GameObject を直接読む従来の1フレーム
+    void StepReference(ObjectList& objects, float dt) {
+        for (auto& obj : objects) {
+            if (obj->isDead) continue;
+            if (obj->useGravity || std::abs(obj->velX) > 0.0f || std::abs(obj->velY) > 0.0f) {
+                Physics::ApplyPhysics(obj.get(), dt);
+            }
+        }
+        for (size_t i = 0; i < objects.size(); ++i) {
+            GameObject* a = objects[i].get();
+            if (a->isDead) continue;
+            if (a->name == ObjectNames::Player || a->name == ObjectNames::TestPlayer ||
+                a->name == ObjectNames::Enemy || a->name == ObjectNames::TestEnemy) {
+                a->isGrounded = false;
+                for (auto& b : objects) {
+                    if (a == b.get() || b->isTrigger) continue;
+                    if (Physics::ResolveCollision(a, b.get())) a->isGrounded = true;
+                }
+            }
+            for (size_t j = i + 1; j < objects.size(); ++j) {
+                GameObject* b = objects[j].get();
+                if (b->isDead) continue;
+                if ((a->isTrigger || b->isTrigger) && Physics::CheckAABB(a, b)) {
+                    a->OnTriggerEnter(b);
+                    b->OnTriggerEnter(a);
+                }
+            }
+        }
+    }
+
+    // 集めた配列を読む1フレーム（Scene::Update と同じ流れ）
+    void StepHot(ObjectList& objects, ObjectHotData& hotData, float dt) {
+        hotData.Gather(objects);
+        Physics::IntegrateHot(hotData, dt);
+        hotData.ScatterMotion(objects);
+
+        const size_t count = objects.size();
+        for (size_t i = 0; i < count; ++i) {
+            if (hotData.Has(i, ObjectHotData::DEAD)) continue;
+            GameObject* a = objects[i].get();
+            if (hotData.Has(i, ObjectHotData::BODY)) {
+                a->isGrounded = false;
+                for (size_t j = 0; j < count; ++j) {
+                    if (i == j || hotData.Has(j, ObjectHotData::TRIGGER)) continue;
+                    if (!hotData.Overlaps(i, j)) continue;
+                    if (Physics::ResolveCollision(a, objects[j].get())) a->isGrounded = true;
+                    hotData.Refresh(i, *a);
+                }
+            }
+            for (size_t j = i + 1; j < count; ++j) {
+                if (hotData.Has(j, ObjectHotData::DEAD)) continue;
+                if (!hotData.Has(i, ObjectHotData::TRIGGER) && !hotData.Has(j, ObjectHotData::TRIGGER)) continue;
+                if (!hotData.Overlaps(i, j)) continue;
+                GameObject* b = objects[j].get();
+                a->OnTriggerEnter(b);
+                b->OnTriggerEnter(a);
+                hotData.Refresh(i, *a);
+                hotData.Refresh(j, *b);
+            }
+        }
+    }
+
+    void TestMatchesReference() {
+        const float DT = 1.0f / 60.0f;
+        for (unsigned int seed = 1; seed < 20; ++seed) {
+            ObjectList reference;
+            ObjectList objects;
+            MakeObjects(reference, seed);
+            MakeObjects(objects, seed);
+            ObjectHotData hotData;
+
+            std::string referenceLog;
+            std::string hotLog;
+            for (int frame = 0; frame < 60; ++frame) {
+                callbackLog.clear();
+                StepReference(reference, DT);
+                referenceLog += callbackLog;
+                callbackLog.clear();
+                StepHot(objects, hotData, DT);
+                hotLog += callbackLog;
+            }
+
+            int mismatches = 0;
+            for (size_t i = 0; i < objects.size(); ++i) {
+                const GameObject& a = *reference[i];
+                const GameObject& b = *objects[i];
+                if (a.x != b.x || a.y != b.y || a.velY != b.velY || a.isDead != b.isDead || a.isGrounded != b.isGrounded) {
+                    ++mismatches;
+                }
+            }
+            CHECK(mismatches == 0);
+            CHECK(!referenceLog.empty());
+            CHECK(referenceLog == hotLog);
+        }
+    }
+
+    // 集めた値は積分前の位置を保ち、Refresh は積分前の位置を変えない
+    void TestGatherAndRefresh() {
+        ObjectList objects;
+        MakeObjects(objects, 99);
+        objects[0]->isDead = true;
+        ObjectHotData hotData;
+        hotData.Gather(objects);
+        CHECK(hotData.Size() == objects.size());
+        CHECK(hotData.Has(0, ObjectHotData::DEAD));
+        CHECK(hotData.Has(3, ObjectHotData::BODY));  // Player
+        CHECK(!hotData.Has(1, ObjectHotData::BODY)); // Block
+
+        const float beforeX = objects[3]->x;
+        objects[3]->x += 50.0f;
+        hotData.Refresh(3, *objects[3]);
+        CHECK(hotData.x[3] == beforeX + 50.0f);
+        CHECK(hotData.prevX[3] == beforeX);
+    }
+}
+
+int main() {
+    TestMatchesReference();
+    TestGatherAndRefresh();
+    return TestResult("test_hot_data");
+}
@@ -0,0 +1,155 @@
+﻿// HudText が値の変わったフレームだけラスタライズし、ラスタライズと破棄が描画スレッドで行われることを確かめる
+// （SDL の描画関数はこのファイルで記録用に差し替える。フォントは SdlStubs の 1文字 8x16 の仮のもの）
+#include "TestCheck.h"
+#include "Core/RenderThread.h"
+#include "Core/DrawList.h"
+#include "UI/TextRenderer.h"
+#include "UI/HudText.h"
+#include "imgui.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+
+namespace {
+
+    std::thread::id renderThreadId;
+    std::atomic<int> offThreadCalls{ 0 };
+    std::atomic<int> rasterized{ 0 };
+    std::atomic<int> released{ 0 };
+    std::atomic<int> copies{ 0 };
+    std::atomic<int> violations{ 0 };
+    std::mutex textureMutex;
+    std::set<SDL_Texture*> liveTextures;
+    int fakeRenderer;
+
+    void CheckThread() {
+        if (std::this_thread::get_id() != renderThreadId) ++offThreadCalls;
+    }
+}
+
+void ImGui_ImplSDLRenderer2_RenderDrawData(ImDrawData*, SDL_Renderer*) {}
+void ImGui_ImplSDLRenderer2_UpdateTexture(ImTextureData*) {}
+
+extern "C" {
+
+SDL_Renderer* SDL_CreateRenderer(SDL_Window*, int, Uint32) {
+    renderThreadId = std::this_thread::get_id();
+    return reinterpret_cast<SDL_Renderer*>(&fakeRenderer);
+}
+void SDL_DestroyRenderer(SDL_Renderer*) { CheckThread(); }
+SDL_bool SDL_RenderTargetSupported(SDL_Renderer*) { return SDL_TRUE; }
+int SDL_GetRendererOutputSize(SDL_Renderer*, int* w, int* h) {
+    if (w) *w = 800;
+    if (h) *h = 600;
+    return 0;
+}
+void SDL_RenderPresent(SDL_Renderer*) {
+    CheckThread();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+SDL_Texture* SDL_CreateTexture(SDL_Renderer*, Uint32, int, int, int) { return nullptr; }
+SDL_Texture* SDL_CreateTextureFromSurface(SDL_Renderer*, SDL_Surface*) {
+    CheckThread();
+    ++rasterized;
+    auto* texture = reinterpret_cast<SDL_Texture*>(new int(0));
+    std::lock_guard<std::mutex> lock(textureMutex);
+    liveTextures.insert(texture);
+    return texture;
+}
+void SDL_DestroyTexture(SDL_Texture* texture) {
+    CheckThread();
+    std::lock_guard<std::mutex> lock(textureMutex);
+    if (!liveTextures.erase(texture)) ++violations;
+    ++released;
+    delete reinterpret_cast<int*>(texture);
+}
+int SDL_QueryTexture(SDL_Texture*, Uint32*, int*, int* w, int* h) {
+    if (w) *w = 0;
+    if (h) *h = 0;
+    return 0;
+}
+int SDL_RenderCopy(SDL_Renderer*, SDL_Texture* texture, const SDL_Rect*, const SDL_Rect* dest) {
+    CheckThread();
+    ++copies;
+    std::lock_guard<std::mutex> lock(textureMutex);
+    if (!liveTextures.count(texture) || !dest || dest->h != 16) ++violations;
+    return 0;
+}
+int SDL_RenderCopyEx(SDL_Renderer*, SDL_Texture*, const SDL_Rect*, const SDL_Rect*, const double,
+    const SDL_Point*, const SDL_RendererFlip) { return 0; }
+int SDL_GetRenderDrawBlendMode(SDL_Renderer*, SDL_BlendMode*) { return 0; }
+SDL_Texture* SDL_GetRenderTarget(SDL_Renderer*) { return nullptr; }
+int SDL_SetRenderTarget(SDL_Renderer*, SDL_Texture*) { return 0; }
+int SDL_SetRenderDrawBlendMode(SDL_Renderer*, SDL_BlendMode) { return 0; }
+int SDL_SetRenderDrawColor(SDL_Renderer*, Uint8, Uint8, Uint8, Uint8) { return 0; }
+int SDL_RenderClear(SDL_Renderer*) { return 0; }
+int SDL_RenderFillRect(SDL_Renderer*, const SDL_Rect*) { return 0; }
+int SDL_RenderDrawRect(SDL_Renderer*, const SDL_Rect*) { return 0; }
+int SDL_RenderDrawLine(SDL_Renderer*, int, int, int, int) { return 0; }
+int SDL_RenderDrawLinesF(SDL_Renderer*, const SDL_FPoint*, int) { return 0; }
+int SDL_RenderGeometry(SDL_Renderer*, SDL_Texture*, const SDL_Vertex*, int, const int*, int) { return 0; }
+int SDL_UpdateTexture(SDL_Texture*, const SDL_Rect*, const void*, int) { return 0; }
+int SDL_SetTextureBlendMode(SDL_Texture*, SDL_BlendMode) { return 0; }
+int SDL_SetTextureColorMod(SDL_Texture*, Uint8, Uint8, Uint8) { return 0; }
+int SDL_SetTextureAlphaMod(SDL_Texture*, Uint8) { return 0; }
+
+}
+
+namespace {
+
+    // 600 フレームのうち、ウェーブ番号は 3 通り、残弾は 20 フレームごとに変わって 30 通り
+    void TestRasterizesOnlyOnChange() {
+        const int FRAMES = 600;
+        const int EXPECTED = 3 + 30;
+        TextRenderer::Init("fake.ttf", 16);
+        CHECK(RenderThread::Start(reinterpret_cast<SDL_Window*>(&fakeRenderer), 0));
+
+        DrawList lists[2];
+        int current = 0;
+        auto waveLabel = std::make_unique<HudText>(20, 20);
+        auto ammoLabel = std::make_unique<HudText>(200, 52);
+        for (int frame = 0; frame < FRAMES; ++frame) {
+            DrawList& list = lists[current];
+            list.Begin(800, 600);
+            int wave = 1 + frame / 200;
+            int rounds = 30 - (frame / 20) % 30;
+            if (waveLabel->Bind(wave)) {
+                waveLabel->SetText("SURVIVAL DAY: " + std::to_string(wave), { 255, 255, 0, 255 });
+            }
+            waveLabel->Render(list);
+            if (ammoLabel->Bind(rounds, 30)) {
+                ammoLabel->SetText("AMMO: " + std::to_string(rounds) + " / 30", { 255, 255, 255, 255 });
+            }
+            ammoLabel->Render(list);
+            RenderThread::Submit(&list);
+            current ^= 1;
+
+            // 最後のフレームがまだ描かれている間に破棄する（テクスチャの破棄は描画後に回される）
+            if (frame == FRAMES - 1) {
+                waveLabel.reset();
+                ammoLabel.reset();
+            }
+        }
+        RenderThread::Stop();
+        TextRenderer::Clean();
+
+        std::printf("%d frames: rasterized %d (expected %d), released %d, copies %d\n",
+            FRAMES, rasterized.load(), EXPECTED, released.load(), copies.load());
+        CHECK(rasterized == EXPECTED);
+        CHECK(released == EXPECTED);
+        CHECK(copies == FRAMES * 2);
+        CHECK(liveTextures.empty());
+        CHECK(offThreadCalls == 0);
+        CHECK(violations == 0);
+    }
+}
+
+int main() {
+    TestRasterizesOnlyOnChange();
+    return TestResult("test_hud_text");
+}
@@ -0,0 +1,86 @@
+﻿// Logger の停止と同時に書き込まれたメッセージが失われないことを確かめる
+// （書き出したメッセージの数 = 書き込んだ数 - バッファ満杯で捨てた数）
+#include "TestCheck.h"
+#include "Core/Logger.h"
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+namespace {
+
+    const int ROUNDS = 200;
+    const int WRITERS = 3;
+    const int MESSAGES_PER_WRITER = 300;
+
+    // 標準出力を一時ファイルへ向け、書き出された Info のメッセージ（1件1行）を数える
+    class StdoutCapture {
+    public:
+        explicit StdoutCapture(const char* path) : path(path) {
+            std::fflush(stdout);
+            savedFd = dup(fileno(stdout));
+            if (!std::freopen(path, "w", stdout)) savedFd = -1;
+        }
+
+        long Finish() {
+            std::cout.flush();
+            std::fflush(stdout);
+            if (savedFd >= 0) {
+                dup2(savedFd, fileno(stdout));
+                close(savedFd);
+            }
+            std::ifstream file(path);
+            long lines = 0;
+            for (std::istreambuf_iterator<char> it(file), end; it != end; ++it) {
+                if (*it == '\n') ++lines;
+            }
+            std::remove(path);
+            return lines;
+        }
+
+    private:
+        const char* path;
+        int savedFd = -1;
+    };
+
+    void TestShutdownKeepsConcurrentWrites() {
+        long written = 0;
+        uint64_t droppedBefore = Logger::GetDroppedCount();
+
+        StdoutCapture capture("test_logger_stdout.txt");
+        for (int round = 0; round < ROUNDS; ++round) {
+            Logger::Start();
+            std::atomic<long> count{ 0 };
+            std::vector<std::thread> writers;
+            for (int t = 0; t < WRITERS; ++t) {
+                writers.emplace_back([&count]() {
+                    for (int i = 0; i < MESSAGES_PER_WRITER; ++i) {
+                        Logger::Write(LogLevel::Info, LogCategory::Wave, "message " + std::to_string(i));
+                        count.fetch_add(1, std::memory_order_relaxed);
+                    }
+                });
+            }
+            // 書き込みの最中に止める（止める時点をラウンドごとにずらす）
+            std::this_thread::sleep_for(std::chrono::microseconds(50 * (round % 10)));
+            Logger::Shutdown();
+            for (auto& writer : writers) writer.join();
+            written += count.load();
+        }
+        long printed = capture.Finish();
+
+        long dropped = (long)(Logger::GetDroppedCount() - droppedBefore);
+        std::printf("%ld written, %ld printed, %ld dropped\n", written, printed, dropped);
+        CHECK(written == (long)ROUNDS * WRITERS * MESSAGES_PER_WRITER);
+        CHECK(printed + dropped == written);
+    }
+}
+
+int main() {
+    TestShutdownKeepsConcurrentWrites();
+    return TestResult("test_logger");
+}
@@ -0,0 +1,112 @@
+﻿// 被弾・拠点攻撃の火花が1回の攻撃につき1回だけ出ること、5万粒子の更新と描画記録の時間を確かめる
+#include "TestCheck.h"
+#include "Core/ParticleSystem.h"
+#include "Core/EventBus.h"
+#include "Core/GameSession.h"
+#include "Core/DrawList.h"
+#include "Core/Camera.h"
+#include "Objects/Enemy.h"
+#include "Objects/Bullet.h"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+
+    // 1回の攻撃で出る粒子の数を数える
+    int ParticlesEmittedBy(void (*attack)()) {
+        ParticleSystem& particles = ParticleSystem::GetInstance();
+        particles.Clear();
+        attack();
+        EventBus::GetInstance().Dispatch();
+        return particles.GetActiveCount();
+    }
+
+    void TestEnemyHitEmitsOnce() {
+        // 被弾の火花は EnemyDamagedEvent の購読側が上向きに4粒出す（弾の着弾イベントは出さない）
+        int emitted = ParticlesEmittedBy([]() {
+            std::vector<SDL_FPoint> path;
+            Enemy enemy(500.0f, 300.0f, 64, 64, nullptr, path);
+            Bullet bullet(520.0f, 320.0f, 0.0, nullptr, BulletSide::Player);
+            bullet.OnTriggerEnter(&enemy);
+            CHECK(bullet.isDead);
+            CHECK(!enemy.isDead);
+        });
+        CHECK(emitted == 4);
+    }
+
+    void TestBaseDamageEmitsAtImpactPoint() {
+        int burst = ParticleSystem::GetInstance().GetDesc(ParticleEffect::BaseImpact).burstCount;
+        int emitted = ParticlesEmittedBy([]() {
+            GameSession::GetInstance().ResetSession();
+            GameSession::GetInstance().DamageBase(1, 150.0f, 320.0f);
+        });
+        CHECK(emitted == burst);
+    }
+
+    void TestFiftyThousandParticles() {
+        const int TARGET_PARTICLES = 50000;
+        const int VIEW_W = 1200;
+        const int VIEW_H = 800;
+        const int FRAMES = 120;
+        const double FRAME_BUDGET_MS = 1000.0 / 60.0;
+
+        // Benchmark::RunParticles と同じ条件（消えず、画面外へ出ない粒子を5万個）
+        ParticleSystem& particles = ParticleSystem::GetInstance();
+        const ParticleEffect EFFECTS[] = { ParticleEffect::Hit, ParticleEffect::Death, ParticleEffect::MuzzleFlash, ParticleEffect::BaseImpact };
+        ParticleEmitterDesc savedDescs[(int)ParticleEffect::Count];
+        for (ParticleEffect effect : EFFECTS) {
+            ParticleEmitterDesc& desc = particles.GetDesc(effect);
+            savedDescs[(int)effect] = desc;
+            desc.lifeMin = desc.lifeMax = 1.0e6f;
+            desc.gravity = 0.0f;
+            desc.speedMin = 0.0f;
+            desc.speedMax = 20.0f;
+        }
+        particles.Clear();
+        for (int i = 0; particles.GetActiveCount() < TARGET_PARTICLES && i < TARGET_PARTICLES; ++i) {
+            float x = 50.0f + (float)((i * 37) % (VIEW_W - 100));
+            float y = 50.0f + (float)((i * 53) % (VIEW_H - 100));
+            particles.Emit(EFFECTS[i % 4], x, y, 0.0f, 16);
+        }
+        CHECK(particles.GetActiveCount() >= TARGET_PARTICLES);
+
+        Camera camera(VIEW_W, VIEW_H);
+        camera.x = 0.0f;
+        camera.y = 0.0f;
+        DrawList drawList;
+        using Clock = std::chrono::steady_clock;
+        double updateMs = 0.0, recordMs = 0.0, worstMs = 0.0;
+        for (int frame = 0; frame < FRAMES; ++frame) {
+            auto start = Clock::now();
+            particles.Update(1.0f / 60.0f);
+            auto updated = Clock::now();
+            drawList.Begin(VIEW_W, VIEW_H);
+            particles.Render(drawList, &camera);
+            auto recorded = Clock::now();
+
+            double update = std::chrono::duration<double, std::milli>(updated - start).count();
+            double record = std::chrono::duration<double, std::milli>(recorded - updated).count();
+            updateMs += update;
+            recordMs += record;
+            worstMs = std::max(worstMs, update + record);
+        }
+        std::printf("%d particles: update %.3f ms, record %.3f ms per frame (worst frame %.3f ms, budget %.1f ms)\n",
+            particles.GetActiveCount(), updateMs / FRAMES, recordMs / FRAMES, worstMs, FRAME_BUDGET_MS);
+#if defined(NDEBUG) && !defined(__SANITIZE_ADDRESS__) && !defined(__SANITIZE_THREAD__)
+        // 最適化ビルドでは平均がフレーム予算に収まること（最悪値は環境の揺れを受けるので表示のみ）
+        CHECK((updateMs + recordMs) / FRAMES <= FRAME_BUDGET_MS);
+#endif
+
+        particles.Clear();
+        for (ParticleEffect effect : EFFECTS) {
+            particles.GetDesc(effect) = savedDescs[(int)effect];
+        }
+    }
+}
+
+int main() {
+    TestEnemyHitEmitsOnce();
+    TestBaseDamageEmitsAtImpactPoint();
+    TestFiftyThousandParticles();
+    return TestResult("test_particles");
+}
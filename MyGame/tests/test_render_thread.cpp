@@ -0,0 +1,230 @@
+﻿// 描画スレッドを使った時に、レンダラーの呼び出しがすべて描画スレッドで行われること、
+// 描画中のフレームが使っているテクスチャが先に破棄されないこと、記録した内容がそのまま実行されることを確かめる
+// （SDL の描画関数はこのファイルで記録用に差し替える）
+#include "TestCheck.h"
+#include "Core/RenderThread.h"
+#include "Core/DrawList.h"
+#include "imgui.h"
+#include "imgui_impl_sdlrenderer2.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+
+namespace {
+
+    const int PRESENT_MS = 4;   // VSYNC 待ちの代わり
+    const int SIMULATE_MS = 4;  // 1フレームのシミュレーションの代わり
+    const int VIEW_W = 1200;
+    const int VIEW_H = 800;
+
+    std::thread::id renderThreadId;
+    std::atomic<int> offThreadCalls{ 0 };
+    std::atomic<int> violations{ 0 };
+    std::atomic<int> drawCalls{ 0 };
+    std::atomic<int> presents{ 0 };
+    std::mutex textureMutex;
+    std::set<SDL_Texture*> liveTextures;
+    int fakeRenderer;
+
+    void CheckThread() {
+        if (std::this_thread::get_id() != renderThreadId) ++offThreadCalls;
+    }
+
+    // 破棄済みのテクスチャを使ったら違反として数える
+    void UseTexture(SDL_Texture* texture) {
+        if (!texture) return;
+        std::lock_guard<std::mutex> lock(textureMutex);
+        if (!liveTextures.count(texture)) ++violations;
+    }
+
+    SDL_Renderer* FakeRenderer() { return reinterpret_cast<SDL_Renderer*>(&fakeRenderer); }
+}
+
+extern "C" {
+
+SDL_Renderer* SDL_CreateRenderer(SDL_Window*, int, Uint32) {
+    renderThreadId = std::this_thread::get_id();
+    return FakeRenderer();
+}
+void SDL_DestroyRenderer(SDL_Renderer*) { CheckThread(); }
+SDL_bool SDL_RenderTargetSupported(SDL_Renderer*) { return SDL_TRUE; }
+int SDL_GetRendererOutputSize(SDL_Renderer*, int* w, int* h) {
+    if (w) *w = VIEW_W;
+    if (h) *h = VIEW_H;
+    return 0;
+}
+void SDL_RenderPresent(SDL_Renderer*) {
+    CheckThread();
+    ++presents;
+    std::this_thread::sleep_for(std::chrono::milliseconds(PRESENT_MS));
+}
+int SDL_SetRenderTarget(SDL_Renderer*, SDL_Texture* texture) { CheckThread(); UseTexture(texture); return 0; }
+SDL_Texture* SDL_GetRenderTarget(SDL_Renderer*) { CheckThread(); return nullptr; }
+int SDL_GetRenderDrawBlendMode(SDL_Renderer*, SDL_BlendMode* mode) { CheckThread(); if (mode) *mode = SDL_BLENDMODE_NONE; return 0; }
+int SDL_SetRenderDrawBlendMode(SDL_Renderer*, SDL_BlendMode) { CheckThread(); return 0; }
+int SDL_SetRenderDrawColor(SDL_Renderer*, Uint8, Uint8, Uint8, Uint8) { CheckThread(); return 0; }
+int SDL_RenderClear(SDL_Renderer*) { CheckThread(); return 0; }
+int SDL_RenderFillRect(SDL_Renderer*, const SDL_Rect*) { CheckThread(); ++drawCalls; return 0; }
+int SDL_RenderDrawRect(SDL_Renderer*, const SDL_Rect*) { CheckThread(); ++drawCalls; return 0; }
+int SDL_RenderDrawLine(SDL_Renderer*, int, int, int, int) { CheckThread(); ++drawCalls; return 0; }
+int SDL_RenderDrawLinesF(SDL_Renderer*, const SDL_FPoint* points, int count) {
+    CheckThread();
+    // 記録した後で呼び出し元の配列を書き換えても、記録した時の値で描かれる
+    if (count != 3 || points[2].x != 2.0f) ++violations;
+    ++drawCalls;
+    return 0;
+}
+int SDL_RenderCopy(SDL_Renderer*, SDL_Texture* texture, const SDL_Rect*, const SDL_Rect*) {
+    CheckThread(); UseTexture(texture); ++drawCalls; return 0;
+}
+int SDL_RenderCopyEx(SDL_Renderer*, SDL_Texture* texture, const SDL_Rect*, const SDL_Rect*, const double,
+    const SDL_Point*, const SDL_RendererFlip) {
+    CheckThread(); UseTexture(texture); ++drawCalls; return 0;
+}
+int SDL_SetTextureColorMod(SDL_Texture* texture, Uint8, Uint8, Uint8) { CheckThread(); UseTexture(texture); return 0; }
+int SDL_SetTextureAlphaMod(SDL_Texture* texture, Uint8) { CheckThread(); UseTexture(texture); return 0; }
+int SDL_RenderGeometry(SDL_Renderer*, SDL_Texture*, const SDL_Vertex*, int, const int*, int) { CheckThread(); ++drawCalls; return 0; }
+SDL_Texture* SDL_CreateTexture(SDL_Renderer*, Uint32, int, int, int) {
+    CheckThread();
+    auto* texture = reinterpret_cast<SDL_Texture*>(new int(0));
+    std::lock_guard<std::mutex> lock(textureMutex);
+    liveTextures.insert(texture);
+    return texture;
+}
+SDL_Texture* SDL_CreateTextureFromSurface(SDL_Renderer*, SDL_Surface*) { return nullptr; }
+int SDL_QueryTexture(SDL_Texture*, Uint32*, int*, int* w, int* h) {
+    if (w) *w = 0;
+    if (h) *h = 0;
+    return 0;
+}
+int SDL_UpdateTexture(SDL_Texture* texture, const SDL_Rect*, const void*, int) { CheckThread(); UseTexture(texture); return 0; }
+int SDL_SetTextureBlendMode(SDL_Texture* texture, SDL_BlendMode) { CheckThread(); UseTexture(texture); return 0; }
+int SDL_SetTextureScaleMode(SDL_Texture* texture, SDL_ScaleMode) { CheckThread(); UseTexture(texture); return 0; }
+void SDL_DestroyTexture(SDL_Texture* texture) {
+    CheckThread();
+    std::lock_guard<std::mutex> lock(textureMutex);
+    if (!liveTextures.erase(texture)) ++violations;
+    delete reinterpret_cast<int*>(texture);
+}
+void SDL_RenderGetScale(SDL_Renderer*, float* x, float* y) { *x = 1.0f; *y = 1.0f; }
+SDL_bool SDL_RenderIsClipEnabled(SDL_Renderer*) { CheckThread(); return SDL_FALSE; }
+void SDL_RenderGetViewport(SDL_Renderer*, SDL_Rect* rect) { CheckThread(); *rect = { 0, 0, VIEW_W, VIEW_H }; }
+void SDL_RenderGetClipRect(SDL_Renderer*, SDL_Rect* rect) { CheckThread(); *rect = {}; }
+int SDL_RenderSetViewport(SDL_Renderer*, const SDL_Rect*) { CheckThread(); return 0; }
+int SDL_RenderSetClipRect(SDL_Renderer*, const SDL_Rect*) { CheckThread(); return 0; }
+int SDL_RenderGeometryRaw(SDL_Renderer*, SDL_Texture* texture, const float*, int, const SDL_Color*, int,
+    const float*, int, int, const void*, int, int) {
+    CheckThread(); UseTexture(texture); ++drawCalls; return 0;
+}
+
+}
+
+namespace {
+
+    // 1フレーム分を記録する（スプライト・図形・線・頂点・文字列・ImGui）
+    void RecordFrame(DrawList& list, SDL_Texture* sprite, int frame) {
+        list.Begin(VIEW_W, VIEW_H);
+        list.SetDrawColor(30, 30, 30, 255);
+        list.Clear();
+        SDL_Rect rect = { 1, 2, 3, 4 };
+        list.SetTextureColorMod(sprite, 255, 100, 100);
+        list.CopyEx(sprite, nullptr, &rect, 10.0, SDL_FLIP_NONE);
+        list.FillRect(rect);
+        list.DrawRect(rect);
+        list.DrawLine(0, 0, 5, 5);
+        SDL_FPoint points[3] = { { 0.0f, 0.0f }, { 1.0f, 1.0f }, { 2.0f, 2.0f } };
+        list.DrawLinesF(points, 3);
+        points[2].x = 99.0f;
+        SDL_Vertex vertices[4] = {};
+        int indices[6] = { 0, 1, 2, 2, 3, 0 };
+        list.SetDrawBlendMode(SDL_BLENDMODE_BLEND);
+        list.Geometry(vertices, 4, indices, 6);
+        list.SetDrawBlendMode(SDL_BLENDMODE_NONE);
+        list.Text("frame " + std::to_string(frame), 0, 0, { 255, 255, 255, 255 });
+
+        ImGui::NewFrame();
+        ImGui::Begin("Test");
+        ImGui::Text("Frame %d", frame);
+        ImGui::End();
+        ImGui::Render();
+        list.SubmitImGui(ImGui::GetDrawData());
+    }
+
+    // frames フレームを流し、1フレームあたりの時間（ミリ秒）を返す
+    double RunFrames(bool threaded, int frames) {
+        DrawList lists[2];
+        int current = 0;
+        if (threaded) {
+            CHECK(RenderThread::Start(reinterpret_cast<SDL_Window*>(&fakeRenderer), 0));
+        }
+        else {
+            renderThreadId = std::this_thread::get_id();
+        }
+        ImGui_ImplSDLRenderer2_Init(threaded ? RenderThread::GetRenderer() : FakeRenderer());
+        // 新しいウィンドウは最初のフレームだけ描かれないので、記録せずに1フレーム進めておく（両方の描画数をそろえる）
+        ImGui::NewFrame();
+        ImGui::Begin("Test");
+        ImGui::End();
+        ImGui::Render();
+
+        SDL_Texture* sprite = nullptr;
+        RenderThread::Invoke([&sprite]() { sprite = SDL_CreateTexture(nullptr, 0, 0, 8, 8); });
+
+        auto start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < frames; ++frame) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(SIMULATE_MS));
+            // 前のフレームがまだ描いている最中にスプライトを差し替える
+            if (frame % 10 == 9) {
+                RenderThread::DestroyTexture(sprite);
+                RenderThread::Invoke([&sprite]() { sprite = SDL_CreateTexture(nullptr, 0, 0, 8, 8); });
+            }
+            DrawList& list = lists[current];
+            RecordFrame(list, sprite, frame);
+            if (threaded) {
+                RenderThread::Submit(&list);
+            }
+            else {
+                list.Execute(FakeRenderer());
+                SDL_RenderPresent(FakeRenderer());
+            }
+            current ^= 1;
+        }
+        RenderThread::WaitIdle();
+        double totalMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        RenderThread::DestroyTexture(sprite);
+        RenderThread::Invoke([]() { ImGui_ImplSDLRenderer2_Shutdown(); });
+        if (threaded) RenderThread::Stop();
+        return totalMs / frames;
+    }
+
+    void TestRenderThread() {
+        const int FRAMES = 100;
+        ImGui::CreateContext();
+        ImGui::GetIO().DisplaySize = ImVec2((float)VIEW_W, (float)VIEW_H);
+        ImGui::GetIO().IniFilename = nullptr;
+
+        double sequentialMs = RunFrames(false, FRAMES);
+        int sequentialDraws = drawCalls.exchange(0);
+        int sequentialPresents = presents.exchange(0);
+        double threadedMs = RunFrames(true, FRAMES);
+
+        std::printf("sequential %.1f ms/frame, render thread %.1f ms/frame (simulate %d ms + present %d ms)\n",
+            sequentialMs, threadedMs, SIMULATE_MS, PRESENT_MS);
+        CHECK(offThreadCalls == 0);
+        CHECK(violations == 0);
+        CHECK(liveTextures.empty());
+        CHECK(sequentialDraws > 0 && drawCalls == sequentialDraws);
+        CHECK(sequentialPresents == FRAMES && presents == FRAMES);
+        ImGui::DestroyContext();
+    }
+}
+
+int main() {
+    TestRenderThread();
+    return TestResult("test_render_thread");
+}
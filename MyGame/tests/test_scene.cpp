@@ -0,0 +1,95 @@
+﻿// Scene の追加・削除の通知、構成の番号（エディタの表示キャッシュの作り直し判定）、空間インデックスの追従を確かめる
+#include "TestCheck.h"
+#include "TestScene.h"
+#include "Core/Game.h"
+#include "Core/Time.h"
+
+namespace {
+
+    // Update 内の追加・削除はフックで1件ずつ通知され、構成の番号は変わらない
+    void TestAddRemoveHooks() {
+        Game game;
+        TestScene scene;
+        scene.Update(&game);
+        const unsigned int version = scene.GetStructureVersion();
+
+        auto pending = std::make_unique<TestObject>(100.0f, 100.0f, 10, 10);
+        GameObject* obj = pending.get();
+        game.Instantiate(std::move(pending));
+        scene.Update(&game);
+        CHECK(scene.added.size() == 1 && scene.added[0] == obj);
+        CHECK(scene.objects.size() == 1);
+        CHECK(game.GetPendingObjects().empty());
+
+        obj->isDead = true;
+        scene.Update(&game);
+        CHECK(scene.removed.size() == 1 && scene.removed[0] == obj);
+        CHECK(scene.objects.empty());
+        CHECK(scene.GetStructureVersion() == version);
+    }
+
+    // 動いたオブジェクトは作り直さずに新しいセルで見つかり、古い位置では見つからない
+    void TestSpatialIndexFollowsMovement() {
+        Game game;
+        TestScene scene;
+        GameObject* mover = scene.Add<TestObject>(10.0f, 10.0f, 20, 20);
+        GameObject* other = scene.Add<TestObject>(50.0f, 10.0f, 20, 20);
+        scene.Update(&game);
+
+        std::vector<int> hits;
+        scene.GetSpatialIndex().QueryPoint(15.0f, 15.0f, hits);
+        CHECK(hits.size() == 1 && hits[0] == 0);
+
+        mover->x = 1000.0f;
+        mover->y = 600.0f;
+        scene.Update(&game);
+        scene.GetSpatialIndex().QueryPoint(15.0f, 15.0f, hits);
+        CHECK(hits.empty());
+        scene.GetSpatialIndex().QueryPoint(1005.0f, 605.0f, hits);
+        CHECK(hits.size() == 1 && hits[0] == 0);
+
+        SDL_FRect all = { 0.0f, 0.0f, 2000.0f, 1000.0f };
+        scene.GetSpatialIndex().QueryRect(all, hits);
+        CHECK(hits.size() == 2 && hits[0] == 0 && hits[1] == 1);
+
+        // 原点より左上の（負の）セルにも移れる
+        mover->x = -1000.0f;
+        mover->y = -600.0f;
+        scene.Update(&game);
+        scene.GetSpatialIndex().QueryPoint(-995.0f, -595.0f, hits);
+        CHECK(hits.size() == 1 && hits[0] == 0);
+        scene.GetSpatialIndex().QueryRect(all, hits);
+        CHECK(hits.size() == 1 && hits[0] == 1);
+        SDL_FRect around = { -1100.0f, -700.0f, 1200.0f, 800.0f };
+        scene.GetSpatialIndex().QueryRect(around, hits);
+        CHECK(hits.size() == 2 && hits[0] == 0 && hits[1] == 1);
+
+        // 削除で配列の位置がずれた後は作り直される
+        mover->isDead = true;
+        scene.Update(&game);
+        scene.GetSpatialIndex().QueryPoint(55.0f, 15.0f, hits);
+        CHECK(hits.size() == 1 && scene.objects[hits[0]].get() == other);
+        scene.GetSpatialIndex().QueryPoint(1005.0f, 605.0f, hits);
+        CHECK(hits.empty());
+    }
+
+    // 早送りのティックで差し替えた deltaTime は、途中で抜けても元に戻る
+    void TestScopedDeltaTime() {
+        Time::deltaTime = 0.033f;
+        for (int tick = 0; tick < 10; ++tick) {
+            Time::ScopedDeltaTime fixedStep(1.0f / 60.0f);
+            CHECK(Time::deltaTime == 1.0f / 60.0f);
+            if (tick == 3) break;
+        }
+        CHECK(Time::deltaTime == 0.033f);
+        Time::deltaTime = 1.0f / 60.0f;
+    }
+}
+
+int main() {
+    Time::deltaTime = 1.0f / 60.0f;
+    TestAddRemoveHooks();
+    TestSpatialIndexFollowsMovement();
+    TestScopedDeltaTime();
+    return TestResult("test_scene");
+}
@@ -0,0 +1,139 @@
+﻿// 接地して止まった体が眠り、動かされた時・足場が消えた時・設定の変更時に起きること、
+// Update の中で位置を書き換えて歩く敵が眠らないことを確かめる
+#include "TestCheck.h"
+#include "TestScene.h"
+#include "Core/Game.h"
+#include "Core/Time.h"
+#include "Core/GameParams.h"
+#include "Objects/Enemy.h"
+#include <chrono>
+#include <cstdio>
+
+namespace {
+
+    GameObject* AddBlock(TestScene& scene, float x, float y, int w, int h) {
+        GameObject* block = scene.Add<TestObject>(x, y, w, h);
+        block->name = ObjectNames::Block;
+        block->isStatic = true;
+        return block;
+    }
+
+    // 敵と同じ扱い（押し戻しを受けるトリガー）で、自分では動かない体
+    GameObject* AddBody(TestScene& scene, float x, float y) {
+        GameObject* body = scene.Add<TestObject>(x, y, 24, 32);
+        body->name = ObjectNames::Enemy;
+        body->isTrigger = true;
+        body->useGravity = true;
+        return body;
+    }
+
+    int CountSleeping(const std::vector<GameObject*>& bodies) {
+        int count = 0;
+        for (GameObject* body : bodies) count += body->isSleeping ? 1 : 0;
+        return count;
+    }
+
+    void TestLandedBodiesSleepAndWake() {
+        const int BODIES = 3000;
+        Game game;
+        TestScene scene;
+        std::vector<GameObject*> blocks;
+        std::vector<GameObject*> bodies;
+        for (int k = 0; k < 160; ++k) blocks.push_back(AddBlock(scene, k * 32.0f, 500.0f, 32, 32));
+        for (int e = 0; e < BODIES; ++e) {
+            bodies.push_back(AddBody(scene, (e * 37) % 5000 + 0.25f, 380.0f + (e % 7) * 5.0f));
+        }
+
+        using Clock = std::chrono::steady_clock;
+        double awakeMs = 0.0;
+        double asleepMs = 0.0;
+        for (int frame = 0; frame < 200; ++frame) {
+            auto start = Clock::now();
+            scene.Update(&game);
+            double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            if (frame >= 5 && frame < 25) awakeMs += ms / 20.0;
+            if (frame >= 180) asleepMs += ms / 20.0;
+        }
+        std::printf("%d bodies: frame %.3f ms while landing, %.3f ms asleep\n", BODIES, awakeMs, asleepMs);
+        CHECK(CountSleeping(bodies) == BODIES);
+        const float restY = bodies[0]->y;
+        CHECK(restY + 32.0f == 500.0f);
+
+        // 速度を与えたら起きて動き、止めればまた眠る
+        bodies[0]->velX = 60.0f;
+        const float startX = bodies[0]->x;
+        scene.Update(&game);
+        CHECK(!bodies[0]->isSleeping);
+        CHECK(bodies[0]->x > startX);
+        CHECK(bodies[0]->y == restY);
+        bodies[0]->velX = 0.0f;
+        for (int frame = 0; frame < 40; ++frame) scene.Update(&game);
+        CHECK(bodies[0]->isSleeping);
+        CHECK(bodies[0]->y == restY);
+
+        // エディタでの移動は変更の通知で起きる
+        SDL_Rect before = { (int)bodies[1]->x, (int)bodies[1]->y, bodies[1]->width, bodies[1]->height };
+        bodies[1]->x += 3.0f;
+        scene.NotifyObjectChanged(bodies[1], before);
+        scene.Update(&game);
+        CHECK(!bodies[1]->isSleeping);
+
+        // 足場が消えたら起きて落ちる
+        for (GameObject* block : blocks) block->isDead = true;
+        for (int frame = 0; frame < 3; ++frame) scene.Update(&game);
+        CHECK(CountSleeping(bodies) == 0);
+        CHECK(bodies[0]->y > restY);
+    }
+
+    void TestConfigChangeWakes() {
+        Game game;
+        TestScene scene;
+        AddBlock(scene, 0.0f, 500.0f, 64, 32);
+        GameObject* body = AddBody(scene, 10.0f, 460.0f);
+        for (int frame = 0; frame < 80; ++frame) scene.Update(&game);
+        CHECK(body->isSleeping);
+
+        scene.ApplyConfigChange(ConfigSection::None, nullptr);
+        scene.Update(&game);
+        CHECK(!body->isSleeping);
+        CHECK(body->restTicks <= 1);
+    }
+
+    // 地上型の敵は速度を使わず Update で x を直接減らして歩く。拠点に着くまで眠らない
+    void TestWalkingEnemyNeverSleeps() {
+        GameParams& params = GameParams::GetInstance();
+        const EnemyParams savedEnemy = params.enemy;
+        params.enemy.locomotionStyle = LocomotionType::Ground;
+        params.enemy.moveMethod = MovementType::Linear;
+        params.enemy.baseSpeed = 30.0f;
+        params.enemy.attackRange = 50.0f;
+
+        Game game;
+        TestScene scene;
+        AddBlock(scene, 0.0f, 500.0f, 4000, 32);
+        std::vector<SDL_FPoint> path;
+        Enemy* enemy = scene.Add<Enemy>(2000.0f, 400.0f, 24, 32, nullptr, path);
+        enemy->width = 24;
+        enemy->height = 32;
+
+        // 着地してから 10 秒分（眠るまでのフレーム数の 20 倍）歩かせる
+        int sleptFrames = 0;
+        for (int frame = 0; frame < 600; ++frame) {
+            scene.Update(&game);
+            if (enemy->isSleeping) ++sleptFrames;
+        }
+        CHECK(sleptFrames == 0);
+        CHECK(enemy->isGrounded);
+        CHECK(enemy->x < 2000.0f - 30.0f * 9.0f);
+
+        params.enemy = savedEnemy;
+    }
+}
+
+int main() {
+    Time::deltaTime = 1.0f / 60.0f;
+    TestLandedBodiesSleepAndWake();
+    TestConfigChangeWakes();
+    TestWalkingEnemyNeverSleeps();
+    return TestResult("test_sleep");
+}
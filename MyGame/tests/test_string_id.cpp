@@ -0,0 +1,124 @@
+﻿// StringId の比較・検索・設定ファイルとの変換と、複数スレッドからの登録で番号が重複しないことを確かめる
+#include "TestCheck.h"
+#include "Core/StringId.h"
+#include "Core/GameParams.h"
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+    void TestCompareAndFind() {
+        StringId a("Enemy");
+        StringId b(std::string("Enemy"));
+        StringId c("Block");
+        StringId empty;
+        CHECK(a == b);
+        CHECK(a != c);
+        CHECK(empty.empty());
+        CHECK(StringId("").empty());
+        CHECK(StringId(static_cast<const char*>(nullptr)).empty());
+        CHECK(a.str() == "Enemy");
+        CHECK(std::string(c.c_str()) == "Block");
+
+        // Find は登録済みの番号を返すだけで、表には追加しない
+        size_t registered = StringId::GetRegisteredCount();
+        CHECK(StringId::Find("test_string_id: never registered").empty());
+        CHECK(StringId::GetRegisteredCount() == registered);
+        CHECK(StringId::Find("Block") == c);
+
+        std::unordered_set<StringId> set = { a, b, c };
+        CHECK(set.size() == 2);
+    }
+
+    void TestJsonRoundTrip() {
+        EnemySpawnEntry entry;
+        entry.enemyPresetName = "Tank";
+        json j = entry;
+        CHECK(j.at("preset").get<std::string>() == "Tank");
+        EnemySpawnEntry loaded = j.get<EnemySpawnEntry>();
+        CHECK(loaded.enemyPresetName == StringId("Tank"));
+        CHECK(loaded == entry);
+    }
+
+    // 4 スレッドが同じ 500 個の文字列を登録しても、増えるのは 500 個だけで、番号は文字列ごとに1つ
+    void TestConcurrentIntern() {
+        const int THREADS = 4;
+        const int NAMES = 500;
+        size_t before = StringId::GetRegisteredCount();
+        std::vector<std::vector<StringId>> results(THREADS, std::vector<StringId>(NAMES));
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREADS; ++t) {
+            threads.emplace_back([t, &results]() {
+                for (int i = 0; i < 2000; ++i) {
+                    int n = (i * (t + 1)) % NAMES;
+                    StringId id("test_string_id_" + std::to_string(n));
+                    if (id.str() != "test_string_id_" + std::to_string(n)) return;
+                    results[t][n] = id;
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+
+        CHECK(StringId::GetRegisteredCount() == before + NAMES);
+        int mismatches = 0;
+        for (int n = 0; n < NAMES; ++n) {
+            StringId expected = StringId::Find("test_string_id_" + std::to_string(n));
+            for (int t = 0; t < THREADS; ++t) {
+                if (!results[t][n].empty() && results[t][n] != expected) ++mismatches;
+            }
+            if (results[0][n] != expected) ++mismatches;
+        }
+        CHECK(mismatches == 0);
+    }
+
+    // オブジェクトの種類の判定を、文字列の比較と番号の比較で同じ結果になるか比べる（時間は表示のみ）
+    void TestMatchesStringComparison() {
+        const char* NAMES[] = { "Enemy", "Block", "Player", "EnemyBullet", "Editor Ground", "Turret (Basic)", "Base Gate" };
+        const int COUNT = 5000;
+        const int FRAMES = 200;
+        std::vector<std::string> strings(COUNT);
+        std::vector<StringId> ids(COUNT);
+        for (int i = 0; i < COUNT; ++i) {
+            strings[i] = NAMES[i % 7];
+            ids[i] = StringId(strings[i]);
+        }
+
+        static const StringId PLAYER("Player"), TEST_PLAYER("TestPlayer"), ENEMY("Enemy"), TEST_ENEMY("Test Enemy");
+        static const StringId BLOCK("Block"), EDITOR_GROUND("Editor Ground");
+        long long stringHits = 0;
+        long long idHits = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < FRAMES; ++frame) {
+            for (const std::string& name : strings) {
+                if (name == "Player" || name == "TestPlayer" || name == "Enemy" || name == "Test Enemy") ++stringHits;
+                if (name == "Block" || name == "Editor Ground") ++stringHits;
+            }
+        }
+        auto middle = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < FRAMES; ++frame) {
+            for (StringId name : ids) {
+                if (name == PLAYER || name == TEST_PLAYER || name == ENEMY || name == TEST_ENEMY) ++idHits;
+                if (name == BLOCK || name == EDITOR_GROUND) ++idHits;
+            }
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        std::printf("%d names: string compare %.4f ms/frame, StringId compare %.4f ms/frame\n", COUNT,
+            std::chrono::duration<double, std::milli>(middle - start).count() / FRAMES,
+            std::chrono::duration<double, std::milli>(end - middle).count() / FRAMES);
+        CHECK(stringHits == idHits);
+        CHECK(idHits > 0);
+    }
+}
+
+int main() {
+    TestCompareAndFind();
+    TestJsonRoundTrip();
+    TestConcurrentIntern();
+    TestMatchesStringComparison();
+    return TestResult("test_string_id");
+}
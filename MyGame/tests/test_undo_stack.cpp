@@ -0,0 +1,57 @@
+﻿// UndoStack のまとめ・取り消し・やり直しと、履歴サイズの集計を確かめる
+#include "TestCheck.h"
+#include "Editor/UndoStack.h"
+
+namespace {
+
+    UndoStack::Command MakeCommand(int& target, int before, int after, size_t byteSize) {
+        UndoStack::Command command;
+        command.label = "Edit";
+        command.undo = [&target, before]() { target = before; };
+        command.redo = [&target, after]() { target = after; };
+        command.byteSize = byteSize;
+        return command;
+    }
+}
+
+int main() {
+    UndoStack stack;
+    int value = 0;
+    int key = 0;
+
+    // ドラッグ中の連続した変更は1つにまとまり、サイズは最後のコマンドのものになる
+    value = 1;
+    stack.Push(MakeCommand(value, 0, 1, 100), &key);
+    value = 2;
+    stack.Push(MakeCommand(value, 1, 2, 300), &key);
+    CHECK(stack.GetByteSize() == 300);
+    stack.Seal();
+
+    value = 3;
+    stack.Push(MakeCommand(value, 2, 3, 50), &key);
+    CHECK(stack.GetByteSize() == 350);
+
+    CHECK(stack.Undo());
+    CHECK(value == 2);
+    CHECK(stack.Undo());
+    CHECK(value == 0);
+    CHECK(!stack.CanUndo());
+    CHECK(stack.Redo());
+    CHECK(value == 2);
+
+    // 新しい操作をするとやり直し履歴は捨てられ、そのサイズも差し引かれる
+    value = 5;
+    stack.Push(MakeCommand(value, 2, 5, 10));
+    CHECK(!stack.CanRedo());
+    CHECK(stack.GetByteSize() == 310);
+
+    // 上限を超えたら古いものから捨てる（直前の操作は残る）
+    stack.Clear();
+    for (int i = 0; i < 10; ++i) {
+        stack.Push(MakeCommand(value, i, i + 1, UndoStack::MAX_BYTES / 4));
+    }
+    CHECK(stack.GetByteSize() <= UndoStack::MAX_BYTES);
+    CHECK(stack.CanUndo());
+
+    return TestResult("test_undo_stack");
+}
@@ -0,0 +1,160 @@
+﻿// 敵の設定の変更が、ウェーブで出現した敵（出現済み・プールで待機中）に種類ごとに反映されることを確かめる
+#include "TestCheck.h"
+#include "TestScene.h"
+#include "Core/Game.h"
+#include "Core/Time.h"
+#include "Core/GameParams.h"
+#include "GameLogic/WaveManager.h"
+#include "Objects/Enemy.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+namespace {
+
+    const int TEST_LEVEL = 900;
+    const int RUNNERS = 3000;
+    const int TANKS = 200;
+
+    // 設定の変更をウェーブの敵へ流すシーン（PlayScene / EditorScene と同じ）
+    class WaveScene : public TestScene {
+    public:
+        WaveManager waves;
+
+    protected:
+        void OnConfigChanged(unsigned int changedSections, SDL_Renderer* renderer) override {
+            waves.ApplyConfigChange(changedSections, renderer, objects);
+        }
+    };
+
+    void SetUpLevel() {
+        GameParams& params = GameParams::GetInstance();
+        EnemyParams runner;
+        runner.baseHealth = 10;
+        runner.baseSpeed = 120.0f;
+        EnemyParams tank;
+        tank.baseHealth = 200;
+        tank.baseSpeed = 40.0f;
+        params.enemyPresets["Runner"] = runner;
+        params.enemyPresets["Tank"] = tank;
+        params.activeEnemyPresetName = "Default";
+        params.enemy = params.enemyPresets["Default"];
+
+        // Runner はウェーブ開始と同時に全員、Tank は 1 秒後に出す（変更の時点ではプールで待機中）
+        EnemySpawnEntry runners;
+        runners.enemyPresetName = "Runner";
+        runners.count = RUNNERS;
+        runners.startDelay = 0.0f;
+        runners.burstSize = RUNNERS;
+        EnemySpawnEntry tanks;
+        tanks.enemyPresetName = "Tank";
+        tanks.count = TANKS;
+        tanks.startDelay = 1.0f;
+        tanks.burstSize = TANKS;
+
+        // レーンを広く取り、出現直後の重なり（当たり判定の組み合わせ）を実際のプレイ程度に抑える
+        LevelParams level;
+        level.waves.push_back(WaveParams{ { runners, tanks } });
+        for (int i = 0; i < 40; ++i) {
+            level.lanes.push_back(SpawnLane{ 1300.0f + 80.0f * i, 0.0f, 8000.0f });
+        }
+        params.levelConfigs[TEST_LEVEL] = level;
+    }
+
+    std::vector<Enemy*> EnemiesOf(WaveScene& scene, const EnemyArchetype* archetype) {
+        std::vector<Enemy*> result;
+        for (auto& obj : scene.objects) {
+            Enemy* enemy = dynamic_cast<Enemy*>(obj.get());
+            if (enemy && enemy->GetArchetype() == archetype) result.push_back(enemy);
+        }
+        return result;
+    }
+
+    double StepMs(WaveScene& scene, Game& game) {
+        auto start = std::chrono::steady_clock::now();
+        scene.waves.Update(&game);
+        scene.Update(&game);
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void TestConfigChangeReachesWaveEnemies() {
+        SetUpLevel();
+        GameParams& params = GameParams::GetInstance();
+        Game game;
+        WaveScene scene;
+        scene.waves.Init(TEST_LEVEL);
+
+        // 準備期間を終えて Runner が出現するまで進める
+        int frames = 0;
+        while (scene.objects.size() < (size_t)RUNNERS && frames < 600) {
+            StepMs(scene, game);
+            ++frames;
+        }
+        CHECK(scene.objects.size() == (size_t)RUNNERS);
+        Enemy* first = dynamic_cast<Enemy*>(scene.objects[0].get());
+        CHECK(first && first->GetArchetype());
+        if (!first || !first->GetArchetype()) return;
+        const EnemyArchetype* runnerBefore = first->GetArchetype();
+        CHECK(first->GetCurrentHP() == 10.0f);
+
+        // Runner の値を変えた次のフレームには、出現済みの全員が新しい値になっている
+        double worstBeforeMs = 0.0;
+        for (int i = 0; i < 10; ++i) worstBeforeMs = std::max(worstBeforeMs, StepMs(scene, game));
+
+        params.enemyPresets["Runner"].baseHealth = 25;
+        params.enemyPresets["Runner"].locomotionStyle = LocomotionType::Flying;
+        auto changeStart = std::chrono::steady_clock::now();
+        scene.ApplyConfigChange(ConfigSection::Enemy, nullptr);
+        double changeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - changeStart).count();
+        double changeFrameMs = changeMs + StepMs(scene, game);
+
+        const EnemyArchetype* runnerAfter = first->GetArchetype();
+        CHECK(runnerAfter != runnerBefore);
+        CHECK(runnerAfter && runnerAfter->params.baseHealth == 25);
+        std::vector<Enemy*> runners = EnemiesOf(scene, runnerAfter);
+        CHECK(runners.size() == (size_t)RUNNERS);
+        CHECK(EnemiesOf(scene, runnerBefore).empty());
+        for (Enemy* enemy : runners) {
+            if (enemy->GetCurrentHP() != 25.0f || enemy->useGravity) {
+                CHECK(enemy->GetCurrentHP() == 25.0f && !enemy->useGravity);
+                break;
+            }
+        }
+
+        // Tank だけを変えても Runner の種類のデータはそのまま。待機中の Tank は新しい値で出現する
+        params.enemyPresets["Tank"].baseHealth = 500;
+        scene.ApplyConfigChange(ConfigSection::Enemy, nullptr);
+        CHECK(first->GetArchetype() == runnerAfter);
+
+        double worstAfterMs = 0.0;
+        while (scene.objects.size() < (size_t)(RUNNERS + TANKS) && frames < 1200) {
+            worstAfterMs = std::max(worstAfterMs, StepMs(scene, game));
+            ++frames;
+        }
+        CHECK(scene.objects.size() == (size_t)(RUNNERS + TANKS));
+        int tanks = 0;
+        for (auto& obj : scene.objects) {
+            Enemy* enemy = dynamic_cast<Enemy*>(obj.get());
+            if (!enemy || enemy->GetArchetype() == runnerAfter) continue;
+            ++tanks;
+            if (enemy->GetCurrentHP() != 500.0f) {
+                CHECK(enemy->GetCurrentHP() == 500.0f);
+                break;
+            }
+        }
+        CHECK(tanks == TANKS);
+
+        std::printf("%d wave enemies: config change %.3f ms, change frame %.3f ms (worst frame before %.3f ms, after %.3f ms)\n",
+            RUNNERS, changeMs, changeFrameMs, worstBeforeMs, worstAfterMs);
+
+        params.levelConfigs.erase(TEST_LEVEL);
+        params.enemyPresets.erase("Runner");
+        params.enemyPresets.erase("Tank");
+    }
+}
+
+int main() {
+    Time::deltaTime = 1.0f / 60.0f;
+    TestConfigChangeReachesWaveEnemies();
+    return TestResult("test_wave_config");
+}